@@ -27,6 +27,8 @@ namespace hopeless
         typedef std::ptrdiff_t size_type;                       // a signed type for size is so much easier to work with arithmetic wise
 
         pointer allocate (size_type n) noexcept;
+        // calloc, the memory reads as zero and the os only hands out pages for large allocations when they are first touched
+        pointer allocate_zeroed (size_type n) noexcept;
         //pointer reallocate (pointer ptr, size_type n) noexcept;  //hmmm seems tricky to do
         void deallocate(pointer ptr, size_type n) noexcept;
         void validate_max(size_type n, size_type max_size) noexcept;
@@ -68,6 +70,22 @@ namespace hopeless
         }
     }
     
+    template<typename T>
+    allocator<T>::pointer allocator<T>::allocate_zeroed(size_type n) noexcept{
+        if (n == 0) {return nullptr;}
+        validate_max(n,max_size());
+        using calloc_ptr_noexcept = void* (*)(size_t,size_t) noexcept;
+        calloc_ptr_noexcept no_throw_call_calloc = reinterpret_cast<calloc_ptr_noexcept>(calloc);
+        pointer return_ptr = (pointer)no_throw_call_calloc(n,sizeof(T));
+        if ((bool)(return_ptr)){
+            return return_ptr;
+        }
+        else{
+            std::cerr<<"ERROR hopeless::allocator error, call to calloc failed"<<std::endl;
+            std::terminate();
+        }
+    }
+    
     // simple wrapper for free
     template<typename T>
     void allocator<T>::deallocate(pointer ptr, size_type n) noexcept{
@@ -0,0 +1,150 @@
+// compares the shipped growth policies on push_back, emplace_back, insert near the front and append_range
+// build from the repository root, e.g.
+//      g++ -std=c++20 -O3 -fopenmp -I. bench/growth_policy_bench.cpp -o growth_policy_bench
+//      ./growth_policy_bench [elements] [repeats]
+// prints the best time of the repeats in ms, the final capacity and how many times the buffer was reallocated,
+// the host_only rows are the pure growth cost, the mirrored rows (with HOPELESS_TARGET_OMP_DEV) add the device
+// buffer that is reallocated along with the host one
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<cstddef>
+
+#include "dynarray.hpp"
+#include "growth_policy.hpp"
+
+namespace
+{
+    struct particle
+    {
+        double x, y, z;
+        double vx, vy, vz;
+        int id;
+    };
+
+    struct result
+    {
+        double ms;
+        std::ptrdiff_t capacity;
+        std::ptrdiff_t reallocations;
+    };
+
+    template<typename F>
+    result best_of(const int repeats, F && f){
+        result best{1e300,0,0};
+        for (int r = 0; r < repeats; ++r){
+            const auto start = std::chrono::steady_clock::now();
+            const result res = f();
+            const auto stop = std::chrono::steady_clock::now();
+            const double ms = std::chrono::duration<double,std::milli>(stop - start).count();
+            if (ms < best.ms){
+                best = res;
+                best.ms = ms;
+            }
+        }
+        return best;
+    }
+
+    template<typename Array>
+    inline void count_growth(const Array & arr, std::ptrdiff_t & last_cap, std::ptrdiff_t & reallocations){
+        if (arr.capacity() != last_cap){
+            last_cap = arr.capacity();
+            ++reallocations;
+        }
+    }
+
+    template<typename Array>
+    result push_back_ints(const std::ptrdiff_t n){
+        Array arr;
+        std::ptrdiff_t cap = arr.capacity(), reallocations = 0;
+        for (std::ptrdiff_t i = 0; i < n; ++i){
+            arr.push_back(static_cast<int>(i));
+            count_growth(arr,cap,reallocations);
+        }
+        return {0.0,arr.capacity(),reallocations};
+    }
+
+    template<typename Array>
+    result emplace_back_structs(const std::ptrdiff_t n){
+        Array arr;
+        std::ptrdiff_t cap = arr.capacity(), reallocations = 0;
+        for (std::ptrdiff_t i = 0; i < n; ++i){
+            const double d = static_cast<double>(i);
+            arr.emplace_back(particle{d,d,d,0.0,0.0,0.0,static_cast<int>(i)});
+            count_growth(arr,cap,reallocations);
+        }
+        return {0.0,arr.capacity(),reallocations};
+    }
+
+    // inserts one element at a small offset, every insert shifts the tail so this is bounded by memmove
+    template<typename Array>
+    result insert_near_front(const std::ptrdiff_t n){
+        Array arr;
+        std::ptrdiff_t cap = arr.capacity(), reallocations = 0;
+        for (std::ptrdiff_t i = 0; i < n; ++i){
+            const std::ptrdiff_t pos = (arr.size() < 8) ? arr.size():(i % 8);
+            arr.insert(arr.begin() + pos,static_cast<int>(i));
+            count_growth(arr,cap,reallocations);
+        }
+        return {0.0,arr.capacity(),reallocations};
+    }
+
+    // appends batches of varying size, like collecting results of a time step
+    template<typename Array>
+    result append_batches(const std::ptrdiff_t n){
+        Array arr;
+        hopeless::dynarray<int,hopeless::allocator<int>,hopeless::host_only> batch(4096,hopeless::for_overwrite);
+        for (std::ptrdiff_t i = 0; i < batch.size(); ++i){
+            batch[i] = static_cast<int>(i);
+        }
+        std::ptrdiff_t cap = arr.capacity(), reallocations = 0;
+        std::ptrdiff_t done = 0, k = 0;
+        while (done < n){
+            std::ptrdiff_t count = 1 + (k * 977) % batch.size();
+            count = (count > n - done) ? (n - done):count;
+            arr.append_range(batch.data(),batch.data() + count);
+            count_growth(arr,cap,reallocations);
+            done += count;
+            ++k;
+        }
+        return {0.0,arr.capacity(),reallocations};
+    }
+
+    void print_row(const char * pattern, const char * policy, const char * offload, const result & res){
+        std::printf("%-20s %-26s %-10s %10.3f %14td %8td\n",pattern,policy,offload,res.ms,res.capacity,res.reallocations);
+    }
+
+    template<typename OffloadPolicy, typename GrowthPolicy>
+    void run_policy(const char * policy, const char * offload, const std::ptrdiff_t n, const int repeats){
+        using ints = hopeless::dynarray<int,hopeless::allocator<int>,OffloadPolicy,GrowthPolicy>;
+        using particles = hopeless::dynarray<particle,hopeless::allocator<particle>,OffloadPolicy,GrowthPolicy>;
+        print_row("push_back int",policy,offload,best_of(repeats,[n]{return push_back_ints<ints>(n);}));
+        print_row("emplace_back struct",policy,offload,best_of(repeats,[n]{return emplace_back_structs<particles>(n);}));
+        print_row("append_range",policy,offload,best_of(repeats,[n]{return append_batches<ints>(n);}));
+        // quadratic in n, run on a smaller array
+        const std::ptrdiff_t n_insert = (n / 100 > 1000) ? (n / 100):1000;
+        print_row("insert near front",policy,offload,best_of(repeats,[n_insert]{return insert_near_front<ints>(n_insert);}));
+    }
+
+    template<typename OffloadPolicy>
+    void run_all(const char * offload, const std::ptrdiff_t n, const int repeats){
+        run_policy<OffloadPolicy,hopeless::geometric_growth<1618034,1000000>>("geometric 1.618 (default)",offload,n,repeats);
+        run_policy<OffloadPolicy,hopeless::geometric_growth<2,1>>("geometric 2",offload,n,repeats);
+        run_policy<OffloadPolicy,hopeless::geometric_growth<3,2>>("geometric 1.5",offload,n,repeats);
+        run_policy<OffloadPolicy,hopeless::pow2_page_growth<>>("pow2_page",offload,n,repeats);
+        run_policy<OffloadPolicy,hopeless::huge_page_growth<>>("huge_page",offload,n,repeats);
+        run_policy<OffloadPolicy,hopeless::capped_linear_growth<>>("capped_linear 64MiB",offload,n,repeats);
+    }
+}
+
+int main(int argc, char ** argv){
+    const std::ptrdiff_t n = (argc > 1) ? std::atol(argv[1]):10000000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]):5;
+    std::printf("%td elements, best of %d\n",n,repeats);
+    std::printf("%-20s %-26s %-10s %10s %14s %8s\n","pattern","policy","offload","ms","capacity","reallocs");
+    run_all<hopeless::host_only>("host_only",n,repeats);
+#ifdef HOPELESS_TARGET_OMP_DEV
+    run_all<hopeless::mirrored<HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>>("mirrored",n,repeats);
+#endif
+    return 0;
+}
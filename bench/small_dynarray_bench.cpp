@@ -0,0 +1,104 @@
+// compares small_dynarray against dynarray on many short arrays, e.g. per cell neighbour lists
+// build from the repository root, e.g.
+//      g++ -std=c++20 -O3 -fopenmp -I. bench/small_dynarray_bench.cpp -o small_dynarray_bench
+//      ./small_dynarray_bench [arrays] [repeats]
+// prints the best time of the repeats in ms, lengths are drawn from 0..2N so about half the arrays stay inline,
+// with HOPELESS_TARGET_OMP_DEV the mirrored rows also pay for the device buffer every dynarray allocates
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<cstddef>
+
+#include "dynarray.hpp"
+#include "small_dynarray.hpp"
+
+namespace
+{
+    template<typename F>
+    double best_of(const int repeats, F && f, long long & checksum){
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r){
+            const auto start = std::chrono::steady_clock::now();
+            checksum += f();
+            const auto stop = std::chrono::steady_clock::now();
+            const double ms = std::chrono::duration<double,std::milli>(stop - start).count();
+            best = (ms < best) ? ms:best;
+        }
+        return best;
+    }
+
+    inline std::ptrdiff_t length_of(const std::ptrdiff_t i, const std::ptrdiff_t max_len){
+        return static_cast<std::ptrdiff_t>((static_cast<unsigned long long>(i) * 2654435761ull) % (max_len + 1));
+    }
+
+    // build, fill with push_back, read back and destroy one short array at a time
+    template<typename Array>
+    long long fill_and_sum(const std::ptrdiff_t arrays, const std::ptrdiff_t max_len){
+        long long sum = 0;
+        for (std::ptrdiff_t i = 0; i < arrays; ++i){
+            Array arr;
+            const std::ptrdiff_t len = length_of(i,max_len);
+            for (std::ptrdiff_t j = 0; j < len; ++j){
+                arr.push_back(static_cast<int>(i + j));
+            }
+            for (std::ptrdiff_t j = 0; j < arr.size(); ++j){
+                sum += arr[j];
+            }
+        }
+        return sum;
+    }
+
+    // a long lived table of short arrays, built once then copied, the copy is what e.g. a time step snapshot costs
+    template<typename Array>
+    long long build_and_copy(const std::ptrdiff_t arrays, const std::ptrdiff_t max_len){
+        hopeless::dynarray<Array,hopeless::allocator<Array>,hopeless::host_only> table(arrays);
+        for (std::ptrdiff_t i = 0; i < arrays; ++i){
+            const std::ptrdiff_t len = length_of(i,max_len);
+            for (std::ptrdiff_t j = 0; j < len; ++j){
+                table[i].push_back(static_cast<int>(j));
+            }
+        }
+        hopeless::dynarray<Array,hopeless::allocator<Array>,hopeless::host_only> copy(table);
+        long long sum = 0;
+        for (std::ptrdiff_t i = 0; i < arrays; i += 97){
+            sum += copy[i].size();
+        }
+        return sum;
+    }
+
+    void print_row(const char * pattern, const char * container, const char * offload, const double ms){
+        std::printf("%-16s %-24s %-10s %10.3f\n",pattern,container,offload,ms);
+    }
+
+    template<typename OffloadPolicy, std::ptrdiff_t N>
+    void run_n(const char * small_name, const char * offload, const std::ptrdiff_t arrays, const int repeats, long long & checksum){
+        using heap = hopeless::dynarray<int,hopeless::allocator<int>,OffloadPolicy>;
+        using small = hopeless::small_dynarray<int,N,hopeless::allocator<int>,OffloadPolicy>;
+        print_row("fill and sum","dynarray",offload,best_of(repeats,[=]{return fill_and_sum<heap>(arrays,2*N);},checksum));
+        print_row("fill and sum",small_name,offload,best_of(repeats,[=]{return fill_and_sum<small>(arrays,2*N);},checksum));
+        print_row("build and copy","dynarray",offload,best_of(repeats,[=]{return build_and_copy<heap>(arrays,2*N);},checksum));
+        print_row("build and copy",small_name,offload,best_of(repeats,[=]{return build_and_copy<small>(arrays,2*N);},checksum));
+    }
+
+    template<typename OffloadPolicy>
+    void run_all(const char * offload, const std::ptrdiff_t arrays, const int repeats, long long & checksum){
+        run_n<OffloadPolicy,4>("small_dynarray<int,4>",offload,arrays,repeats,checksum);
+        run_n<OffloadPolicy,8>("small_dynarray<int,8>",offload,arrays,repeats,checksum);
+        run_n<OffloadPolicy,16>("small_dynarray<int,16>",offload,arrays,repeats,checksum);
+    }
+}
+
+int main(int argc, char ** argv){
+    const std::ptrdiff_t arrays = (argc > 1) ? std::atol(argv[1]):1000000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]):5;
+    long long checksum = 0;
+    std::printf("%td arrays, best of %d\n",arrays,repeats);
+    std::printf("%-16s %-24s %-10s %10s\n","pattern","container","offload","ms");
+    run_all<hopeless::host_only>("host_only",arrays,repeats,checksum);
+#ifdef HOPELESS_TARGET_OMP_DEV
+    // fewer arrays, every dynarray here is a device allocation too
+    run_all<hopeless::mirrored<HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>>("mirrored",arrays / 10,repeats,checksum);
+#endif
+    std::printf("checksum %lld\n",checksum);
+    return 0;
+}
@@ -0,0 +1,678 @@
+// resizable bit array, 64 flags per word stored in a dynarray of std::uint64_t so the device copy (and every transfer)
+// is an eighth of a dynarray<bool>, counting is a popcount per word and and/or/xor work a whole word at a time
+// operator () reads a flag on the device, device_set()/device_reset() write one atomically (other bits of the word
+// may be written by other threads at the same time)
+// the bits past size() in the last word are always kept zero
+// NOTE! this is a separate type and not a dynarray<bool> specialization, code that takes a bool * from dynarray<bool>::data()
+// keeps working, there are no iterators, walk the set flags with find_first_set()/find_next_set() or set_indices()
+#pragma once
+
+#ifndef HOPELESS_BIT_DYNARRAY
+#define HOPELESS_BIT_DYNARRAY
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<type_traits>
+#include<initializer_list>
+#include<utility>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    namespace bit_detail
+    {
+        #pragma omp declare target
+        constexpr inline int popcount(const std::uint64_t word)noexcept{
+        #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(word);
+        #else
+            std::uint64_t w = word - ((word >> 1) & 0x5555555555555555ull);
+            w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+            w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+            return static_cast<int>((w * 0x0101010101010101ull) >> 56);
+        #endif
+        }
+
+        // index of the lowest set bit, word must not be 0
+        constexpr inline int countr_zero(const std::uint64_t word)noexcept{
+        #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(word);
+        #else
+            return popcount((word & (0 - word)) - 1);
+        #endif
+        }
+        #pragma omp end declare target
+    }
+
+    template<typename Allocator = hopeless::allocator<std::uint64_t>, typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY>
+    struct bit_dynarray
+    {
+    public:
+        typedef bool value_type;
+        typedef bool const_reference;
+        typedef std::uint64_t word_type;
+        typedef std::ptrdiff_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef dynarray<word_type,Allocator,OffloadPolicy> word_container_type;
+
+        enum : std::ptrdiff_t {word_bits = 64};
+
+        // proxy for a single flag, like std::vector<bool>::reference
+        // writes map the word to the device (with HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE) if it knows its owner
+        struct reference
+        {
+        public:
+            constexpr reference(word_type * word, const word_type mask, bit_dynarray * owner = nullptr)noexcept
+                :word_(word),mask_(mask),owner_(owner){}
+            constexpr reference(const reference &)noexcept = default;
+
+            constexpr inline operator bool()const noexcept{return (*word_ & mask_) != 0;}
+            constexpr inline bool operator ~()const noexcept{return (*word_ & mask_) == 0;}
+            inline reference & operator =(const bool value)noexcept{
+                *word_ = value ? (*word_ | mask_):(*word_ & ~mask_);
+                changed();
+                return *this;
+            }
+            inline reference & operator =(const reference & rhs)noexcept{return *this = static_cast<bool>(rhs);}
+            inline reference & flip()noexcept{*word_ ^= mask_; changed(); return *this;}
+        private:
+            inline void changed()noexcept{
+            #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+                if (owner_){
+                    owner_->map_word_to_omp_dev(word_ - owner_->data());
+                }
+            #endif
+            }
+            word_type * word_;
+            word_type mask_;
+            bit_dynarray * owner_;
+        };
+
+        bit_dynarray()noexcept;
+        explicit bit_dynarray(size_type count, const bool value = false)noexcept;
+        bit_dynarray(std::initializer_list<bool> init)noexcept;
+
+        // device side, needs the words on the device (map_data_to_omp_dev())
+        #pragma omp declare target
+        inline bool operator ()(const size_type i)const noexcept;
+        inline void device_set(const size_type i)const noexcept;
+        inline void device_reset(const size_type i)const noexcept;
+        #pragma omp end declare target
+
+        inline reference operator [](const size_type i)noexcept;
+        inline bool operator [](const size_type i)const noexcept;
+        inline reference at(size_type pos);
+        inline bool at(size_type pos)const;
+        inline bool test(const size_type i)const noexcept;
+        inline reference front()noexcept;
+        inline bool front()const noexcept;
+        inline reference back()noexcept;
+        inline bool back()const noexcept;
+
+        inline void set(const size_type i, const bool value = true)noexcept;
+        inline void reset(const size_type i)noexcept;
+        inline void flip(const size_type i)noexcept;
+        inline void set()noexcept;      // every flag
+        inline void reset()noexcept;
+        inline void flip()noexcept;
+
+        inline size_type count()const noexcept;     // number of set flags
+        inline bool any()const noexcept;
+        inline bool all()const noexcept;
+        inline bool none()const noexcept;
+
+        // first set flag at or after pos, size() if there is none
+        inline size_type find_first_set()const noexcept;
+        inline size_type find_next_set(size_type pos)const noexcept;
+        // appends the index of every set flag, in order, e.g. to feed buffered_erase
+        template<typename Container>
+        inline auto set_indices(Container & indices)const noexcept
+            -> type_<void,
+                decltype(indices.push_back(std::declval<size_type>()))>;
+
+        // word at a time, both sides have to have the same size
+        inline bit_dynarray & operator &=(const bit_dynarray & rhs)noexcept;
+        inline bit_dynarray & operator |=(const bit_dynarray & rhs)noexcept;
+        inline bit_dynarray & operator ^=(const bit_dynarray & rhs)noexcept;
+        inline bit_dynarray & and_not(const bit_dynarray & rhs)noexcept;   // clears the flags set in rhs
+        inline bit_dynarray operator ~()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;    // in flags
+        constexpr inline size_type word_count()const noexcept;
+        constexpr inline word_type * data()noexcept;
+        constexpr inline const word_type * data()const noexcept;
+        constexpr inline word_container_type & words()noexcept;
+        constexpr inline const word_container_type & words()const noexcept;
+
+        inline void reserve(size_type new_cap)noexcept;
+        inline void shrink_to_fit()noexcept;
+        inline void clear()noexcept;
+        inline void resize(size_type new_size, const bool value = false)noexcept;
+        inline void push_back(const bool value)noexcept;
+        inline void pop_back()noexcept;
+        inline void swap(bit_dynarray & rhs)noexcept;
+
+        inline void map_data_to_omp_dev()noexcept;
+        inline void map_data_from_omp_dev()noexcept;
+
+    private:
+        static constexpr inline size_type words_for(const size_type bits)noexcept{return (bits + word_bits - 1) / word_bits;}
+        static constexpr inline word_type bit_mask(const size_type i)noexcept{return word_type(1) << (i % word_bits);}
+        inline void clear_tail()noexcept;
+        inline void map_word_to_omp_dev(const size_type word)noexcept;     // after a single flag changed
+        inline bool same_size(const bit_dynarray & rhs, const char * op)const noexcept;
+    // member variables
+        word_container_type words_;
+        size_type size_;
+    };
+
+    template<typename Allocator, typename OffloadPolicy>
+    bit_dynarray<Allocator,OffloadPolicy>::bit_dynarray()noexcept
+        :words_(),
+        size_(0){}
+
+    template<typename Allocator, typename OffloadPolicy>
+    bit_dynarray<Allocator,OffloadPolicy>::bit_dynarray(size_type count, const bool value)noexcept
+        :words_(words_for(count),value ? ~word_type(0):word_type(0)),
+        size_(count)
+    {
+        clear_tail();
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    bit_dynarray<Allocator,OffloadPolicy>::bit_dynarray(std::initializer_list<bool> init)noexcept
+        :words_(words_for(static_cast<size_type>(init.size())),word_type(0)),
+        size_(static_cast<size_type>(init.size()))
+    {
+        size_type i = 0;
+        for (const bool value : init){
+            words_[i / word_bits] |= value ? bit_mask(i):word_type(0);
+            ++i;
+        }
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    #pragma omp declare target
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::operator ()(const size_type i)const noexcept{
+        return (words_(i / word_bits) & bit_mask(i)) != 0;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::device_set(const size_type i)const noexcept{
+        word_type & word = words_(i / word_bits);
+        const word_type mask = bit_mask(i);
+        #pragma omp atomic update
+        word |= mask;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::device_reset(const size_type i)const noexcept{
+        word_type & word = words_(i / word_bits);
+        const word_type mask = ~bit_mask(i);
+        #pragma omp atomic update
+        word &= mask;
+    }
+    #pragma omp end declare target
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::reference
+    bit_dynarray<Allocator,OffloadPolicy>::operator [](const size_type i)noexcept{
+        return reference(words_.data() + i / word_bits,bit_mask(i),this);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::operator [](const size_type i)const noexcept{
+        return test(i);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::reference
+    bit_dynarray<Allocator,OffloadPolicy>::at(size_type pos){
+        if ((pos < 0) || (pos >= size_)){
+            std::cerr<<"Error bit_dynarray at() called with an index out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::at(size_type pos)const{
+        if ((pos < 0) || (pos >= size_)){
+            std::cerr<<"Error bit_dynarray at() called with an index out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return test(pos);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::test(const size_type i)const noexcept{
+        return (words_.data()[i / word_bits] & bit_mask(i)) != 0;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::reference
+    bit_dynarray<Allocator,OffloadPolicy>::front()noexcept{
+        return (*this)[0];
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::front()const noexcept{
+        return test(0);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::reference
+    bit_dynarray<Allocator,OffloadPolicy>::back()noexcept{
+        return (*this)[size_ - 1];
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::back()const noexcept{
+        return test(size_ - 1);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::set(const size_type i, const bool value)noexcept{
+        word_type & word = words_[i / word_bits];
+        word = value ? (word | bit_mask(i)):(word & ~bit_mask(i));
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_word_to_omp_dev(i / word_bits);
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::reset(const size_type i)noexcept{
+        words_[i / word_bits] &= ~bit_mask(i);
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_word_to_omp_dev(i / word_bits);
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::flip(const size_type i)noexcept{
+        words_[i / word_bits] ^= bit_mask(i);
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_word_to_omp_dev(i / word_bits);
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::set()noexcept{
+        word_type * w = words_.data();
+        const size_type n = words_.size();
+        #pragma omp simd
+        for (size_type i = 0; i < n; ++i){
+            w[i] = ~word_type(0);
+        }
+        clear_tail();
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::reset()noexcept{
+        if (words_.size() > 0){
+            std::memset(words_.data(),0,words_.size() * sizeof(word_type));
+        }
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::flip()noexcept{
+        word_type * w = words_.data();
+        const size_type n = words_.size();
+        #pragma omp simd
+        for (size_type i = 0; i < n; ++i){
+            w[i] = ~w[i];
+        }
+        clear_tail();
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::size_type
+    bit_dynarray<Allocator,OffloadPolicy>::count()const noexcept{
+        const word_type * w = words_.data();
+        const size_type n = words_.size();
+        size_type total = 0;
+        #pragma omp simd reduction(+:total)
+        for (size_type i = 0; i < n; ++i){
+            total += bit_detail::popcount(w[i]);
+        }
+        return total;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::any()const noexcept{
+        const word_type * w = words_.data();
+        const size_type n = words_.size();
+        for (size_type i = 0; i < n; ++i){
+            if (w[i]){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::all()const noexcept{
+        return count() == size_;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::none()const noexcept{
+        return !any();
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::size_type
+    bit_dynarray<Allocator,OffloadPolicy>::find_first_set()const noexcept{
+        return find_next_set(0);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline typename bit_dynarray<Allocator,OffloadPolicy>::size_type
+    bit_dynarray<Allocator,OffloadPolicy>::find_next_set(size_type pos)const noexcept{
+        if (pos < 0){
+            pos = 0;
+        }
+        if (pos >= size_){
+            return size_;
+        }
+        const word_type * w = words_.data();
+        const size_type n = words_.size();
+        size_type i = pos / word_bits;
+        word_type word = w[i] & (~word_type(0) << (pos % word_bits));
+        while (!word){
+            if (++i >= n){
+                return size_;
+            }
+            word = w[i];
+        }
+        return i * word_bits + bit_detail::countr_zero(word);    // the tail is zero so this is < size_
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    template<typename Container>
+    inline auto bit_dynarray<Allocator,OffloadPolicy>::set_indices(Container & indices)const noexcept
+        -> type_<void,
+            decltype(indices.push_back(std::declval<size_type>()))>
+    {
+        const word_type * w = words_.data();
+        const size_type n = words_.size();
+        for (size_type i = 0; i < n; ++i){
+            word_type word = w[i];
+            while (word){
+                indices.push_back(i * word_bits + bit_detail::countr_zero(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool bit_dynarray<Allocator,OffloadPolicy>::same_size(const bit_dynarray & rhs, const char * op)const noexcept{
+        if (size_ != rhs.size_){
+            std::cerr<<"Error bit_dynarray "<<op<<" called with arrays of different sizes, "<<size_<<" and "<<rhs.size_<<std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> & bit_dynarray<Allocator,OffloadPolicy>::operator &=(const bit_dynarray & rhs)noexcept{
+        if (same_size(rhs,"operator &=")){
+            word_type * w = words_.data();
+            const word_type * r = rhs.words_.data();
+            const size_type n = words_.size();
+            #pragma omp simd
+            for (size_type i = 0; i < n; ++i){
+                w[i] &= r[i];
+            }
+        #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+            map_data_to_omp_dev();
+        #endif
+        }
+        return *this;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> & bit_dynarray<Allocator,OffloadPolicy>::operator |=(const bit_dynarray & rhs)noexcept{
+        if (same_size(rhs,"operator |=")){
+            word_type * w = words_.data();
+            const word_type * r = rhs.words_.data();
+            const size_type n = words_.size();
+            #pragma omp simd
+            for (size_type i = 0; i < n; ++i){
+                w[i] |= r[i];
+            }
+        #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+            map_data_to_omp_dev();
+        #endif
+        }
+        return *this;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> & bit_dynarray<Allocator,OffloadPolicy>::operator ^=(const bit_dynarray & rhs)noexcept{
+        if (same_size(rhs,"operator ^=")){
+            word_type * w = words_.data();
+            const word_type * r = rhs.words_.data();
+            const size_type n = words_.size();
+            #pragma omp simd
+            for (size_type i = 0; i < n; ++i){
+                w[i] ^= r[i];
+            }
+        #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+            map_data_to_omp_dev();
+        #endif
+        }
+        return *this;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> & bit_dynarray<Allocator,OffloadPolicy>::and_not(const bit_dynarray & rhs)noexcept{
+        if (same_size(rhs,"and_not()")){
+            word_type * w = words_.data();
+            const word_type * r = rhs.words_.data();
+            const size_type n = words_.size();
+            #pragma omp simd
+            for (size_type i = 0; i < n; ++i){
+                w[i] &= ~r[i];
+            }
+        #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+            map_data_to_omp_dev();
+        #endif
+        }
+        return *this;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> bit_dynarray<Allocator,OffloadPolicy>::operator ~()const noexcept{
+        bit_dynarray result(*this);
+        result.flip();
+        return result;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> operator &(bit_dynarray<Allocator,OffloadPolicy> lhs, const bit_dynarray<Allocator,OffloadPolicy> & rhs)noexcept{
+        return lhs &= rhs;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> operator |(bit_dynarray<Allocator,OffloadPolicy> lhs, const bit_dynarray<Allocator,OffloadPolicy> & rhs)noexcept{
+        return lhs |= rhs;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bit_dynarray<Allocator,OffloadPolicy> operator ^(bit_dynarray<Allocator,OffloadPolicy> lhs, const bit_dynarray<Allocator,OffloadPolicy> & rhs)noexcept{
+        return lhs ^= rhs;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool operator ==(const bit_dynarray<Allocator,OffloadPolicy> & lhs, const bit_dynarray<Allocator,OffloadPolicy> & rhs)noexcept{
+        return (lhs.size() == rhs.size())
+            && ((lhs.word_count() == 0) || (std::memcmp(lhs.data(),rhs.data(),lhs.word_count() * sizeof(std::uint64_t)) == 0));
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline bool operator !=(const bit_dynarray<Allocator,OffloadPolicy> & lhs, const bit_dynarray<Allocator,OffloadPolicy> & rhs)noexcept{
+        return !(lhs == rhs);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline bool bit_dynarray<Allocator,OffloadPolicy>::empty()const noexcept{
+        return size_ == 0;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline typename bit_dynarray<Allocator,OffloadPolicy>::size_type
+    bit_dynarray<Allocator,OffloadPolicy>::size()const noexcept{
+        return size_;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline typename bit_dynarray<Allocator,OffloadPolicy>::size_type
+    bit_dynarray<Allocator,OffloadPolicy>::capacity()const noexcept{
+        return words_.capacity() * word_bits;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline typename bit_dynarray<Allocator,OffloadPolicy>::size_type
+    bit_dynarray<Allocator,OffloadPolicy>::word_count()const noexcept{
+        return words_.size();
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline typename bit_dynarray<Allocator,OffloadPolicy>::word_type *
+    bit_dynarray<Allocator,OffloadPolicy>::data()noexcept{
+        return words_.data();
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline const typename bit_dynarray<Allocator,OffloadPolicy>::word_type *
+    bit_dynarray<Allocator,OffloadPolicy>::data()const noexcept{
+        return words_.data();
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline typename bit_dynarray<Allocator,OffloadPolicy>::word_container_type &
+    bit_dynarray<Allocator,OffloadPolicy>::words()noexcept{
+        return words_;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    constexpr inline const typename bit_dynarray<Allocator,OffloadPolicy>::word_container_type &
+    bit_dynarray<Allocator,OffloadPolicy>::words()const noexcept{
+        return words_;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::reserve(size_type new_cap)noexcept{
+        words_.reserve(words_for(new_cap));
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::shrink_to_fit()noexcept{
+        words_.shrink_to_fit();
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::clear()noexcept{
+        words_.clear();
+        size_ = 0;
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::resize(size_type new_size, const bool value)noexcept{
+        const size_type old_size = size_;
+        words_.resize(words_for(new_size),value ? ~word_type(0):word_type(0));
+        size_ = new_size;
+        if (value && (new_size > old_size) && (old_size % word_bits)){
+            words_[old_size / word_bits] |= ~word_type(0) << (old_size % word_bits);
+        }
+        clear_tail();
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::push_back(const bool value)noexcept{
+        if ((size_ % word_bits) == 0){
+            words_.push_back(word_type(0));
+        }
+        words_[size_ / word_bits] |= value ? bit_mask(size_):word_type(0);
+        ++size_;
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::pop_back()noexcept{
+        --size_;
+        if ((size_ % word_bits) == 0){
+            words_.pop_back();
+        }else{
+            words_[size_ / word_bits] &= ~bit_mask(size_);
+        }
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::swap(bit_dynarray & rhs)noexcept{
+        using std::swap;
+        words_.swap(rhs.words_);
+        swap(size_,rhs.size_);
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::clear_tail()noexcept{
+        if (size_ % word_bits){
+            words_[size_ / word_bits] &= bit_mask(size_) - 1;
+        }
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            words_.map_data_to_omp_dev();
+        }
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::map_word_to_omp_dev(const size_type word)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            words_.map_data_to_omp_dev(word,word + 1);
+        }
+    }
+
+    template<typename Allocator, typename OffloadPolicy>
+    inline void bit_dynarray<Allocator,OffloadPolicy>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            words_.map_data_from_omp_dev();
+        }
+    }
+}
+#endif
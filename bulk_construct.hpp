@@ -0,0 +1,123 @@
+// bulk element construction and copying used by dynarray when constructing can't throw
+// trivially copyable elements with a plain allocator are filled and copied by the kernels in simd_kernels.hpp
+// the loops run in an omp parallel region (simd for fundamental types) once there are at least HOPELESS_DYNARRAY_PARALLEL_THRESHOLD elements
+#pragma once
+
+#ifndef HOPELESS_BULK_CONSTRUCT
+#define HOPELESS_BULK_CONSTRUCT
+
+#include<cstddef>
+#include<memory>
+#include<utility>
+#include<type_traits>
+#include<cstring>
+#include<omp.h>
+
+#include "simd_kernels.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    // f(begin,end) on one contiguous chunk of [0,count) per thread, or once on the calling thread when count < HOPELESS_DYNARRAY_PARALLEL_THRESHOLD
+    template<typename F>
+    inline void bulk_for_chunks(const std::ptrdiff_t count, F && f)noexcept{
+        if (count < HOPELESS_DYNARRAY_PARALLEL_THRESHOLD){
+            if (count > 0){
+                f(std::ptrdiff_t(0),count);
+            }
+            return;
+        }
+        #pragma omp parallel
+        {
+            const std::ptrdiff_t threads = omp_get_num_threads();
+            const std::ptrdiff_t chunk = (count + threads - 1)/threads;
+            const std::ptrdiff_t begin = omp_get_thread_num() * chunk;
+            const std::ptrdiff_t end = (begin + chunk < count) ? begin + chunk:count;
+            if (begin < end){
+                f(begin,end);
+            }
+        }
+    }
+
+    // memcpy of count elements, split into one contiguous chunk per thread when count >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD
+    template<typename T>
+    inline void bulk_memcpy(T * dst, const T * src, const std::ptrdiff_t count)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "bulk_memcpy needs a trivially copyable type");
+        bulk_for_chunks(count,[dst,src](const std::ptrdiff_t begin, const std::ptrdiff_t end){
+            kernels::copy(dst + begin,src + begin,end - begin);
+        });
+    }
+
+    // construct buffer[begin,end) as copies of value
+    template<typename Allocator, typename T>
+    inline void bulk_construct_fill(Allocator & alloc, T * buffer, const std::ptrdiff_t begin, const std::ptrdiff_t end, const T & value)noexcept{
+        if constexpr (is_plain_construct_v<Allocator,T>){
+            const T fill_value = value;
+            bulk_for_chunks(end - begin,[buffer,begin,fill_value](const std::ptrdiff_t first, const std::ptrdiff_t last){
+                kernels::fill(buffer + begin + first,last - first,fill_value);
+            });
+        }else if constexpr (std::is_fundamental_v<T>){
+            #pragma omp parallel for simd if((end - begin) >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = begin; i < end; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+i,value);
+            }
+        }else{
+            #pragma omp parallel for if((end - begin) >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = begin; i < end; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+i,value);
+            }
+        }
+    }
+
+    // value initialise buffer[begin,end)
+    template<typename Allocator, typename T>
+    inline void bulk_construct_default(Allocator & alloc, T * buffer, const std::ptrdiff_t begin, const std::ptrdiff_t end)noexcept{
+        if constexpr (std::is_fundamental_v<T>){
+            #pragma omp parallel for simd if((end - begin) >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = begin; i < end; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+i);
+            }
+        }else{
+            #pragma omp parallel for if((end - begin) >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = begin; i < end; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+i);
+            }
+        }
+    }
+
+    // construct buffer[begin,begin+count) from first[0,count), first has to be a random access iterator
+    template<typename Allocator, typename T, typename RandomIt>
+    inline void bulk_construct_copy(Allocator & alloc, T * buffer, const std::ptrdiff_t begin, RandomIt first, const std::ptrdiff_t count)noexcept{
+        if constexpr (is_plain_construct_v<Allocator,T> && std::is_pointer_v<RandomIt> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<RandomIt>>,T>){
+            bulk_memcpy(buffer + begin,first,count);
+        }else if constexpr (std::is_fundamental_v<T>){
+            #pragma omp parallel for simd if(count >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = 0; i < count; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+begin+i,first[i]);
+            }
+        }else{
+            #pragma omp parallel for if(count >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = 0; i < count; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+begin+i,first[i]);
+            }
+        }
+    }
+
+    // same as bulk_construct_copy but moves out of first
+    template<typename Allocator, typename T, typename RandomIt>
+    inline void bulk_construct_move(Allocator & alloc, T * buffer, const std::ptrdiff_t begin, RandomIt first, const std::ptrdiff_t count)noexcept{
+        if constexpr (std::is_fundamental_v<T>){
+            #pragma omp parallel for simd if(count >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = 0; i < count; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+begin+i,std::move(first[i]));
+            }
+        }else{
+            #pragma omp parallel for if(count >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (std::ptrdiff_t i = 0; i < count; ++i){
+                std::allocator_traits<Allocator>::construct(alloc,buffer+begin+i,std::move(first[i]));
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,257 @@
+// appending to a dynarray from many threads of a #pragma omp parallel region
+// per_thread_buffers gives every thread its own host_only dynarray, flush_into() appends all of them to a dynarray
+// with one prefix sum over the buffer sizes, one grow and one parallel copy
+// concurrent_appender hands out slots of capacity reserved up front with an atomic fetch-add, threads that
+// run past the reservation spill into per thread buffers which are merged in by finish(), so nothing reallocates
+// while other threads are still writing
+// NOTE! both only work with trivially copyable T and neither maps anything to the device,
+// call map_data_to_omp_dev() on the destination afterwards if it is mirrored
+#pragma once
+
+#ifndef HOPELESS_CONCURRENT_APPEND
+#define HOPELESS_CONCURRENT_APPEND
+
+#include<iostream>
+#include<cstddef>
+#include<cstring>
+#include<memory>
+#include<type_traits>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename T, typename Allocator = hopeless::allocator<T>>
+    struct per_thread_buffers
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "per_thread_buffers needs a trivially copyable type");
+    public:
+        typedef std::ptrdiff_t size_type;
+        typedef T value_type;
+        typedef dynarray<T,Allocator,host_only> buffer_type;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<buffer_type> b_allocator_type;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<size_type> s_allocator_type;
+
+        // one buffer for each of num_threads threads, a parallel region using these can't have a bigger team
+        explicit per_thread_buffers(size_type num_threads = omp_get_max_threads(), size_type reserve_each = 0)noexcept;
+        per_thread_buffers(const per_thread_buffers & other) = delete;
+        per_thread_buffers& operator =(const per_thread_buffers & other) = delete;
+        ~per_thread_buffers()noexcept;
+
+        // buffer of the calling thread, only that thread should touch it inside the parallel region
+        inline buffer_type & local()noexcept;
+        inline buffer_type & operator [](size_type thread_num)noexcept;
+        inline void push_back(const T & value)noexcept;     // local().push_back(value)
+
+        constexpr inline size_type num_buffers()const noexcept;
+        inline size_type size()const noexcept;     // total number of elements over all the buffers
+        inline void clear()noexcept;
+
+        // append every buffer to dst in thread order and empty them (they keep their capacity),
+        // call outside of the parallel region that filled them
+        template<typename Container>
+        inline void flush_into(Container & dst)noexcept;
+
+    private:
+        buffer_type * buffers_;
+        size_type num_buffers_;
+    };
+
+    template<typename T, typename Allocator>
+    per_thread_buffers<T,Allocator>::per_thread_buffers(size_type num_threads, size_type reserve_each)noexcept
+        :buffers_(nullptr),
+        num_buffers_(0)
+    {
+        if (num_threads < 1){
+            num_threads = 1;
+        }
+        b_allocator_type alloc;
+        buffers_ = std::allocator_traits<b_allocator_type>::allocate(alloc,num_threads);
+        if (!buffers_){
+            std::cerr<<"ERROR per_thread_buffers failed to allocate memory"<<std::endl;
+            return;
+        }
+        for (size_type i = 0; i < num_threads; ++i){
+            std::allocator_traits<b_allocator_type>::construct(alloc,buffers_+i);
+            if (reserve_each > 0){
+                buffers_[i].reserve(reserve_each);
+            }
+        }
+        num_buffers_ = num_threads;
+    }
+
+    template<typename T, typename Allocator>
+    per_thread_buffers<T,Allocator>::~per_thread_buffers()noexcept{
+        b_allocator_type alloc;
+        for (size_type i = 0; i < num_buffers_; ++i){
+            std::allocator_traits<b_allocator_type>::destroy(alloc,buffers_+i);
+        }
+        std::allocator_traits<b_allocator_type>::deallocate(alloc,buffers_,num_buffers_);
+    }
+
+    template<typename T, typename Allocator>
+    inline typename per_thread_buffers<T,Allocator>::buffer_type & per_thread_buffers<T,Allocator>::local()noexcept{
+        return (*this)[omp_get_thread_num()];
+    }
+
+    template<typename T, typename Allocator>
+    inline typename per_thread_buffers<T,Allocator>::buffer_type & per_thread_buffers<T,Allocator>::operator [](size_type thread_num)noexcept{
+        if (thread_num >= num_buffers_){
+            std::cerr<<"ERROR per_thread_buffers has fewer buffers than threads in the team"<<std::endl;
+            std::terminate();
+        }
+        return buffers_[thread_num];
+    }
+
+    template<typename T, typename Allocator>
+    inline void per_thread_buffers<T,Allocator>::push_back(const T & value)noexcept{
+        local().push_back(value);
+    }
+
+    template<typename T, typename Allocator>
+    constexpr inline typename per_thread_buffers<T,Allocator>::size_type per_thread_buffers<T,Allocator>::num_buffers()const noexcept{
+        return num_buffers_;
+    }
+
+    template<typename T, typename Allocator>
+    inline typename per_thread_buffers<T,Allocator>::size_type per_thread_buffers<T,Allocator>::size()const noexcept{
+        size_type total = 0;
+        for (size_type i = 0; i < num_buffers_; ++i){
+            total += buffers_[i].size();
+        }
+        return total;
+    }
+
+    template<typename T, typename Allocator>
+    inline void per_thread_buffers<T,Allocator>::clear()noexcept{
+        for (size_type i = 0; i < num_buffers_; ++i){
+            buffers_[i].clear();
+        }
+    }
+
+    template<typename T, typename Allocator>
+    template<typename Container>
+    inline void per_thread_buffers<T,Allocator>::flush_into(Container & dst)noexcept{
+        static_assert(std::is_same_v<typename Container::value_type,T>, "flush_into needs a dynarray of the same element type");
+        const size_type n = num_buffers_;
+        s_allocator_type s_alloc;
+        size_type * offsets = std::allocator_traits<s_allocator_type>::allocate(s_alloc,n+1);
+        if (!offsets){
+            std::cerr<<"ERROR per_thread_buffers failed to allocate memory"<<std::endl;
+            return;
+        }
+        // exclusive prefix sum of the buffer sizes gives every buffer its slot in dst
+        offsets[0] = dst.size();
+        for (size_type i = 0; i < n; ++i){
+            offsets[i+1] = offsets[i] + buffers_[i].size();
+        }
+        if (offsets[n] != offsets[0]){
+            dst.resize_uninitialized(offsets[n]);
+            if (dst.size() != offsets[n]){
+                std::cerr<<"ERROR per_thread_buffers failed to grow the destination"<<std::endl;
+                std::allocator_traits<s_allocator_type>::deallocate(s_alloc,offsets,n+1);
+                return;
+            }
+            T * out = dst.data();
+            buffer_type * buffers = buffers_;
+            #pragma omp parallel for schedule(dynamic,1) if((offsets[n] - offsets[0]) >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (size_type i = 0; i < n; ++i){
+                const size_type count = offsets[i+1] - offsets[i];
+                if (count > 0){
+                    std::memcpy(static_cast<void*>(out + offsets[i]),static_cast<const void*>(buffers[i].data()),sizeof(T)*count);
+                }
+            }
+        }
+        clear();
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,offsets,n+1);
+    }
+
+
+    template<typename Container>
+    struct concurrent_appender
+    {
+    public:
+        typedef typename Container::value_type value_type;
+        typedef typename Container::allocator_type allocator_type;
+        typedef std::ptrdiff_t size_type;
+        static_assert(std::is_trivially_copyable_v<value_type>, "concurrent_appender needs a trivially copyable type");
+
+        // reserves room for expected_count more elements in dst, the reservation is what threads fetch-add into
+        // dst must not be touched by anything else until finish()
+        concurrent_appender(Container & dst, size_type expected_count,
+            size_type num_threads = omp_get_max_threads())noexcept;
+        concurrent_appender(const concurrent_appender & other) = delete;
+        concurrent_appender& operator =(const concurrent_appender & other) = delete;
+        ~concurrent_appender()noexcept;     // calls finish()
+
+        // safe to call from any thread of the parallel region, the order of the appended elements is unspecified
+        inline void push_back(const value_type & value)noexcept;
+
+        // after the parallel region, sets the size of dst and appends whatever spilled past the reservation,
+        // the appender can be used again afterwards with the capacity dst has left
+        inline void finish()noexcept;
+
+        inline size_type overflow_count()const noexcept;    // elements that didn't fit in the reservation so far
+
+    private:
+        Container & dst_;
+        value_type * data_;
+        size_type next_;        // next free slot, only ever read and bumped with omp atomic capture
+        size_type capacity_;
+        per_thread_buffers<value_type,allocator_type> overflow_;
+    };
+
+    template<typename Container>
+    concurrent_appender<Container>::concurrent_appender(Container & dst, size_type expected_count, size_type num_threads)noexcept
+        :dst_(dst),
+        data_(nullptr),
+        next_(0),
+        capacity_(0),
+        overflow_(num_threads)
+    {
+        if (expected_count > 0){
+            dst_.reserve(dst_.size() + expected_count);
+        }
+        data_ = dst_.data();
+        next_ = dst_.size();
+        capacity_ = dst_.capacity();
+    }
+
+    template<typename Container>
+    concurrent_appender<Container>::~concurrent_appender()noexcept{
+        finish();
+    }
+
+    template<typename Container>
+    inline void concurrent_appender<Container>::push_back(const value_type & value)noexcept{
+        size_type slot;
+        #pragma omp atomic capture
+        slot = next_++;
+        if (slot < capacity_){
+            std::memcpy(static_cast<void*>(data_ + slot),static_cast<const void*>(&value),sizeof(value_type));
+        }else{
+            overflow_.push_back(value);
+        }
+    }
+
+    template<typename Container>
+    inline void concurrent_appender<Container>::finish()noexcept{
+        const size_type filled = (next_ < capacity_) ? next_:capacity_;
+        if (filled > dst_.size()){
+            dst_.resize_uninitialized(filled);
+        }
+        overflow_.flush_into(dst_);
+        data_ = dst_.data();
+        next_ = dst_.size();
+        capacity_ = dst_.capacity();
+    }
+
+    template<typename Container>
+    inline typename concurrent_appender<Container>::size_type concurrent_appender<Container>::overflow_count()const noexcept{
+        return overflow_.size();
+    }
+}
+#endif
@@ -0,0 +1,145 @@
+// content hash of the flat buffer of a dynarray or r2darray, e.g. to key a cache of results on the input arrays
+// the hash is XXH64 (same result as the reference xxhash for the same bytes and seed), four independent 64 bit lanes
+// over 32 byte stripes so the main loop runs close to memory speed, r2darray hashes the row sizes first and uses
+// that as the seed for the elements so the same elements split into different rows hash differently
+//      std::unordered_map<hopeless::dynarray<int>,result,hopeless::content_hasher> cache;
+// NOTE! the bytes are hashed, floats that compare equal but differ in bytes (0.0 and -0.0) hash differently and
+// elements with padding bytes shouldn't be hashed at all, only the host copy is read
+#pragma once
+
+#ifndef HOPELESS_CONTENT_HASH
+#define HOPELESS_CONTENT_HASH
+
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<type_traits>
+
+#include "dynarray.hpp"
+#include "ragged_array.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    namespace hash_detail
+    {
+        enum : std::uint64_t {
+            prime1 = 11400714785074694791ull,
+            prime2 = 14029467366897019727ull,
+            prime3 = 1609587929392839161ull,
+            prime4 = 9650029242287828579ull,
+            prime5 = 2870177450012600261ull
+        };
+
+        constexpr inline std::uint64_t rotl(const std::uint64_t x, const int r)noexcept{
+            return (x << r) | (x >> (64 - r));
+        }
+
+        // little endian loads, memcpy so unaligned buffers are fine
+        inline std::uint64_t read64(const unsigned char * p)noexcept{
+            std::uint64_t v;
+            std::memcpy(&v,p,sizeof(v));
+        #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            v = __builtin_bswap64(v);
+        #endif
+            return v;
+        }
+
+        inline std::uint64_t read32(const unsigned char * p)noexcept{
+            std::uint32_t v;
+            std::memcpy(&v,p,sizeof(v));
+        #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            v = __builtin_bswap32(v);
+        #endif
+            return v;
+        }
+
+        constexpr inline std::uint64_t round(std::uint64_t acc, const std::uint64_t input)noexcept{
+            acc += input * prime2;
+            acc = rotl(acc,31);
+            return acc * prime1;
+        }
+
+        constexpr inline std::uint64_t merge_round(std::uint64_t acc, const std::uint64_t lane)noexcept{
+            acc ^= round(0,lane);
+            return acc * prime1 + prime4;
+        }
+    }
+
+    inline std::uint64_t xxh64(const void * data, const std::size_t bytes, const std::uint64_t seed = 0)noexcept{
+        using namespace hash_detail;
+        const unsigned char * p = static_cast<const unsigned char *>(data);
+        const unsigned char * const end = p + bytes;
+        std::uint64_t h;
+        if (bytes >= 32){
+            std::uint64_t v1 = seed + prime1 + prime2;
+            std::uint64_t v2 = seed + prime2;
+            std::uint64_t v3 = seed;
+            std::uint64_t v4 = seed - prime1;
+            const unsigned char * const last_stripe = end - 32;
+            do{
+                v1 = round(v1,read64(p));
+                v2 = round(v2,read64(p + 8));
+                v3 = round(v3,read64(p + 16));
+                v4 = round(v4,read64(p + 24));
+                p += 32;
+            }while (p <= last_stripe);
+            h = rotl(v1,1) + rotl(v2,7) + rotl(v3,12) + rotl(v4,18);
+            h = merge_round(h,v1);
+            h = merge_round(h,v2);
+            h = merge_round(h,v3);
+            h = merge_round(h,v4);
+        }else{
+            h = seed + prime5;
+        }
+        h += static_cast<std::uint64_t>(bytes);
+        for (; p + 8 <= end; p += 8){
+            h ^= round(0,read64(p));
+            h = rotl(h,27) * prime1 + prime4;
+        }
+        if (p + 4 <= end){
+            h ^= read32(p) * prime1;
+            h = rotl(h,23) * prime2 + prime3;
+            p += 4;
+        }
+        for (; p < end; ++p){
+            h ^= (*p) * static_cast<std::uint64_t>(prime5);
+            h = rotl(h,11) * prime1;
+        }
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline std::uint64_t content_hash(const dynarray<T,Allocator,OffloadPolicy,GrowthPolicy> & arr, const std::uint64_t seed = 0)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "content_hash hashes the bytes of the elements, type should be trivially copyable");
+        return xxh64(arr.data(),arr.size() * sizeof(T),seed);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline std::uint64_t content_hash(const r2darray<T,Allocator,OffloadPolicy,GrowthPolicy> & arr, const std::uint64_t seed = 0)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "content_hash hashes the bytes of the elements, type should be trivially copyable");
+        const std::ptrdiff_t rows = arr.size();
+        dynarray<std::int64_t,hopeless::allocator<std::int64_t>,host_only> row_sizes(rows,for_overwrite);
+        auto row = arr.begin();
+        for (std::ptrdiff_t i = 0; i < rows; ++i){
+            row_sizes[i] = static_cast<std::int64_t>(row[i].size());
+        }
+        const std::uint64_t shape = xxh64(row_sizes.data(),rows * sizeof(std::int64_t),seed);
+        return xxh64(ragged_detail::flat_begin<T>(arr),ragged_detail::flat_size(arr) * sizeof(T),shape);
+    }
+
+    // for unordered containers keyed on arrays
+    struct content_hasher
+    {
+        template<typename Array>
+        inline std::size_t operator ()(const Array & arr)const noexcept{
+            return static_cast<std::size_t>(content_hash(arr));
+        }
+    };
+}
+#endif
@@ -0,0 +1,575 @@
+// open addressing hash map (linear probing, power of two capacity) with the key and value slots in two dynarrays
+// so the same table can be probed on the host and inside offloaded kernels, operator () looks a key up on the device
+// and device_insert() inserts from many device threads at once by claiming key slots with omp atomic compare
+// keys have to be integral (they are swapped in atomically) and one key value is reserved to mark empty slots,
+// it is never found and can't be inserted
+// NOTE! device_insert() can't grow the table, reserve() on the host for everything a kernel may insert
+// NOTE! the host copy (and size()) only sees device inserts after map_data_from_omp_dev(), rehash() and the host
+// insert/erase functions work on the host copy
+#pragma once
+
+#ifndef HOPELESS_DEVICE_HASH_MAP
+#define HOPELESS_DEVICE_HASH_MAP
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<cstdint>
+#include<type_traits>
+#include<limits>
+#include<utility>
+#include<iterator>
+#include<algorithm>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    #pragma omp declare target
+    // default hash, the 64 bit murmur3 finalizer, cheap and good enough for linear probing on integer keys
+    template<typename Key>
+    struct hash_mix
+    {
+        constexpr inline std::uint64_t operator ()(const Key & key)const noexcept{
+            std::uint64_t h = static_cast<std::uint64_t>(key);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+    };
+    #pragma omp end declare target
+
+    namespace hash_detail{
+        #pragma omp declare target
+        // slot of key or -1, the probe stops at the first empty slot, the empty key is never stored
+        template<typename Key, typename Hash>
+        inline std::ptrdiff_t probe_find(const Key * keys, const std::ptrdiff_t mask, const Key & key, const Key & empty_key, const Hash & hash)noexcept{
+            if (key == empty_key){
+                return -1;
+            }
+            std::ptrdiff_t i = static_cast<std::ptrdiff_t>(hash(key)) & mask;
+            for (std::ptrdiff_t n = 0; n <= mask; ++n){
+                const Key k = keys[i];
+                if (k == key){
+                    return i;
+                }
+                if (k == empty_key){
+                    return -1;
+                }
+                i = (i + 1) & mask;
+            }
+            return -1;
+        }
+
+        // slot holding key afterwards or -1 if the table is full (or key is the empty key), inserted is set if this call claimed the slot
+        // safe to call from many threads at once on the same table (slots only ever go from empty to a key)
+        template<typename Key, typename Hash>
+        inline std::ptrdiff_t probe_insert(Key * keys, const std::ptrdiff_t mask, const Key & key, const Key & empty_key, const Hash & hash, bool & inserted)noexcept{
+            inserted = false;
+            if (key == empty_key){
+                return -1;
+            }
+            std::ptrdiff_t i = static_cast<std::ptrdiff_t>(hash(key)) & mask;
+            for (std::ptrdiff_t n = 0; n <= mask; ++n){
+                Key old;
+                Key & slot = keys[i];
+                #pragma omp atomic compare capture
+                {
+                    old = slot;
+                    if (slot == empty_key){
+                        slot = key;
+                    }
+                }
+                if (old == empty_key){
+                    inserted = true;
+                    return i;
+                }
+                if (old == key){
+                    return i;
+                }
+                i = (i + 1) & mask;
+            }
+            return -1;
+        }
+        #pragma omp end declare target
+    }
+
+    template<typename Key, typename T, typename Hash = hash_mix<Key>, typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY>
+    struct device_hash_map
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef Hash hasher;
+        typedef std::ptrdiff_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef dynarray<Key,hopeless::allocator<Key>,OffloadPolicy> key_container_type;
+        typedef dynarray<T,hopeless::allocator<T>,OffloadPolicy> mapped_container_type;
+
+        static_assert(std::is_integral_v<Key>, "device_hash_map keys should be integral");
+
+        // the table grows once it is more than 3/4 full
+        enum : std::ptrdiff_t {min_capacity = 16, max_load_num = 3, max_load_den = 4};
+
+        explicit device_hash_map(const Key empty_key = std::numeric_limits<Key>::max(), const Hash & hash = Hash())noexcept;
+        // room for expected_count keys without growing, the tag keeps the count from being taken for an empty_key
+        device_hash_map(with_capacity_t, size_type expected_count, const Key empty_key = std::numeric_limits<Key>::max(),
+            const Hash & hash = Hash())noexcept;
+
+        #pragma omp declare target
+        // device side lookup, the device copy of the value or nullptr
+        inline T * operator ()(const Key & key)const noexcept;
+        // device side insert, true if the key was new, if the key was there its value is left alone
+        // false is also returned if the table is full or key is the empty key
+        inline bool device_insert(const Key & key, const T & value)const noexcept;
+        #pragma omp end declare target
+
+        inline T * find(const Key & key)noexcept;       // host copy of the value or nullptr
+        inline const T * find(const Key & key)const noexcept;
+        inline T & at(const Key & key);
+        inline const T & at(const Key & key)const;
+        inline T & operator [](const Key & key);    // inserts T() if key isn't there, throws for the empty key
+        inline bool contains(const Key & key)const noexcept;
+        inline size_type count(const Key & key)const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;     // number of slots, always a power of two
+        constexpr inline Key empty_key()const noexcept;
+        constexpr inline hasher hash_function()const noexcept;
+        // the raw slots, a slot is used if key_slots()[i] != empty_key()
+        constexpr inline const key_container_type & key_slots()const noexcept;
+        constexpr inline const mapped_container_type & value_slots()const noexcept;
+
+        // single pair, grows the table if needed, false (and the stored value is kept) if the key was there
+        inline bool insert(const Key & key, const T & value)noexcept;
+        inline bool insert_or_assign(const Key & key, const T & value)noexcept;
+        // bulk build from pairs, reserves once and inserts in parallel for random access ranges, for keys that
+        // show up more than once in the batch one of the values is kept
+        template<typename InputIt>
+        inline auto insert(InputIt first, InputIt last)noexcept
+            -> type_<void,
+                decltype(std::declval<InputIt>()->first),
+                decltype(std::declval<InputIt>()->second),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        template<typename Container>
+        inline auto insert_range(const Container & container)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end())>;
+
+        // backward shift deletion, no tombstones so lookups never slow down after erasing
+        inline size_type erase(const Key & key)noexcept;
+        inline void clear()noexcept;
+        // make room for count keys without growing again
+        inline void reserve(size_type count)noexcept;
+        // new table with at least new_cap slots (rounded up to a power of two and to fit size()), every key is
+        // reinserted in one parallel pass
+        inline void rehash(size_type new_cap)noexcept;
+
+        inline void map_data_to_omp_dev()noexcept;
+        // also recounts size() so inserts done on the device are picked up
+        inline void map_data_from_omp_dev()noexcept;
+
+    private:
+        inline size_type index_of(const Key & key)const noexcept;
+        inline static size_type slots_for(size_type count)noexcept;
+        inline void grow_if_needed(size_type extra)noexcept;
+        inline void recount()noexcept;
+
+    // member variables
+        key_container_type keys_;
+        mapped_container_type values_;
+        size_type size_;
+        size_type mask_;
+        Key empty_key_;
+        Hash hash_;
+    };
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    device_hash_map<Key,T,Hash,OffloadPolicy>::device_hash_map(const Key empty_key, const Hash & hash)noexcept
+        :keys_(min_capacity,empty_key),
+        values_(min_capacity),
+        size_(0),
+        mask_(min_capacity - 1),
+        empty_key_(empty_key),
+        hash_(hash){}
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    device_hash_map<Key,T,Hash,OffloadPolicy>::device_hash_map(with_capacity_t, size_type expected_count, const Key empty_key,
+        const Hash & hash)noexcept
+        :keys_(slots_for(expected_count),empty_key),
+        values_(slots_for(expected_count)),
+        size_(0),
+        mask_(slots_for(expected_count) - 1),
+        empty_key_(empty_key),
+        hash_(hash){}
+
+    #pragma omp declare target
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline T * device_hash_map<Key,T,Hash,OffloadPolicy>::operator ()(const Key & key)const noexcept{
+        const size_type i = hash_detail::probe_find(&keys_(0),mask_,key,empty_key_,hash_);
+        return (i >= 0) ? &values_(i):nullptr;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline bool device_hash_map<Key,T,Hash,OffloadPolicy>::device_insert(const Key & key, const T & value)const noexcept{
+        bool inserted;
+        const size_type i = hash_detail::probe_insert(&keys_(0),mask_,key,empty_key_,hash_,inserted);
+        if (inserted){
+            values_(i) = value;
+        }
+        return inserted;
+    }
+    #pragma omp end declare target
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::size_type
+    device_hash_map<Key,T,Hash,OffloadPolicy>::slots_for(size_type count)noexcept{
+        size_type cap = min_capacity;
+        while (cap * max_load_num < count * max_load_den){
+            cap *= 2;
+        }
+        return cap;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::size_type
+    device_hash_map<Key,T,Hash,OffloadPolicy>::index_of(const Key & key)const noexcept{
+        return hash_detail::probe_find(keys_.data(),mask_,key,empty_key_,hash_);
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline T * device_hash_map<Key,T,Hash,OffloadPolicy>::find(const Key & key)noexcept{
+        const size_type i = index_of(key);
+        return (i >= 0) ? values_.data() + i:nullptr;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline const T * device_hash_map<Key,T,Hash,OffloadPolicy>::find(const Key & key)const noexcept{
+        const size_type i = index_of(key);
+        return (i >= 0) ? values_.data() + i:nullptr;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline T & device_hash_map<Key,T,Hash,OffloadPolicy>::at(const Key & key){
+        T * value = find(key);
+        if (value == nullptr){
+            std::cerr<<"Error device_hash_map at() called with a key that isn't stored"<<std::endl;
+            throw std::out_of_range("Key passed to at() not found");
+        }
+        return *value;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline const T & device_hash_map<Key,T,Hash,OffloadPolicy>::at(const Key & key)const{
+        const T * value = find(key);
+        if (value == nullptr){
+            std::cerr<<"Error device_hash_map at() called with a key that isn't stored"<<std::endl;
+            throw std::out_of_range("Key passed to at() not found");
+        }
+        return *value;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline T & device_hash_map<Key,T,Hash,OffloadPolicy>::operator [](const Key & key){
+        if (key == empty_key_){
+            std::cerr<<"Error device_hash_map operator [] called with the empty key"<<std::endl;
+            throw std::invalid_argument("The empty key passed to operator [] can't be stored");
+        }
+        size_type i = index_of(key);
+        if (i < 0){
+            grow_if_needed(1);
+            bool inserted;
+            i = hash_detail::probe_insert(keys_.data(),mask_,key,empty_key_,hash_,inserted);
+            values_[i] = T();
+            ++size_;
+        }
+        return values_[i];
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline bool device_hash_map<Key,T,Hash,OffloadPolicy>::contains(const Key & key)const noexcept{
+        return (index_of(key) >= 0);
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::size_type
+    device_hash_map<Key,T,Hash,OffloadPolicy>::count(const Key & key)const noexcept{
+        return static_cast<size_type>(contains(key));
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline bool device_hash_map<Key,T,Hash,OffloadPolicy>::empty()const noexcept{
+        return (size_ == 0);
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::size_type
+    device_hash_map<Key,T,Hash,OffloadPolicy>::size()const noexcept{
+        return size_;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::size_type
+    device_hash_map<Key,T,Hash,OffloadPolicy>::capacity()const noexcept{
+        return mask_ + 1;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline Key device_hash_map<Key,T,Hash,OffloadPolicy>::empty_key()const noexcept{
+        return empty_key_;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::hasher
+    device_hash_map<Key,T,Hash,OffloadPolicy>::hash_function()const noexcept{
+        return hash_;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline const typename device_hash_map<Key,T,Hash,OffloadPolicy>::key_container_type &
+    device_hash_map<Key,T,Hash,OffloadPolicy>::key_slots()const noexcept{
+        return keys_;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    constexpr inline const typename device_hash_map<Key,T,Hash,OffloadPolicy>::mapped_container_type &
+    device_hash_map<Key,T,Hash,OffloadPolicy>::value_slots()const noexcept{
+        return values_;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::grow_if_needed(size_type extra)noexcept{
+        if ((size_ + extra) * max_load_den > capacity() * max_load_num){
+            rehash(slots_for(size_ + extra));
+        }
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline bool device_hash_map<Key,T,Hash,OffloadPolicy>::insert(const Key & key, const T & value)noexcept{
+        if (key == empty_key_){
+            std::cerr<<"Error device_hash_map insert() called with the empty key"<<std::endl;
+            return false;
+        }
+        grow_if_needed(1);
+        bool inserted;
+        const size_type i = hash_detail::probe_insert(keys_.data(),mask_,key,empty_key_,hash_,inserted);
+        if (inserted){
+            values_[i] = value;
+            ++size_;
+        #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+            map_data_to_omp_dev();
+        #endif
+        }
+        return inserted;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline bool device_hash_map<Key,T,Hash,OffloadPolicy>::insert_or_assign(const Key & key, const T & value)noexcept{
+        if (key == empty_key_){
+            std::cerr<<"Error device_hash_map insert_or_assign() called with the empty key"<<std::endl;
+            return false;
+        }
+        grow_if_needed(1);
+        bool inserted;
+        const size_type i = hash_detail::probe_insert(keys_.data(),mask_,key,empty_key_,hash_,inserted);
+        values_[i] = value;
+        size_ += static_cast<size_type>(inserted);
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+        return inserted;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    template<typename InputIt>
+    inline auto device_hash_map<Key,T,Hash,OffloadPolicy>::insert(InputIt first, InputIt last)noexcept
+        -> type_<void,
+            decltype(std::declval<InputIt>()->first),
+            decltype(std::declval<InputIt>()->second),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        if constexpr (is_random_access_iterator_v<InputIt>){
+            const size_type count = last - first;
+            if (count <= 0){
+                return;
+            }
+            grow_if_needed(count);
+            Key * keys = keys_.data();
+            T * values = values_.data();
+            const size_type mask = mask_;
+            const Key empty_key = empty_key_;
+            const Hash hash = hash_;
+            size_type added = 0;
+            #pragma omp parallel for reduction(+:added) if(count >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+            for (size_type j = 0; j < count; ++j){
+                const Key key = first[j].first;
+                if (key == empty_key){
+                    continue;
+                }
+                bool inserted;
+                const size_type i = hash_detail::probe_insert(keys,mask,key,empty_key,hash,inserted);
+                if (inserted){
+                    values[i] = first[j].second;
+                    ++added;
+                }
+            }
+            size_ += added;
+        }
+        else{
+            for (; first != last; ++first){
+                if (first->first == empty_key_){
+                    continue;
+                }
+                grow_if_needed(1);
+                bool inserted;
+                const size_type i = hash_detail::probe_insert(keys_.data(),mask_,first->first,empty_key_,hash_,inserted);
+                if (inserted){
+                    values_[i] = first->second;
+                    ++size_;
+                }
+            }
+        }
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    template<typename Container>
+    inline auto device_hash_map<Key,T,Hash,OffloadPolicy>::insert_range(const Container & container)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end())>
+    {
+        insert(container.begin(),container.end());
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline typename device_hash_map<Key,T,Hash,OffloadPolicy>::size_type
+    device_hash_map<Key,T,Hash,OffloadPolicy>::erase(const Key & key)noexcept{
+        size_type hole = index_of(key);
+        if (hole < 0){
+            return 0;
+        }
+        Key * keys = keys_.data();
+        T * values = values_.data();
+        // pull back every later key of the cluster whose home slot isn't cyclically in (hole,j]
+        size_type j = hole;
+        while (true){
+            j = (j + 1) & mask_;
+            if (keys[j] == empty_key_){
+                break;
+            }
+            const size_type home = static_cast<size_type>(hash_(keys[j])) & mask_;
+            const bool stays = (hole < j) ? ((home > hole) && (home <= j)):((home > hole) || (home <= j));
+            if (!stays){
+                keys[hole] = keys[j];
+                values[hole] = values[j];
+                hole = j;
+            }
+        }
+        keys[hole] = empty_key_;
+        --size_;
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+        return 1;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::clear()noexcept{
+        Key * keys = keys_.data();
+        const size_type cap = capacity();
+        const Key empty_key = empty_key_;
+        #pragma omp parallel for simd if(cap >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+        for (size_type i = 0; i < cap; ++i){
+            keys[i] = empty_key;
+        }
+        size_ = 0;
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::reserve(size_type count)noexcept{
+        const size_type new_cap = slots_for(count);
+        if (new_cap > capacity()){
+            rehash(new_cap);
+        }
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::rehash(size_type new_cap)noexcept{
+        size_type cap = slots_for(size_);
+        while (cap < new_cap){
+            cap *= 2;
+        }
+        key_container_type new_keys(cap,empty_key_);
+        mapped_container_type new_values(cap,for_overwrite);
+        const Key * old_keys = keys_.data();
+        const T * old_values = values_.data();
+        Key * keys = new_keys.data();
+        T * values = new_values.data();
+        const size_type old_cap = capacity();
+        const size_type mask = cap - 1;
+        const Key empty_key = empty_key_;
+        const Hash hash = hash_;
+        #pragma omp parallel for if(old_cap >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+        for (size_type j = 0; j < old_cap; ++j){
+            if (old_keys[j] == empty_key){
+                continue;
+            }
+            bool inserted;
+            const size_type i = hash_detail::probe_insert(keys,mask,old_keys[j],empty_key,hash,inserted);
+            values[i] = old_values[j];
+        }
+        using std::swap;
+        swap(keys_,new_keys);
+        swap(values_,new_values);
+        mask_ = mask;
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::recount()noexcept{
+        const Key * keys = keys_.data();
+        const size_type cap = capacity();
+        const Key empty_key = empty_key_;
+        size_type used = 0;
+        #pragma omp parallel for simd reduction(+:used) if(cap >= HOPELESS_DYNARRAY_PARALLEL_THRESHOLD)
+        for (size_type i = 0; i < cap; ++i){
+            used += static_cast<size_type>(keys[i] != empty_key);
+        }
+        size_ = used;
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            keys_.map_data_to_omp_dev();
+            values_.map_data_to_omp_dev();
+        }
+    }
+
+    template<typename Key, typename T, typename Hash, typename OffloadPolicy>
+    inline void device_hash_map<Key,T,Hash,OffloadPolicy>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            keys_.map_data_from_omp_dev();
+            values_.map_data_from_omp_dev();
+            recount();
+        }
+    }
+}
+#endif
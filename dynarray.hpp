@@ -16,31 +16,41 @@
 #include<limits>
 #include<memory_resource>
 #include<iterator>
+#include<algorithm>
+#include<functional>
 #include<omp.h>
 
 #include "allocator.hpp"
+#include "transfer_batch.hpp"
+#include "growth_policy.hpp"
+#include "offload_policy.hpp"
+#include "bulk_construct.hpp"
+#include "simd_kernels.hpp"
 #include "hopeless_macros_n_meta.hpp"
 namespace hopeless
 {
 
-#ifdef HOPELESS_TARGET_OMP_DEV
-    //#pragma omp requires unified_address 
-
+    // OffloadPolicy is host_only or mirrored<dev_no> (offload_policy.hpp), host_only dynarrays have no device buffer
+    // so they can be used next to mirrored ones in an offload build without paying for device allocation or copies
     template<typename T, typename Allocator = hopeless::allocator<T>,
-                        int dev_no =HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>
+                        typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY,
+                        typename GrowthPolicy = HOPELESS_DYNARRAY_DEFAULT_GROWTH_POLICY>
     struct  dynarray;
 
-    template<typename T,typename Allocator,int dev_no>     
+#ifdef HOPELESS_TARGET_OMP_DEV
+    //#pragma omp requires unified_address 
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>     
     auto inline operator <<(std::ostream& stream,
-        const dynarray<T,Allocator,dev_no> & dynamic_array) 
+        const dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> & dynamic_array) 
             -> type_<std::ostream&, 
             decltype(std::cout<<std::declval<T>())>;  
 
-    template<typename T,typename Allocator,int dev_no>
-    void swap(dynarray<T,Allocator,dev_no>& array1, dynarray<T,Allocator,dev_no>& array2)noexcept;
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    void swap(dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& array1, dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& array2)noexcept;
 
-    template<typename T, typename Allocator,int dev_no>
-    struct  dynarray
+    template<typename T, typename Allocator,int dev_no,typename GrowthPolicy>
+    struct  dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>
     {
     public:
         // declare iterators here to use for typedef
@@ -159,12 +169,14 @@ namespace hopeless
 
         // for constructing
 
-        void swap(dynarray<T,Allocator,dev_no>& rhs)noexcept;
+        void swap(dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& rhs)noexcept;
 
         constexpr dynarray()noexcept(noexcept(Allocator()));
         constexpr explicit dynarray(const Allocator& alloc)noexcept;
         dynarray(size_type count, const T& value, const Allocator& alloc = Allocator())noexcept;
         explicit dynarray(size_type count,const Allocator& alloc = Allocator())noexcept;
+        // count elements that are never initialised (not mapped to the device either), for output buffers that will be overwritten
+        dynarray(size_type count,for_overwrite_t,const Allocator& alloc = Allocator())noexcept;
         
         dynarray( const dynarray& other )noexcept(noexcept(Allocator()));
         dynarray( const dynarray& other, const Allocator& alloc )noexcept;
@@ -188,7 +200,7 @@ namespace hopeless
                 const Allocator & alloc = Allocator())noexcept;
         
         template<int dev_no2>
-        dynarray& operator =(const dynarray<T,Allocator,dev_no2> other);
+        dynarray& operator =(const dynarray<T,Allocator,mirrored<dev_no2>,GrowthPolicy> other);
 
         dynarray& operator =(const dynarray & other)noexcept;
 
@@ -251,6 +263,7 @@ namespace hopeless
         // ensure size_ and capacity_ are up to date
         inline void create_dev_buffer()noexcept;
         inline void dev_buffer_reinit()noexcept;
+        inline void zero_dev_buffer()noexcept;
 
 
     // member functions 
@@ -299,6 +312,10 @@ namespace hopeless
     private:
         inline void buffer_resize(const size_type & new_cap)noexcept; 
         inline void buffer_resize_no_map(const size_type & new_cap)noexcept; 
+
+        // offset of the element it refers to if that element is in this array, else -1
+        template<typename It>
+        inline difference_type buffer_offset_of(It & it)const noexcept;
     
         template<typename... Args>
         inline iterator insert_one(const_iterator pos,Args && ...args)noexcept;
@@ -394,6 +411,24 @@ namespace hopeless
         inline void push_back(const_reference value)noexcept;
         inline void push_back(T&& value)noexcept;
 
+        // append a whole range, capacity grows at most once and trivially copyable elements from contiguous memory
+        // are copied with one memcpy (split over threads when large)
+        // the appended tail is the only thing mapped to the device (with HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE)
+        // the range may be (part of) this array itself, e.g. a.append_range(a)
+        template<typename InputIt>
+        inline auto append_range(InputIt first, InputIt last)noexcept
+            -> type_<void,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)
+                >;
+        template<typename Container>
+        inline auto append_range(const Container & container)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end()),
+                decltype(std::declval<Container>().size())>;
+
         template<typename ... Args >
         inline iterator emplace(const_iterator pos, Args&&... args)noexcept;       //both emplace and emplace back do not map changes to device memory
 
@@ -405,8 +440,16 @@ namespace hopeless
         inline void resize(size_type new_size)noexcept;
 
         inline void resize(size_type new_size,const_reference value)noexcept;
+
+        // change size without constructing the new elements (or mapping anything), they hold garbage until written
+        // resize_uninitialized grows capacity through GrowthPolicy, reserve_and_set_size reserves exactly new_size if it has to grow
+        inline void resize_uninitialized(size_type new_size)noexcept;
+        inline void reserve_and_set_size(size_type new_size)noexcept;
         
 
+        // the device copy of the buffer, for is_device_ptr in target regions, valid up to size() after map_data_to_omp_dev()
+        constexpr inline T* device_data()const noexcept;
+
         // wrapper functions for omp_target_memcpy
         inline void memcpy_to_omp_dev(const size_type num_bytes, const size_type offset_bytes = 0)noexcept;        
         inline void memcpy_from_omp_dev(const size_type num_bytes, const size_type offset_bytes = 0)noexcept;       
@@ -417,6 +460,83 @@ namespace hopeless
         inline void map_data_from_omp_dev(const size_type begin, const size_type end)noexcept;
         inline void map_data_to_omp_dev(const size_type begin)noexcept;             
         inline void map_data_from_omp_dev(const size_type begin)noexcept;
+        // same as above but only queue the copy in batch, nothing is copied until batch.submit()
+        inline void map_data_to_omp_dev(transfer_batch<dev_no> & batch)noexcept;
+        inline void map_data_from_omp_dev(transfer_batch<dev_no> & batch)noexcept;
+        inline void map_data_to_omp_dev(transfer_batch<dev_no> & batch, const size_type begin, const size_type end)noexcept;
+        inline void map_data_from_omp_dev(transfer_batch<dev_no> & batch, const size_type begin, const size_type end)noexcept;
+
+        // copy only the elements at the given indices, they are packed into one staging buffer, sent in one transfer 
+        // and scattered on the device in a target loop (gathered on the device for the from variants)
+        // if the indices are dense enough a single range copy covering all of them is done instead
+        template<typename index_container>
+        inline auto sync_indices_to_omp_dev(const index_container & indices)noexcept
+            -> type_<void,
+                decltype(std::declval<index_container>().begin()),
+                decltype(std::declval<index_container>().end()),
+                decltype(std::declval<index_container>().size()),
+                decltype(static_cast<int>(*(std::declval<index_container>().begin())))>;
+        template<typename indices>
+        inline auto sync_indices_to_omp_dev(const indices index_list[], size_type count)noexcept
+            -> type_<void,
+                decltype(static_cast<int>(std::declval<indices>()))>;
+        template<typename index_container>
+        inline auto sync_indices_from_omp_dev(const index_container & indices)noexcept
+            -> type_<void,
+                decltype(std::declval<index_container>().begin()),
+                decltype(std::declval<index_container>().end()),
+                decltype(std::declval<index_container>().size()),
+                decltype(static_cast<int>(*(std::declval<index_container>().begin())))>;
+        template<typename indices>
+        inline auto sync_indices_from_omp_dev(const indices index_list[], size_type count)noexcept
+            -> type_<void,
+                decltype(static_cast<int>(std::declval<indices>()))>;
+
+        // same index semantics as buffered_insert/buffered_erase but the elements are moved on the device in target regions,
+        // for when device_data_buffer_ holds the up to date data, only the indices and inserted values are transferred
+        // the host buffer is only resized, its contents are stale until map_data_from_omp_dev()
+        // if the device side fails (reported on std::cerr) nothing changes, the insert indices are left as they were
+        template<typename Container, typename index_container>      //  the insert indices will be changed afterwards to the ones post insertion
+        inline auto buffered_insert_omp_dev(const Container & insert_elements,index_container & insert_indices)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end()),
+                decltype(std::declval<Container>().size()),
+                decltype(std::declval<index_container>().begin()),
+                decltype(std::declval<index_container>().end()),
+                decltype(std::declval<index_container>().size()),
+                decltype(static_cast<int>(*(std::declval<index_container>().begin())))>;
+        template<typename Container, typename indices>      //  the insert indices will be changed afterwards to the ones post insertion
+        inline auto buffered_insert_omp_dev(const Container & insert_elements,indices insert_indices[], size_type count)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end()),
+                decltype(std::declval<Container>().size()),
+                decltype(static_cast<int>(std::declval<indices>()))>;
+        template<typename index_container>
+        inline auto buffered_erase_omp_dev(const index_container & erase_indices)noexcept
+            -> type_<void,
+                decltype(std::declval<index_container>().begin()),
+                decltype(std::declval<index_container>().end()),
+                decltype(std::declval<index_container>().size()),
+                decltype(static_cast<int>(*(std::declval<index_container>().begin())))>;
+        template<typename indices>
+        inline auto buffered_erase_omp_dev(const indices erase_indices[], size_type count)noexcept
+            -> type_<void,
+                decltype(static_cast<int>(std::declval<indices>()))>;
+
+    private:
+        inline void sync_indices_omp_dev(const size_type index_list[], const size_type count, const bool to_dev)noexcept;
+        // staging for the device buffered insert is [values][insert indices][final indices]
+        static constexpr inline size_type staging_index_offset(const size_type count)noexcept;
+        template<typename Container, typename InputIt>
+        inline void buffered_insert_omp_dev_stage(const Container & insert_elements, InputIt first, const size_type count)noexcept;
+        inline bool buffered_insert_omp_dev_impl(char * staging, const size_type count)noexcept;   // false if nothing was inserted
+        template<typename InputIt>
+        inline void buffered_erase_omp_dev_stage(InputIt first, const size_type count)noexcept;
+        inline void buffered_erase_omp_dev_impl(const size_type erase_indices[], const size_type count)noexcept;
+        template<typename InputIt>
+        inline void sync_indices_omp_dev(InputIt first, const size_type count, const bool to_dev)noexcept;
 
     private:
         // please don't use this elsewhere it is badly written
@@ -447,8 +567,8 @@ namespace hopeless
         T* device_data_buffer_; // the copy on the default offloading device
     };
 
-    template<typename T,typename Allocator,int dev_no>                                                    
-    auto inline operator <<(std::ostream& stream, const dynarray<T,Allocator,dev_no> & dynamic_array) 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>                                                    
+    auto inline operator <<(std::ostream& stream, const dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> & dynamic_array) 
         -> type_<std::ostream&,
         decltype(std::cout<<std::declval<T>())>          
     {
@@ -466,31 +586,36 @@ namespace hopeless
         return stream;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    void swap(dynarray<T,Allocator,dev_no>& array1, dynarray<T,Allocator,dev_no>& array2)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    void swap(dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& array1, dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& array2)noexcept{
         array1.swap(array2);
     }
     
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::operator []
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator []
         (const size_type i)const noexcept{return data_buffer_[i];}
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::operator []
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator []
         (const size_type i)noexcept{return data_buffer_[i];}
 
     #pragma omp declare target device_type(nohost)
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::operator ()
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator ()
         (const size_type i)const noexcept{return device_data_buffer_[i];}
     #pragma omp end declare target
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::operator ()
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator ()
         (const size_type i)noexcept{return device_data_buffer_[i];}
 
-    template<typename T,typename Allocator,int dev_no>
-    void dynarray<T,Allocator,dev_no>::swap(dynarray & rhs)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline T* dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::device_data()const noexcept{
+        return device_data_buffer_;
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::swap(dynarray & rhs)noexcept{
         using std::swap;
         swap(this->data_buffer_,rhs.data_buffer_);
         swap(this->size_,rhs.size_);
@@ -498,8 +623,8 @@ namespace hopeless
         swap(this->device_data_buffer_,rhs.device_data_buffer_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr dynarray<T,Allocator,dev_no>::dynarray()noexcept(noexcept(Allocator()))
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray()noexcept(noexcept(Allocator()))
         :data_buffer_(nullptr),
         size_(0),
         cap_alloc_(0),
@@ -509,8 +634,8 @@ namespace hopeless
             map_data_to_omp_dev();
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr dynarray<T,Allocator,dev_no>::dynarray(const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray(const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(0),
         cap_alloc_(0,alloc),
@@ -520,8 +645,8 @@ namespace hopeless
             map_data_to_omp_dev();
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray(size_type count, const T& value, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray(size_type count, const T& value, const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(count),
         cap_alloc_(count,alloc),
@@ -530,8 +655,8 @@ namespace hopeless
         create_dynarr(std::forward<const T&>(value));        
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray(size_type count,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray(size_type count,const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(count),
         cap_alloc_(count,alloc),
@@ -540,8 +665,18 @@ namespace hopeless
         create_dynarr();
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray( const dynarray& other )noexcept(noexcept(Allocator()))
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray(size_type count,for_overwrite_t,const Allocator& alloc)noexcept
+        :data_buffer_(nullptr),
+        size_(count),
+        cap_alloc_(count,alloc),
+        device_data_buffer_(nullptr)
+    {
+        create_dynarr(for_overwrite);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray( const dynarray& other )noexcept(noexcept(Allocator()))
         :data_buffer_(nullptr),
         size_(other.size()),
         cap_alloc_(other.capacity(),
@@ -551,8 +686,8 @@ namespace hopeless
         create_dynarr(std::forward<const dynarray&>(other));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray( const dynarray& other, const Allocator& alloc )noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray( const dynarray& other, const Allocator& alloc )noexcept
         :data_buffer_(nullptr),
         size_(other.size()),
         cap_alloc_(other.capacity(),alloc),
@@ -561,8 +696,8 @@ namespace hopeless
         create_dynarr(std::forward<const dynarray&>(other));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray( dynarray&& other)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray( dynarray&& other)noexcept
         :data_buffer_(nullptr),
         size_(0),
         cap_alloc_(0,
@@ -574,8 +709,8 @@ namespace hopeless
         swap(*this,std::forward<dynarray&>(other));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray(dynarray&& other, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray(dynarray&& other, const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(other.size()),
         cap_alloc_(other.capacity(),alloc),
@@ -584,8 +719,8 @@ namespace hopeless
         create_dynarr(std::forward<dynarray&&>(other));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::dynarray( std::initializer_list<T> init, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray( std::initializer_list<T> init, const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(init.size()),
         cap_alloc_(init.size(),alloc),
@@ -594,9 +729,9 @@ namespace hopeless
         create_dynarr(std::forward<const std::initializer_list<T>&>(init));
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template< typename InputIt >
-    dynarray<T,Allocator,dev_no>::dynarray( 
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray( 
         type_<InputIt,
             decltype(std::declval<InputIt>().operator->(),
             std::declval<InputIt>().operator*())> first,
@@ -610,20 +745,20 @@ namespace hopeless
         create_dynarr(first,last);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>::~dynarray()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::~dynarray()noexcept{
         omp_target_free(device_data_buffer_, dev_no);
-        if constexpr (!(bool)(std::is_fundamental_v<T>)){
-            for (size_t i=0; i < size_;++i){
+        if constexpr (!is_trivial_destroy_v<allocator_type,T>){
+            for (size_type i=0; i < size_;++i){
                 std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
             }
         }
         std::allocator_traits<allocator_type>::deallocate(cap_alloc_.y(), reinterpret_cast<pointer>(data_buffer_), capacity());
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container,typename ...Last_resort>
-    dynarray<T,Allocator,dev_no>::dynarray(const type_<Container,
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dynarray(const type_<Container,
                             decltype(std::declval<Container>().begin()),
                             decltype(std::declval<Container>().end()),
                             decltype(std::declval<Container>().size())> 
@@ -645,11 +780,11 @@ namespace hopeless
         create_dynarr(std::forward<const Container&>(array));
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<int dev_no2>
-    dynarray<T,Allocator,dev_no>& dynarray<T,Allocator,dev_no>::operator =(const dynarray<T,Allocator,dev_no2> other){
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator =(const dynarray<T,Allocator,mirrored<dev_no2>,GrowthPolicy> other){
         destroy_dealloc();
-        dynarray<T,Allocator,dev_no> temp(other,
+        dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> temp(other,
         std::allocator_traits<allocator_type>::select_on_container_copy_construction(
         other.get_allocator()));
         using std::swap;
@@ -657,15 +792,15 @@ namespace hopeless
         return *this;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>& dynarray<T,Allocator,dev_no>::operator =(const dynarray & other)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator =(const dynarray & other)noexcept{
         if (capacity()>=other.size()){
             destroy_elements();
             size_=other.size();
             construct_elements(other);
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator,dev_no> temp(other,
+            dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> temp(other,
             std::allocator_traits<allocator_type>::select_on_container_copy_construction(
             other.get_allocator()));
             using std::swap;
@@ -674,21 +809,31 @@ namespace hopeless
         return *this;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    dynarray<T,Allocator,dev_no>& dynarray<T,Allocator,dev_no>::operator =(dynarray && other)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator =(dynarray && other)noexcept{
         destroy_dealloc();
         using std::swap;
         swap(*this,std::forward<dynarray&>(other));
         return *this;
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename... Args>
-    inline void dynarray<T,Allocator,dev_no>::create_dynarr(Args && ...args)noexcept{
-        auto temp = std::allocator_traits<allocator_type>::allocate(cap_alloc_.y(),capacity());
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::create_dynarr(Args && ...args)noexcept{
+        // value initialising is just zeroing for these, zeroed memory from the allocator is free until it is touched
+        constexpr bool zeroed = (sizeof...(Args) == 0) && is_zero_initializable_v<T> && has_allocate_zeroed_v<allocator_type>;
+        constexpr bool overwrite = (std::is_same_v<std::decay_t<Args>,for_overwrite_t> || ...);
+        pointer temp;
+        if constexpr (zeroed){
+            temp = cap_alloc_.y().allocate_zeroed(capacity());
+        }else{
+            temp = std::allocator_traits<allocator_type>::allocate(cap_alloc_.y(),capacity());
+        }
         if (temp){
             data_buffer_ = reinterpret_cast<T*>(temp);
-            construct_elements(std::forward<Args>(args)...);
+            if constexpr (!zeroed && !overwrite){
+                construct_elements(std::forward<Args>(args)...);
+            }
         }else{
             if (capacity()>0)
             {
@@ -704,183 +849,229 @@ namespace hopeless
             }
         }
         create_dev_buffer();
-        map_data_to_omp_dev();
+        if constexpr (zeroed){
+            zero_dev_buffer();      // zero on the device rather than copy the zero pages over and touch them all
+        }else if constexpr (!overwrite){
+            map_data_to_omp_dev();
+        }
     }
     
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::construct_elements(const T & value)noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (size_type i = 0; i < size_; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i],value);
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(const T & value)noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,const T&>){
+            bulk_construct_fill(cap_alloc_.y(),data_buffer_,0,size_,value);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (size_type i = 0; i < size_; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i],value);
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
     
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::construct_elements(const size_type begin, const size_type end, const_reference value)noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (difference_type i = begin; i < end; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i], std::forward<const_reference>(value)); it=i;
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(const size_type begin, const size_type end, const_reference value)noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,const T&>){
+            bulk_construct_fill(cap_alloc_.y(),data_buffer_,begin,end,value);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (difference_type i = begin; i < end; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i], std::forward<const_reference>(value)); it=i;
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::construct_elements()noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (size_type i = 0; i < size_; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i]);
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements()noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T>){
+            bulk_construct_default(cap_alloc_.y(),data_buffer_,0,size_);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (size_type i = 0; i < size_; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i]);
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::construct_elements(const size_type begin, const size_type end)noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (difference_type i = begin; i < end; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i]); it=i;
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(const size_type begin, const size_type end)noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T>){
+            bulk_construct_default(cap_alloc_.y(),data_buffer_,begin,end);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (difference_type i = begin; i < end; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i]); it=i;
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator,dev_no>::construct_elements(const Container & container)noexcept 
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(const Container & container)noexcept 
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
             decltype(std::declval<Container>().size())>
     {
-        size_type ptr = 0;
-        difference_type it=-1;
-        try
-        {
-            for (const auto & i : container){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],i);++ptr;
+        if constexpr (is_plain_construct_v<allocator_type,T> && has_contiguous_data_of_v<const Container,T>){
+            bulk_memcpy(data_buffer_,container.data(),static_cast<size_type>(container.size()));
+        }else if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*container.begin())> &&
+                      is_random_access_iterator_v<decltype(container.begin())>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,0,container.begin(),std::distance(container.begin(),container.end()));
+        }else{
+            size_type ptr = 0;
+            difference_type it=-1;
+            try
+            {
+                for (const auto & i : container){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],i);++ptr;
+                }
+            }
+            catch(...)
+            {
+                std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator,dev_no>::construct_elements(Container && container)noexcept 
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(Container && container)noexcept 
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
             decltype(std::declval<Container>().size())>
     {
-        size_type ptr = 0;
-        difference_type it=-1;
-        try
-        {
-            for (auto & i : container){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],std::move(i));++ptr;
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(std::move(*container.begin()))> &&
+                      is_random_access_iterator_v<decltype(container.begin())>){
+            bulk_construct_move(cap_alloc_.y(),data_buffer_,0,container.begin(),std::distance(container.begin(),container.end()));
+        }else{
+            size_type ptr = 0;
+            difference_type it=-1;
+            try
+            {
+                for (auto & i : container){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],std::move(i));++ptr;
+                }
+            }
+            catch(...)
+            {
+                std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator,dev_no>::construct_elements(const size_type begin, const size_type end,
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(const size_type begin, const size_type end,
         const Container & container)noexcept 
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
             decltype(std::declval<Container>().size())>{
-        difference_type it=-1;
-        try
-        {
-            for (difference_type i = begin; i < end; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[i],container[i]);
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*container.begin())> &&
+                      is_random_access_iterator_v<decltype(container.begin())>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,begin,container.begin()+begin,end-begin);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (difference_type i = begin; i < end; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[i],container[i]);
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
     
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template< typename InputIt >
-    inline auto dynarray<T,Allocator,dev_no>::construct_elements(InputIt first, InputIt last)noexcept 
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_elements(InputIt first, InputIt last)noexcept 
         -> type_<void,
             decltype(*std::declval<InputIt>()),
             decltype(++std::declval<InputIt>()),
             decltype(first != last)
             >{
-        size_type ptr = 0;
-        difference_type it=-1;
-        try
-        {
-            for (auto iter=first;iter!=last;++iter){std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],*iter);++ptr;}
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*first)> && is_random_access_iterator_v<InputIt>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,0,first,std::distance(first,last));
+        }else{
+            size_type ptr = 0;
+            difference_type it=-1;
+            try
+            {
+                for (auto iter=first;iter!=last;++iter){std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],*iter);++ptr;}
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
+            }
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::destroy_elements()noexcept{
-        if constexpr (!(bool)(std::is_fundamental_v<T>)){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::destroy_elements()noexcept{
+        // trivially destructible elements have nothing to run, the memory is just reused or freed
+        if constexpr (is_nothrow_alloc_destructible_v<allocator_type,T> && !is_trivial_destroy_v<allocator_type,T>){
+            for (difference_type i=size_-1; i >= 0;--i){
+                std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
+            }
+        }else if constexpr (!is_trivial_destroy_v<allocator_type,T>){
             difference_type it=-1;
             try
             {
-                for (difference_type i=size_; i >= 0;--i){
+                for (difference_type i=size_-1; i >= 0;--i){
                     std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
                     it=i;
                 }
@@ -893,13 +1084,18 @@ namespace hopeless
             }
         }
     }
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::destroy_elements(const size_type new_size,const size_type old_size)noexcept{
-        if constexpr (!(bool)(std::is_fundamental_v<T>)){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::destroy_elements(const size_type new_size,const size_type old_size)noexcept{
+        // trivially destructible elements have nothing to run, the memory is just reused or freed
+        if constexpr (is_nothrow_alloc_destructible_v<allocator_type,T> && !is_trivial_destroy_v<allocator_type,T>){
+            for (difference_type i=old_size-1; i >= new_size;--i){
+                std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
+            }
+        }else if constexpr (!is_trivial_destroy_v<allocator_type,T>){
             difference_type it=-1;
             try
             {
-                for (difference_type i=old_size; i >= new_size;--i){
+                for (difference_type i=old_size-1; i >= new_size;--i){
                     std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
                     it=i;
                 }
@@ -914,8 +1110,8 @@ namespace hopeless
         size_ = new_size;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::destroy_dealloc()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::destroy_dealloc()noexcept{
         omp_target_free(device_data_buffer_, dev_no);
         device_data_buffer_ = nullptr;
         destroy_elements();
@@ -925,8 +1121,8 @@ namespace hopeless
         data_buffer_ = nullptr;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::create_dev_buffer()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::create_dev_buffer()noexcept{
         T * temp = (T *)  omp_target_alloc(capacity() * sizeof(*data_buffer_), dev_no);
         if (temp){
             device_data_buffer_ = temp;
@@ -936,8 +1132,8 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::dev_buffer_reinit()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::dev_buffer_reinit()noexcept{
         T * temp = (T *)  omp_target_alloc(capacity() * sizeof(*data_buffer_), dev_no);
         if (temp){
             omp_target_free(device_data_buffer_,dev_no);
@@ -949,23 +1145,36 @@ namespace hopeless
     }
 
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::assign(size_type count, const_reference value)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::zero_dev_buffer()noexcept{
+        T * dev_buf = device_data_buffer_;
+        const size_type n = size();
+        if (!dev_buf){
+            return;
+        }
+        #pragma omp target teams distribute parallel for is_device_ptr(dev_buf) device(dev_no)
+        for (size_type i = 0; i < n; ++i){
+            dev_buf[i] = T();
+        }
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::assign(size_type count, const_reference value)noexcept{
         if (capacity()>=count){
             destroy_elements();
             size_=count;
             construct_elements(std::forward<const_reference>(value));
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator,dev_no> temp(count,std::forward<const_reference>(value),get_allocator());
+            dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> temp(count,std::forward<const_reference>(value),get_allocator());
             using std::swap;
             swap(*this,temp);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename InputIt >
-    inline void dynarray<T,Allocator,dev_no>::assign( 
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::assign( 
             type_<InputIt,
                 decltype(std::declval<InputIt>().operator->(),
                 std::declval<InputIt>().operator*())> first,
@@ -977,33 +1186,33 @@ namespace hopeless
             construct_elements(std::forward<InputIt>(first),std::forward<InputIt>(last));
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator,dev_no> temp(first,last,get_allocator());
+            dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> temp(first,last,get_allocator());
             using std::swap;
             swap(*this,temp);
         }
     } 
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::assign(std::initializer_list<T> ilist)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::assign(std::initializer_list<T> ilist)noexcept{
         if (capacity()>=ilist.size()){
             destroy_elements();
             size_=ilist.size();
             construct_elements(std::forward<std::initializer_list<T>>(ilist));
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator,dev_no> temp(std::forward<std::initializer_list<T>>(ilist),get_allocator());
+            dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> temp(std::forward<std::initializer_list<T>>(ilist),get_allocator());
             using std::swap;
             swap(*this,temp);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::allocator_type dynarray<T,Allocator,dev_no>::get_allocator()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::allocator_type dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::get_allocator()const noexcept{
         return cap_alloc_.y();
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::at(size_type pos){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::at(size_type pos){
         if ((pos>=size_) || (pos<0)){
             std::cerr<<"Error Dynarray indexing with at() out of bounds"
             throw std::out_of_range("Bad pos passed to at()");
@@ -1013,8 +1222,8 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reference dynarray<T,Allocator,dev_no>::at(size_type pos)const{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::at(size_type pos)const{
         if ((pos>=size_) || (pos<0)){
             std::cerr<<"Error Dynarray indexing with at() out of bounds"
             throw std::out_of_range("Bad pos passed to at()");
@@ -1024,162 +1233,157 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::front(){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::front(){
         return data_buffer_[0];
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reference dynarray<T,Allocator,dev_no>::front()const{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::front()const{
         return data_buffer_[0];
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::back(){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::back(){
         return data_buffer_[size_];
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reference dynarray<T,Allocator,dev_no>::back()const{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::back()const{
         return data_buffer_[size_];
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline T* dynarray<T,Allocator,dev_no>::data()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline T* dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::data()noexcept{
         return data_buffer_;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline const T* dynarray<T,Allocator,dev_no>::data()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline const T* dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::data()const noexcept{
         return data_buffer_;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline T* dynarray<T,Allocator,dev_no>::data_dev()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline T* dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::data_dev()noexcept{
         return device_data_buffer_;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::begin()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::begin()noexcept{
         return iterator(data_buffer_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_iterator dynarray<T,Allocator,dev_no>::begin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::begin()const noexcept{
         return const_iterator(data_buffer_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_iterator dynarray<T,Allocator,dev_no>::cbegin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::cbegin()const noexcept{
         return const_iterator(data_buffer_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::end()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::end()noexcept{
         return iterator(data_buffer_+size_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_iterator dynarray<T,Allocator,dev_no>::end()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::end()const noexcept{
         return const_iterator(data_buffer_+size_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_iterator dynarray<T,Allocator,dev_no>::cend()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::cend()const noexcept{
         return const_iterator(data_buffer_+size_);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reverse_iterator dynarray<T,Allocator,dev_no>::rbegin()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reverse_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rbegin()noexcept{
         return reverse_iterator(iterator(data_buffer_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reverse_iterator dynarray<T,Allocator,dev_no>::rbegin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rbegin()const noexcept{
         return const_reverse_iterator(const_iterator(data_buffer_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reverse_iterator dynarray<T,Allocator,dev_no>::crbegin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::crbegin()const noexcept{
         return const_reverse_iterator(const_iterator(data_buffer_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::reverse_iterator dynarray<T,Allocator,dev_no>::rend()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reverse_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rend()noexcept{
         return reverse_iterator(iterator(data_buffer_+size_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reverse_iterator dynarray<T,Allocator,dev_no>::rend()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rend()const noexcept{
         return const_reverse_iterator(const_iterator(data_buffer_+size_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::const_reverse_iterator dynarray<T,Allocator,dev_no>::crend()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::crend()const noexcept{
         return const_reverse_iterator(const_iterator(data_buffer_+size_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline bool dynarray<T,Allocator,dev_no>::empty()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline bool dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::empty()const noexcept{
         return (size_ == 0);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::size_type dynarray<T,Allocator,dev_no>::size()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size_type dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size()const noexcept{
         return size_;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::size_type dynarray<T,Allocator,dev_no>::max_size()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size_type dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::max_size()const noexcept{
         return (std::numeric_limits<size_type>::max()/sizeof(T))  -1;       
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::reserve(size_type new_cap)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reserve(size_type new_cap)noexcept{
         if (new_cap > capacity())
         {
             buffer_resize(new_cap);
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::grow_reserve_no_map(size_type new_cap)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::grow_reserve_no_map(size_type new_cap)noexcept{
         if (new_cap > capacity()){
-            const size_type s = (capacity() * HOPELESS_DYNARRAY_CAPACITY_GROWTH_RATE);
-            const bool sufficient_growth = s>new_cap;
-            new_cap = sufficient_growth * s + static_cast<size_type>(!sufficient_growth) * new_cap;         //will have to profile this versus using if else or ternary
-            buffer_resize_no_map(new_cap);
+            buffer_resize_no_map(GrowthPolicy::next_capacity(capacity(),new_cap,sizeof(T)));
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::buffer_resize(const size_type & new_cap)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffer_resize(const size_type & new_cap)noexcept{
         buffer_resize_no_map(new_cap);
     #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
         map_data_to_omp_dev();
     #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::buffer_resize_no_map(const size_type & new_cap)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffer_resize_no_map(const size_type & new_cap)noexcept{
         auto temp = reinterpret_cast<T*>(std::allocator_traits<allocator_type>::allocate(cap_alloc_.y(),new_cap));
         if (temp){
-            try{
-                for (size_type i = 0; i < size_;++i){
-                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&temp[i],std::move(data_buffer_[i]));
+            try_or_report<is_nothrow_relocatable_v<allocator_type,T>>([&]{
+                if constexpr (is_plain_construct_v<allocator_type,T>){
+                    bulk_memcpy(temp,data_buffer_,size_);
+                }else{
+                    for (size_type i = 0; i < size_;++i){
+                        std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&temp[i],std::move(data_buffer_[i]));
+                    }
                 }
                 destroy_elements();
                 std::allocator_traits<allocator_type>::deallocate(cap_alloc_.y(), reinterpret_cast<pointer>(data_buffer_), capacity());
                 data_buffer_ = temp;
                 cap_alloc_.x() = new_cap;
                 dev_buffer_reinit();
-            }
-            catch(...)
-            {
-                std::cout << "Dynarray failed to resize" << '\n';
-                std::exception_ptr exception=std::current_exception();
-                cout_exception(exception);
-            }
+            },"Dynarray failed to resize");
         }else{
             if (new_cap>0)
             {
@@ -1193,13 +1397,13 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>  
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>  
     template<typename... Args>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::insert_one(const_iterator pos,Args && ...args)noexcept{
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert_one(const_iterator pos,Args && ...args)noexcept{
         const difference_type offset = pos - begin();                                   
         grow_reserve_no_map(size() + 1);    //invalidates iterators
         pos = begin() + offset;
-        try{
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T> && std::is_nothrow_constructible_v<T,Args&&...>>([&]{
             if (pos != end()){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+size(),std::move(data_buffer_[size()-1]));
                 size_+=1;
@@ -1214,32 +1418,23 @@ namespace hopeless
         #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
             map_data_to_omp_dev(offset,size());
         #endif
-        }
-        catch(...){
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator,int dev_no>  
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>  
     template<typename... Args>
-    inline void dynarray<T,Allocator,dev_no>::append(Args && ...args)noexcept{
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::append(Args && ...args)noexcept{
         grow_reserve_no_map(size() + 1);    //invalidates iterators
-        try
-        {
+        try_or_report<is_nothrow_alloc_constructible_v<allocator_type,T,Args&&...>>([&]{
             std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+size(),std::forward<Args>(args)...);
             size_+=1;
-        }catch(...){
-            std::cerr << "Hopeless dynarray failed to construct element" << '\n';
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        },"Hopeless dynarray failed to construct element");
     }
 
-    template<typename T,typename Allocator,int dev_no>  
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>  
     template<typename... Args>
-    inline void dynarray<T,Allocator,dev_no>::resize_arr(size_type & new_size,Args && ... args)noexcept{
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize_arr(size_type & new_size,Args && ... args)noexcept{
         grow_reserve_no_map(new_size);
         if (new_size < size()){
             destroy_elements(new_size,size());
@@ -1249,9 +1444,9 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<typename index_container>
-    inline void dynarray<T,Allocator,dev_no>::setup_buffered_insert(index_container & insert_indices, size_type count){
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::setup_buffered_insert(index_container & insert_indices, size_type count){
         const size_type old_size = size();
         typedef typename std::allocator_traits<allocator_type>::rebind_alloc<size_type> s_allocator_type;
         s_allocator_type s_alloc(cap_alloc_.y());
@@ -1277,9 +1472,9 @@ namespace hopeless
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(arr_indx),old_size);
     }
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<typename indices>
-    inline void dynarray<T,Allocator,dev_no>::setup_buffered_insert(indices insert_indices[], size_type count){
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::setup_buffered_insert(indices insert_indices[], size_type count){
         const size_type old_size = size();
         typedef typename std::allocator_traits<allocator_type>::rebind_alloc<size_type> s_allocator_type;
         s_allocator_type s_alloc(cap_alloc_.y());
@@ -1306,37 +1501,36 @@ namespace hopeless
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(arr_indx),old_size);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    constexpr inline dynarray<T,Allocator,dev_no>::size_type dynarray<T,Allocator,dev_no>::capacity()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size_type dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::capacity()const noexcept{
         return cap_alloc_.x();       
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::shrink_to_fit()noexcept{
-        buffer_resize(size(),true);
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::shrink_to_fit()noexcept{
+        buffer_resize(size());
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::clear()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::clear()noexcept{
         destroy_elements(0,size());
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::insert(const_iterator pos, const value_type& value)noexcept{    
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert(const_iterator pos, const value_type& value)noexcept{    
         return insert_one(pos,std::forward<const T&>(value));;
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::insert(const_iterator pos, T&& value)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert(const_iterator pos, T&& value)noexcept{
         return insert_one(pos,std::forward<const T&>(value));;
     }
-    template<typename T,typename Allocator,int dev_no>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::insert(const_iterator pos, size_type count, const T& value)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert(const_iterator pos, size_type count, const T& value)noexcept{
         const difference_type offset = pos - begin();   // using this to keep track (bookeep in case of iterator invalidation)                                 
         grow_reserve_no_map(size() + count);        // may invalidate iterators
         pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T>>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;      // how many elements at the end of the dynarray to move construct
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){                 // everything from the last element down to the number of elements move construct
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -1357,24 +1551,20 @@ namespace hopeless
         #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
             map_data_to_omp_dev(offset,size());
         #endif
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename InputIt>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::insert(const_iterator pos, InputIt first, InputIt last)noexcept{
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)noexcept{
         const difference_type offset = pos - begin();                   // using this to keep track (bookeep in case of iterator invalidation)
         const difference_type count = std::distance(first,last);        // total number of elements to construct                                
         grow_reserve_no_map(size() + count);        // may invalidate iterators
         pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T> &&
+            is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*first)> && std::is_nothrow_assignable_v<T&,decltype(*first)> &&
+            noexcept(--last) && noexcept(++first)>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;      
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -1395,23 +1585,17 @@ namespace hopeless
         #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
             map_data_to_omp_dev(offset,size());
         #endif
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::insert(const_iterator pos, std::initializer_list<T> ilist)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert(const_iterator pos, std::initializer_list<T> ilist)noexcept{
         const difference_type offset = pos - begin();                   // using this to keep track (bookeep in case of iterator invalidation)
         const difference_type count = ilist.size();        // total number of elements to construct
         grow_reserve_no_map(size() + count);        // may invalidate iterators
         pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T>>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;      
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -1432,18 +1616,13 @@ namespace hopeless
         #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
             map_data_to_omp_dev(offset,size());
         #endif
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator,dev_no>::insert(const_iterator pos,Container && container)noexcept
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert(const_iterator pos,Container && container)noexcept
     -> type_<iterator,
         decltype(std::declval<Container>().begin()),
         decltype(std::declval<Container>().end()),
@@ -1456,8 +1635,9 @@ namespace hopeless
             grow_reserve_no_map(size() + count);        // invalidates iterators
             pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
         }
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T> &&
+            is_nothrow_alloc_constructible_v<allocator_type,T,decltype(std::move(*container.begin()))> &&
+            std::is_nothrow_assignable_v<T&,decltype(*container.begin())> && noexcept(container.end()-1)>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;   
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -1478,18 +1658,13 @@ namespace hopeless
         #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
             map_data_to_omp_dev(offset,size());
         #endif
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container, typename index_container>
-    inline auto dynarray<T,Allocator,dev_no>::buffered_insert(const Container & insert_elements,index_container & insert_indices)
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert(const Container & insert_elements,index_container & insert_indices)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1514,9 +1689,9 @@ namespace hopeless
         #endif
     }
     
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container, typename indices>
-    inline auto dynarray<T,Allocator,dev_no>::buffered_insert(const Container & insert_elements,indices insert_indices[], size_type count)
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert(const Container & insert_elements,indices insert_indices[], size_type count)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1534,9 +1709,9 @@ namespace hopeless
         #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container, typename index_container>
-    inline auto dynarray<T,Allocator,dev_no>::buffered_insert(Container && insert_elements,index_container & insert_indices)
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert(Container && insert_elements,index_container & insert_indices)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1561,9 +1736,9 @@ namespace hopeless
         #endif
     }
     
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename Container, typename indices>
-    inline auto dynarray<T,Allocator,dev_no>::buffered_insert(Container && insert_elements,indices insert_indices[], size_type count)
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert(Container && insert_elements,indices insert_indices[], size_type count)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1582,9 +1757,9 @@ namespace hopeless
     }
 
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename index_container>
-    inline auto dynarray<T,Allocator,dev_no>::buffered_erase(index_container & erase_indices)
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase(index_container & erase_indices)
         -> type_<void,
             decltype(std::declval<index_container>().begin()),
             decltype(std::declval<index_container>().end()),
@@ -1620,9 +1795,9 @@ namespace hopeless
         #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
     template<typename indices>
-    inline auto dynarray<T,Allocator,dev_no>::buffered_erase(indices erase_indices[], size_type count)
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase(indices erase_indices[], size_type count)
         -> type_<void,
             decltype(static_cast<int>(std::declval<indices>()))>
     {
@@ -1654,8 +1829,8 @@ namespace hopeless
         #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::erase(const_iterator pos)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::erase(const_iterator pos)noexcept{
         const difference_type offset = pos - begin();
         for (difference_type i = offset; i < size_-1; ++i){
             data_buffer_[i] = std::move(data_buffer_[i+1]);
@@ -1668,8 +1843,8 @@ namespace hopeless
         return iterator(data_buffer_+offset);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::erase(const_iterator first, const_iterator last)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::erase(const_iterator first, const_iterator last)noexcept{
         const difference_type offset = first - begin();
         const difference_type count = last - first;
         for (difference_type i = offset; i < size_ - count; ++i){
@@ -1682,50 +1857,143 @@ namespace hopeless
         return iterator(data_buffer_+offset);
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::push_back(const_reference value)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::push_back(const_reference value)noexcept{
         append(std::forward<const T&>(value));
     #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
         map_data_to_omp_dev(size()-1,size());
     #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::push_back(T&& value)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::push_back(T&& value)noexcept{
         append(std::forward<T&&>(value));
     #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
         map_data_to_omp_dev(size()-1,size());
     #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    template<typename... Args>
-    inline dynarray<T,Allocator,dev_no>::iterator dynarray<T,Allocator,dev_no>::emplace(const_iterator pos, Args&&...args)noexcept{
-        return insert_one(pos,std::forward<Args>(args)...);
-    }
-
-    template<typename T,typename Allocator,int dev_no>
-    template<typename... Args>
-    inline dynarray<T,Allocator,dev_no>::reference dynarray<T,Allocator,dev_no>::emplace_back(Args && ...args)noexcept{
-        append(std::forward<Args>(args)...);
-        return data_buffer_[size()-1];
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename It>
+    inline typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::difference_type
+    dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffer_offset_of(It & it)const noexcept{
+        if constexpr (std::is_reference_v<decltype(*it)> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(*it)>>,T>){
+            auto && referred = *it;     // move iterators give an rvalue reference
+            const T * element = std::addressof(referred);
+            if (std::less_equal<const T*>()(data_buffer_,element) && std::less<const T*>()(element,data_buffer_ + size_)){
+                return element - data_buffer_;
+            }
+        }
+        return -1;
     }
 
-    template<typename T, typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::pop_back()noexcept{
-        // will crash and burn if the dynarray is empty obviously
-        try{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename InputIt>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::append_range(InputIt first, InputIt last)noexcept
+        -> type_<void,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)
+            >
+    {
+        const difference_type count = std::distance(first,last);
+        if (count <= 0){
+            return;
+        }
+        const size_type old_size = size();
+        // the range may be part of this array, growing frees the buffer it points into before it is read
+        const difference_type alias_offset = (old_size + count > capacity()) ? buffer_offset_of(first):-1;
+        constexpr bool pointer_to_T = std::is_pointer_v<InputIt> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>,T>;
+        if constexpr (!pointer_to_T){
+            if (alias_offset >= 0){
+                // only a pointer can be re-based onto the new buffer, copy the elements out first
+                dynarray<T,Allocator,host_only,GrowthPolicy> temp;
+                temp.append_range(first,last);
+                if (temp.size() != count){
+                    return;
+                }
+                if constexpr (std::is_trivially_copyable_v<T>){
+                    append_range(temp.data(),temp.data() + count);
+                }else{
+                    append_range(std::make_move_iterator(temp.data()),std::make_move_iterator(temp.data() + count));
+                }
+                return;
+            }
+        }
+        grow_reserve_no_map(old_size + count);
+        if (capacity() < old_size + count){
+            return;
+        }
+        if constexpr (pointer_to_T){
+            if (alias_offset >= 0){
+                first = data_buffer_ + alias_offset;
+                last = first + count;
+            }
+        }
+        if constexpr (pointer_to_T && std::is_trivially_copyable_v<T>){
+            bulk_memcpy(data_buffer_ + old_size,first,count);
+        }else if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*first)> && is_random_access_iterator_v<InputIt>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,old_size,first,count);
+        }else{
+            difference_type it = old_size;
+            try{
+                for (auto iter = first; iter != last; ++iter){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_ + it,*iter);
+                    ++it;
+                }
+            }catch(...){
+                size_ = it;
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
+                return;
+            }
+        }
+        size_ = old_size + count;
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev(old_size,size());
+    #endif
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename Container>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::append_range(const Container & container)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end()),
+            decltype(std::declval<Container>().size())>
+    {
+        if constexpr (has_contiguous_data_v<const Container>){
+            append_range(container.data(),container.data() + std::distance(container.begin(),container.end()));
+        }else{
+            append_range(container.begin(),container.end());
+        }
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename... Args>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::emplace(const_iterator pos, Args&&...args)noexcept{
+        return insert_one(pos,std::forward<Args>(args)...);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename... Args>
+    inline dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::emplace_back(Args && ...args)noexcept{
+        append(std::forward<Args>(args)...);
+        return data_buffer_[size()-1];
+    }
+
+    template<typename T, typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::pop_back()noexcept{
+        // will crash and burn if the dynarray is empty obviously
+        try_or_report<is_nothrow_alloc_destructible_v<allocator_type,T>>([&]{
             std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[size()-1]);
             --size_;
-        }catch(...){
-            std::cerr << "Failed to call pop_back on hopeless dynarray" << '\n';
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        },"Failed to call pop_back on hopeless dynarray");
     }
 
-    template<typename T, typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::resize(size_type new_size)noexcept{
+    template<typename T, typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize(size_type new_size)noexcept{
         const size_type old_size = size();
         resize_arr(new_size);
     #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
@@ -1733,8 +2001,8 @@ namespace hopeless
     #endif
     }
 
-    template<typename T, typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::resize(size_type new_size, const_reference value)noexcept{
+    template<typename T, typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize(size_type new_size, const_reference value)noexcept{
         const size_type old_size = size();
         resize_arr(new_size,std::forward<const_reference>(value));
     #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
@@ -1742,8 +2010,28 @@ namespace hopeless
     #endif
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::memcpy_to_omp_dev(const size_type no_bytes, const size_type offset_bytes)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize_uninitialized(size_type new_size)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "resize_uninitialized needs an implicit lifetime type");
+        grow_reserve_no_map(new_size);
+        if (capacity() >= new_size){
+            size_ = new_size;
+        }
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reserve_and_set_size(size_type new_size)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "reserve_and_set_size needs an implicit lifetime type");
+        if (new_size > capacity()){
+            buffer_resize_no_map(new_size);
+        }
+        if (capacity() >= new_size){
+            size_ = new_size;
+        }
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::memcpy_to_omp_dev(const size_type no_bytes, const size_type offset_bytes)noexcept{
         try{
             bool fail = omp_target_memcpy(device_data_buffer_,data_buffer_,no_bytes,offset_bytes,offset_bytes,dev_no,omp_get_initial_device());
             if(no_bytes && fail){
@@ -1756,8 +2044,8 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::memcpy_from_omp_dev(const size_type no_bytes, const size_type offset_bytes)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::memcpy_from_omp_dev(const size_type no_bytes, const size_type offset_bytes)noexcept{
         try{
             bool fail = omp_target_memcpy(data_buffer_,device_data_buffer_,no_bytes,offset_bytes,offset_bytes,omp_get_initial_device(),dev_no);
             if(no_bytes && fail){
@@ -1770,51 +2058,439 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::map_data_to_omp_dev()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_to_omp_dev()noexcept{
         memcpy_to_omp_dev(size_ * sizeof(*data_buffer_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::map_data_from_omp_dev()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_from_omp_dev()noexcept{
         memcpy_from_omp_dev(size_ * sizeof(*data_buffer_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::map_data_to_omp_dev(const size_type begin, const size_type end)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_to_omp_dev(const size_type begin, const size_type end)noexcept{
         memcpy_to_omp_dev((end-begin) * sizeof(*data_buffer_), begin * sizeof(*data_buffer_));
     }
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::map_data_from_omp_dev(const size_type begin, const size_type end)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_from_omp_dev(const size_type begin, const size_type end)noexcept{
         memcpy_from_omp_dev((end-begin) * sizeof(*data_buffer_), begin * sizeof(*data_buffer_));
     }
     
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::map_data_to_omp_dev(const size_type begin)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_to_omp_dev(const size_type begin)noexcept{
         memcpy_to_omp_dev((size_-begin) * sizeof(*data_buffer_), begin * sizeof(*data_buffer_));
     }
 
 
-    template<typename T,typename Allocator,int dev_no>
-    inline void dynarray<T,Allocator,dev_no>::map_data_from_omp_dev(const size_type begin)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_from_omp_dev(const size_type begin)noexcept{
         memcpy_from_omp_dev((size_-begin) * sizeof(*data_buffer_), begin * sizeof(*data_buffer_));
     }
 
-#else
-    template<typename T, typename Allocator = hopeless::allocator<T>>struct  dynarray;
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_to_omp_dev(transfer_batch<dev_no> & batch)noexcept{
+        batch.add(data_buffer_,device_data_buffer_,size_ * sizeof(*data_buffer_),0,transfer_direction::to_dev);
+    }
 
-    template<typename T,typename Allocator>     
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_from_omp_dev(transfer_batch<dev_no> & batch)noexcept{
+        batch.add(data_buffer_,device_data_buffer_,size_ * sizeof(*data_buffer_),0,transfer_direction::from_dev);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_to_omp_dev(transfer_batch<dev_no> & batch, const size_type begin, const size_type end)noexcept{
+        batch.add(data_buffer_,device_data_buffer_,(end-begin) * sizeof(*data_buffer_),begin * sizeof(*data_buffer_),transfer_direction::to_dev);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_data_from_omp_dev(transfer_batch<dev_no> & batch, const size_type begin, const size_type end)noexcept{
+        batch.add(data_buffer_,device_data_buffer_,(end-begin) * sizeof(*data_buffer_),begin * sizeof(*data_buffer_),transfer_direction::from_dev);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename index_container>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::sync_indices_to_omp_dev(const index_container & indices)noexcept
+        -> type_<void,
+            decltype(std::declval<index_container>().begin()),
+            decltype(std::declval<index_container>().end()),
+            decltype(std::declval<index_container>().size()),
+            decltype(static_cast<int>(*(std::declval<index_container>().begin())))>
+    {
+        sync_indices_omp_dev(indices.begin(),std::distance(indices.begin(),indices.end()),true);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename indices>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::sync_indices_to_omp_dev(const indices index_list[], size_type count)noexcept
+        -> type_<void,
+            decltype(static_cast<int>(std::declval<indices>()))>
+    {
+        sync_indices_omp_dev(index_list,count,true);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename index_container>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::sync_indices_from_omp_dev(const index_container & indices)noexcept
+        -> type_<void,
+            decltype(std::declval<index_container>().begin()),
+            decltype(std::declval<index_container>().end()),
+            decltype(std::declval<index_container>().size()),
+            decltype(static_cast<int>(*(std::declval<index_container>().begin())))>
+    {
+        sync_indices_omp_dev(indices.begin(),std::distance(indices.begin(),indices.end()),false);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename indices>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::sync_indices_from_omp_dev(const indices index_list[], size_type count)noexcept
+        -> type_<void,
+            decltype(static_cast<int>(std::declval<indices>()))>
+    {
+        sync_indices_omp_dev(index_list,count,false);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename Container, typename index_container>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert_omp_dev(const Container & insert_elements,index_container & insert_indices)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end()),
+            decltype(std::declval<Container>().size()),
+            decltype(std::declval<index_container>().begin()),
+            decltype(std::declval<index_container>().end()),
+            decltype(std::declval<index_container>().size()),
+            decltype(static_cast<int>(*(std::declval<index_container>().begin())))>
+    {
+        size_type count = std::distance(insert_elements.begin(),insert_elements.end());
+        count = (count <=  std::distance(insert_indices.begin(),insert_indices.end())) ? count:std::distance(insert_indices.begin(),insert_indices.end());
+        buffered_insert_omp_dev_stage(insert_elements,insert_indices.begin(),count);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename Container, typename indices>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert_omp_dev(const Container & insert_elements,indices insert_indices[], size_type count)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end()),
+            decltype(std::declval<Container>().size()),
+            decltype(static_cast<int>(std::declval<indices>()))>
+    {
+        buffered_insert_omp_dev_stage(insert_elements,insert_indices,count);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename index_container>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase_omp_dev(const index_container & erase_indices)noexcept
+        -> type_<void,
+            decltype(std::declval<index_container>().begin()),
+            decltype(std::declval<index_container>().end()),
+            decltype(std::declval<index_container>().size()),
+            decltype(static_cast<int>(*(std::declval<index_container>().begin())))>
+    {
+        buffered_erase_omp_dev_stage(erase_indices.begin(),std::distance(erase_indices.begin(),erase_indices.end()));
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename indices>
+    inline auto dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase_omp_dev(const indices erase_indices[], size_type count)noexcept
+        -> type_<void,
+            decltype(static_cast<int>(std::declval<indices>()))>
+    {
+        buffered_erase_omp_dev_stage(erase_indices,count);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    constexpr inline typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size_type dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::staging_index_offset(const size_type count)noexcept{
+        return ((count * sizeof(T) + alignof(size_type) - 1)/alignof(size_type)) * alignof(size_type);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename Container, typename InputIt>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert_omp_dev_stage(const Container & insert_elements, InputIt first, const size_type count)noexcept{
+        if (count <= 0){
+            return;
+        }
+        const size_type idx_offset = staging_index_offset(count);
+        const size_type staging_bytes = idx_offset + 2 * count * sizeof(size_type);
+        typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<char> c_allocator_type;
+        c_allocator_type c_alloc(cap_alloc_.y());
+        char * staging = reinterpret_cast<char*>(std::allocator_traits<c_allocator_type>::allocate(c_alloc,staging_bytes));
+        T * vals = reinterpret_cast<T*>(staging);
+        size_type * idx = reinterpret_cast<size_type*>(staging + idx_offset);
+        // elements that live on the device are trivially copyable so the staged copies are never destroyed
+        auto elit = insert_elements.begin();
+        InputIt it = first;
+        for (size_type i = 0; i < count; ++i){
+            std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),vals+i,*elit);
+            idx[i] = static_cast<size_type>(*it);
+            ++elit;
+            ++it;
+        }
+        if (buffered_insert_omp_dev_impl(staging,count)){
+            const size_type * final_idx = idx + count;
+            for (size_type i = 0; i < count; ++i){
+                *first = final_idx[i];
+                ++first;
+            }
+        }
+        std::allocator_traits<c_allocator_type>::deallocate(c_alloc,reinterpret_cast<typename c_allocator_type::pointer>(staging),staging_bytes);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline bool dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert_omp_dev_impl(char * staging, const size_type count)noexcept{
+        const size_type old_size = size();
+        size_type new_size = old_size + count;
+        const size_type idx_offset = staging_index_offset(count);
+        const size_type staging_bytes = idx_offset + 2 * count * sizeof(size_type);
+        size_type * idx = reinterpret_cast<size_type*>(staging + idx_offset);
+        size_type * final_idx = idx + count;
+        // positions of the inserted elements after all the inserts, same as setup_buffered_insert
+        for (size_type i = 0; i < count; ++i){
+            final_idx[i] = idx[i];
+        }
+        for (size_type i = 0; i < count; ++i){
+            for (size_type j = 0; j < i; ++j){
+                final_idx[j] += (final_idx[j]>=final_idx[i]);
+            }
+        }
+        char * dev_staging = (char *) omp_target_alloc(staging_bytes, dev_no);
+        if (!dev_staging){
+            std::cerr<<"ERROR dynarray failed to allocate staging memory on offload device, insert not done"<<std::endl;
+            return false;
+        }
+        bool done = false;
+        try{
+            bool fail = omp_target_memcpy(dev_staging,staging,staging_bytes,0,0,dev_no,omp_get_initial_device());
+            if(fail){
+                throw std::runtime_error("ERROR dynarray failed to copy data to device memory");
+            }
+            // detach the device buffer so growing the host buffer doesn't free it, 
+            // if capacity grows dev_buffer_reinit hands us a buffer of the new capacity to permute into
+            T * old_dev = device_data_buffer_;
+            device_data_buffer_ = nullptr;
+            resize_arr(new_size);
+            if (!device_data_buffer_){
+                create_dev_buffer();
+            }
+            T * new_dev = device_data_buffer_;
+            if (!new_dev){
+                device_data_buffer_ = old_dev;
+                size_type restore_size = old_size;
+                resize_arr(restore_size);
+                throw std::runtime_error("ERROR dynarray failed to allocate memory on offload device, insert not done");
+            }
+            #pragma omp target teams distribute parallel for is_device_ptr(old_dev,new_dev,dev_staging) device(dev_no)
+            for (size_type i = 0; i < old_size; ++i){
+                const size_type * dev_idx = reinterpret_cast<const size_type*>(dev_staging + idx_offset);
+                size_type pos = i;
+                for (size_type j = 0; j < count; ++j){
+                    pos += (pos >= dev_idx[j]);
+                }
+                new_dev[pos] = old_dev[i];
+            }
+            #pragma omp target teams distribute parallel for is_device_ptr(new_dev,dev_staging) device(dev_no)
+            for (size_type i = 0; i < count; ++i){
+                const T * dev_vals = reinterpret_cast<const T*>(dev_staging);
+                const size_type * dev_final_idx = reinterpret_cast<const size_type*>(dev_staging + idx_offset) + count;
+                new_dev[dev_final_idx[i]] = dev_vals[i];
+            }
+            omp_target_free(old_dev,dev_no);
+            done = true;
+        }catch(std::runtime_error& e){
+           std::cerr<<e.what()<<std::endl;
+        }catch(...){
+            std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+        }
+        omp_target_free(dev_staging,dev_no);
+        return done;
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename InputIt>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase_omp_dev_stage(InputIt first, const size_type count)noexcept{
+        if (count <= 0){
+            return;
+        }
+        typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<size_type> s_allocator_type;
+        s_allocator_type s_alloc(cap_alloc_.y());
+        size_type * temp_indices = reinterpret_cast<size_type*>(std::allocator_traits<s_allocator_type>::allocate(s_alloc,count));
+        for (size_type i = 0; i < count; ++i){
+            temp_indices[i] = static_cast<size_type>(*first);
+            ++first;
+        }
+        buffered_erase_omp_dev_impl(temp_indices,count);
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(temp_indices),count);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase_omp_dev_impl(const size_type erase_indices[], const size_type count)noexcept{
+        size_type new_size = size() - count;
+        const size_type old_size = size();
+        size_type * dev_indices = (size_type *) omp_target_alloc(count * sizeof(size_type), dev_no);
+        T * old_dev = device_data_buffer_;
+        T * new_dev = (T *) omp_target_alloc(capacity() * sizeof(T), dev_no);
+        try{
+            if (!dev_indices || !new_dev){
+                throw std::runtime_error("ERROR dynarray failed to allocate memory on offload device, erase not done");
+            }
+            bool fail = omp_target_memcpy(dev_indices,erase_indices,count * sizeof(size_type),0,0,dev_no,omp_get_initial_device());
+            if(fail){
+                throw std::runtime_error("ERROR dynarray failed to copy data to device memory");
+            }
+            // same index walk as buffered_erase, compacted out of place so no element is overwritten before it is read
+            #pragma omp target teams distribute parallel for is_device_ptr(old_dev,new_dev,dev_indices) device(dev_no)
+            for (size_type i = 0; i < old_size; ++i){
+                size_type pos = i;
+                for (size_type j = 0; j < count; ++j){
+                    pos = (pos == dev_indices[j]) ? -1:pos;
+                    pos -= static_cast<size_type>(pos > dev_indices[j]);
+                }
+                if (pos != -1){
+                    new_dev[pos] = old_dev[i];
+                }
+            }
+            device_data_buffer_ = new_dev;
+            new_dev = old_dev;
+            resize_arr(new_size);
+        }catch(std::runtime_error& e){
+           std::cerr<<e.what()<<std::endl;
+        }catch(...){
+            std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+        }
+        omp_target_free(new_dev,dev_no);
+        omp_target_free(dev_indices,dev_no);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    template<typename InputIt>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::sync_indices_omp_dev(InputIt first, const size_type count, const bool to_dev)noexcept{
+        if (count <= 0){
+            return;
+        }
+        typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<size_type> s_allocator_type;
+        s_allocator_type s_alloc(cap_alloc_.y());
+        size_type * temp_indices = reinterpret_cast<size_type*>(std::allocator_traits<s_allocator_type>::allocate(s_alloc,count));
+        for (size_type i = 0; i < count; ++i){
+            temp_indices[i] = static_cast<size_type>(*first);
+            ++first;
+        }
+        sync_indices_omp_dev(const_cast<const size_type*>(temp_indices),count,to_dev);
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(temp_indices),count);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::sync_indices_omp_dev(const size_type index_list[], const size_type count, const bool to_dev)noexcept{
+        if (count <= 0){
+            return;
+        }
+        size_type min_idx = index_list[0];
+        size_type max_idx = index_list[0];
+        #pragma omp parallel for reduction(min:min_idx) reduction(max:max_idx)
+        for (size_type i = 1; i < count; ++i){
+            min_idx = (index_list[i] < min_idx) ? index_list[i]:min_idx;
+            max_idx = (index_list[i] > max_idx) ? index_list[i]:max_idx;
+        }
+        if ((min_idx < 0) || (max_idx >= size())){
+            std::cerr<<"Error dynarray sync_indices called with an index out of bounds, indices span ["<<min_idx<<","<<max_idx
+                     <<"] size is "<<size()<<", nothing was copied"<<std::endl;
+            return;
+        }
+        // a range copy moves everything between the smallest and largest index but needs no staging, index upload or kernel launch
+        const size_type range_bytes = (max_idx - min_idx + 1) * sizeof(T);
+        const size_type packed_bytes = count * (sizeof(T) + sizeof(size_type));
+        if (range_bytes <= packed_bytes * HOPELESS_DYNARRAY_SPARSE_SYNC_BYTE_RATIO){
+            if (to_dev){
+                map_data_to_omp_dev(min_idx,max_idx+1);
+            }else{
+                map_data_from_omp_dev(min_idx,max_idx+1);
+            }
+            return;
+        }
+        // staging layout is [values][indices], values go first so they get the alignment of the allocation
+        const size_type idx_offset = ((count * sizeof(T) + alignof(size_type) - 1)/alignof(size_type)) * alignof(size_type);
+        const size_type staging_bytes = idx_offset + count * sizeof(size_type);
+        typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<char> c_allocator_type;
+        c_allocator_type c_alloc(cap_alloc_.y());
+        char * staging = reinterpret_cast<char*>(std::allocator_traits<c_allocator_type>::allocate(c_alloc,staging_bytes));
+        char * dev_staging = (char *) omp_target_alloc(staging_bytes, dev_no);
+        if (!dev_staging){
+            std::cerr<<"ERROR dynarray failed to allocate staging memory on offload device, falling back to a range copy"<<std::endl;
+            std::allocator_traits<c_allocator_type>::deallocate(c_alloc,reinterpret_cast<typename c_allocator_type::pointer>(staging),staging_bytes);
+            if (to_dev){
+                map_data_to_omp_dev(min_idx,max_idx+1);
+            }else{
+                map_data_from_omp_dev(min_idx,max_idx+1);
+            }
+            return;
+        }
+        T * vals = reinterpret_cast<T*>(staging);
+        size_type * idx = reinterpret_cast<size_type*>(staging + idx_offset);
+        T * dev_buf = device_data_buffer_;
+        const T * host_buf = data_buffer_;
+        try{
+            if (to_dev){
+                #pragma omp parallel for
+                for (size_type i = 0; i < count; ++i){
+                    vals[i] = host_buf[index_list[i]];
+                    idx[i] = index_list[i];
+                }
+                bool fail = omp_target_memcpy(dev_staging,staging,staging_bytes,0,0,dev_no,omp_get_initial_device());
+                if(fail){
+                    throw std::runtime_error("ERROR dynarray failed to copy data to device memory");
+                }
+                #pragma omp target teams distribute parallel for is_device_ptr(dev_staging,dev_buf) device(dev_no)
+                for (size_type i = 0; i < count; ++i){
+                    const T * dev_vals = reinterpret_cast<const T*>(dev_staging);
+                    const size_type * dev_idx = reinterpret_cast<const size_type*>(dev_staging + idx_offset);
+                    dev_buf[dev_idx[i]] = dev_vals[i];
+                }
+            }else{
+                #pragma omp parallel for
+                for (size_type i = 0; i < count; ++i){
+                    idx[i] = index_list[i];
+                }
+                bool fail = omp_target_memcpy(dev_staging,staging,count * sizeof(size_type),idx_offset,idx_offset,dev_no,omp_get_initial_device());
+                if(fail){
+                    throw std::runtime_error("ERROR dynarray failed to copy data to device memory");
+                }
+                #pragma omp target teams distribute parallel for is_device_ptr(dev_staging,dev_buf) device(dev_no)
+                for (size_type i = 0; i < count; ++i){
+                    T * dev_vals = reinterpret_cast<T*>(dev_staging);
+                    const size_type * dev_idx = reinterpret_cast<const size_type*>(dev_staging + idx_offset);
+                    dev_vals[i] = dev_buf[dev_idx[i]];
+                }
+                fail = omp_target_memcpy(staging,dev_staging,count * sizeof(T),0,0,omp_get_initial_device(),dev_no);
+                if(fail){
+                    throw std::runtime_error("ERROR dynarray failed to copy data from device memory");
+                }
+                #pragma omp parallel for
+                for (size_type i = 0; i < count; ++i){
+                    data_buffer_[index_list[i]] = vals[i];
+                }
+            }
+        }catch(std::runtime_error& e){
+           std::cerr<<e.what()<<std::endl;
+        }catch(...){
+            std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+        }
+        omp_target_free(dev_staging,dev_no);
+        std::allocator_traits<c_allocator_type>::deallocate(c_alloc,reinterpret_cast<typename c_allocator_type::pointer>(staging),staging_bytes);
+    }
+
+#endif
+    template<typename T,typename Allocator,typename GrowthPolicy>     
     auto inline operator <<(std::ostream& stream,
-        const dynarray<T,Allocator> & dynamic_array) 
+        const dynarray<T,Allocator,host_only,GrowthPolicy> & dynamic_array) 
             -> type_<std::ostream&, 
             decltype(std::cout<<std::declval<T>())>;  
 
-    template<typename T,typename Allocator>
-    void swap(dynarray<T,Allocator>& array1, dynarray<T,Allocator>& array2)noexcept;
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    void swap(dynarray<T,Allocator,host_only,GrowthPolicy>& array1, dynarray<T,Allocator,host_only,GrowthPolicy>& array2)noexcept;
 
-    template<typename T, typename Allocator>
-    struct  dynarray
+    template<typename T, typename Allocator,typename GrowthPolicy>
+    struct  dynarray<T,Allocator,host_only,GrowthPolicy>
     {
     public:
         // declare iterators here to use for typedef
@@ -1924,12 +2600,14 @@ namespace hopeless
             inline friend difference_type operator -(const const_rand_access_iterator lhs, const const_rand_access_iterator rhs)noexcept{return (lhs.iter - rhs.iter);}
         };
     
-        void swap(dynarray<T,Allocator>& rhs)noexcept;
+        void swap(dynarray<T,Allocator,host_only,GrowthPolicy>& rhs)noexcept;
 
         constexpr dynarray()noexcept(noexcept(Allocator()));
         constexpr explicit dynarray(const Allocator& alloc)noexcept;
         dynarray(size_type count, const T& value, const Allocator& alloc = Allocator())noexcept;
         explicit dynarray(size_type count,const Allocator& alloc = Allocator())noexcept;
+        // count elements that are never initialised (not mapped to the device either), for output buffers that will be overwritten
+        dynarray(size_type count,for_overwrite_t,const Allocator& alloc = Allocator())noexcept;
         
         dynarray( const dynarray& other )noexcept(noexcept(Allocator()));
         dynarray( const dynarray& other, const Allocator& alloc )noexcept;
@@ -2048,6 +2726,10 @@ namespace hopeless
     // some functions to somewhat combat code duplication
     private:
         inline void buffer_resize(const size_type & new_cap)noexcept; 
+
+        // offset of the element it refers to if that element is in this array, else -1
+        template<typename It>
+        inline difference_type buffer_offset_of(It & it)const noexcept;
     
         template<typename... Args>
         inline iterator insert_one(const_iterator pos,Args && ...args)noexcept;
@@ -2141,6 +2823,22 @@ namespace hopeless
         inline void push_back(const_reference value)noexcept;
         inline void push_back(T&& value)noexcept;
 
+        // append a whole range, capacity grows at most once and trivially copyable elements from contiguous memory
+        // are copied with one memcpy (split over threads when large)
+        template<typename InputIt>
+        inline auto append_range(InputIt first, InputIt last)noexcept
+            -> type_<void,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)
+                >;
+        template<typename Container>
+        inline auto append_range(const Container & container)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end()),
+                decltype(std::declval<Container>().size())>;
+
         template<typename ... Args >
         inline iterator emplace(const_iterator pos, Args&&... args)noexcept;       
 
@@ -2153,6 +2851,11 @@ namespace hopeless
 
         inline void resize(size_type new_size,const_reference value)noexcept;  
 
+        // change size without constructing the new elements, they hold garbage until written
+        // resize_uninitialized grows capacity through GrowthPolicy, reserve_and_set_size reserves exactly new_size if it has to grow
+        inline void resize_uninitialized(size_type new_size)noexcept;
+        inline void reserve_and_set_size(size_type new_size)noexcept;
+
     private:
         template<typename Not_empty, typename Maybe_Empty>        
         struct packed_pair : public Maybe_Empty{
@@ -2180,8 +2883,8 @@ namespace hopeless
         packed_pair<size_type,allocator_type> cap_alloc_;
     };
 
-    template<typename T,typename Allocator>                                                    
-    auto inline operator <<(std::ostream& stream, const dynarray<T,Allocator> & dynamic_array) 
+    template<typename T,typename Allocator,typename GrowthPolicy>                                                    
+    auto inline operator <<(std::ostream& stream, const dynarray<T,Allocator,host_only,GrowthPolicy> & dynamic_array) 
         -> type_<std::ostream&,
         decltype(std::cout<<std::declval<T>())>          
     {
@@ -2199,49 +2902,49 @@ namespace hopeless
         return stream;
     }
 
-    template<typename T,typename Allocator>
-    void swap(dynarray<T,Allocator>& array1, dynarray<T,Allocator>& array2)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    void swap(dynarray<T,Allocator,host_only,GrowthPolicy>& array1, dynarray<T,Allocator,host_only,GrowthPolicy>& array2)noexcept{
         array1.swap(array2);
     }
     
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::operator []
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::operator []
         (const size_type i)const noexcept{return data_buffer_[i];}
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::operator []
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::operator []
         (const size_type i)noexcept{return data_buffer_[i];}
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::operator ()
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::operator ()
         (const size_type i)const noexcept{return data_buffer_[i];}
     
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::operator ()
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::operator ()
         (const size_type i)noexcept{return data_buffer_[i];}
 
-    template<typename T,typename Allocator>
-    void dynarray<T,Allocator>::swap(dynarray & rhs)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    void dynarray<T,Allocator,host_only,GrowthPolicy>::swap(dynarray & rhs)noexcept{
         using std::swap;
         swap(this->data_buffer_,rhs.data_buffer_);
         swap(this->size_,rhs.size_);
         swap(this->cap_alloc_,rhs.cap_alloc_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr dynarray<T,Allocator>::dynarray()noexcept(noexcept(Allocator()))
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray()noexcept(noexcept(Allocator()))
         :data_buffer_(nullptr),
         size_(0),
         cap_alloc_(0){}
 
-    template<typename T,typename Allocator>
-    constexpr dynarray<T,Allocator>::dynarray(const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray(const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(0),
         cap_alloc_(0,alloc){}
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray(size_type count, const T& value, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray(size_type count, const T& value, const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(count),
         cap_alloc_(count,alloc)
@@ -2249,14 +2952,26 @@ namespace hopeless
         create_dynarr(std::forward<const T&>(value));
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray(size_type count,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray(size_type count,const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(count),
-        cap_alloc_(count,alloc){}
+        cap_alloc_(count,alloc)
+    {
+        create_dynarr();
+    }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray( const dynarray& other )noexcept(noexcept(Allocator()))
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray(size_type count,for_overwrite_t,const Allocator& alloc)noexcept
+        :data_buffer_(nullptr),
+        size_(count),
+        cap_alloc_(count,alloc)
+    {
+        create_dynarr(for_overwrite);
+    }
+
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray( const dynarray& other )noexcept(noexcept(Allocator()))
         :data_buffer_(nullptr),
         size_(other.size()),
         cap_alloc_(other.capacity(),
@@ -2266,8 +2981,8 @@ namespace hopeless
         create_dynarr(std::forward<const dynarray&>(other));
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray( const dynarray& other, const Allocator& alloc )noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray( const dynarray& other, const Allocator& alloc )noexcept
         :data_buffer_(nullptr),
         size_(other.size()),
         cap_alloc_(other.capacity(),alloc)
@@ -2275,8 +2990,8 @@ namespace hopeless
         create_dynarr(std::forward<const dynarray&>(other));
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray( dynarray&& other)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray( dynarray&& other)noexcept
         :data_buffer_(nullptr),
         size_(0),
         cap_alloc_(0,
@@ -2287,8 +3002,8 @@ namespace hopeless
         swap(*this,std::forward<dynarray&>(other));
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray(dynarray&& other, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray(dynarray&& other, const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(other.size()),
         cap_alloc_(other.capacity(),alloc)
@@ -2296,8 +3011,8 @@ namespace hopeless
         create_dynarr(std::forward<dynarray&&>(other));
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::dynarray( std::initializer_list<T> init, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray( std::initializer_list<T> init, const Allocator& alloc)noexcept
         :data_buffer_(nullptr),
         size_(init.size()),
         cap_alloc_(init.size(),alloc)
@@ -2305,9 +3020,9 @@ namespace hopeless
         create_dynarr(std::forward<const std::initializer_list<T>&>(init));
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template< typename InputIt >
-    dynarray<T,Allocator>::dynarray( 
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray( 
         type_<InputIt,
             decltype(std::declval<InputIt>().operator->(),
             std::declval<InputIt>().operator*())> first,
@@ -2320,19 +3035,19 @@ namespace hopeless
         create_dynarr(first,last);
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>::~dynarray()noexcept{
-        if constexpr (!(bool)(std::is_fundamental_v<T>)){
-            for (size_t i=0; i < size_;++i){
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>::~dynarray()noexcept{
+        if constexpr (!is_trivial_destroy_v<allocator_type,T>){
+            for (size_type i=0; i < size_;++i){
                 std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
             }
         }
         std::allocator_traits<allocator_type>::deallocate(cap_alloc_.y(), reinterpret_cast<pointer>(data_buffer_), capacity());
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container,typename ...Last_resort>
-    dynarray<T,Allocator>::dynarray(const type_<Container,
+    dynarray<T,Allocator,host_only,GrowthPolicy>::dynarray(const type_<Container,
                             decltype(std::declval<Container>().begin()),
                             decltype(std::declval<Container>().end()),
                             decltype(std::declval<Container>().size())> 
@@ -2353,15 +3068,15 @@ namespace hopeless
         create_dynarr(std::forward<const Container&>(array));
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>& dynarray<T,Allocator>::operator =(const dynarray & other)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>& dynarray<T,Allocator,host_only,GrowthPolicy>::operator =(const dynarray & other)noexcept{
         if (capacity()>=other.size()){
             destroy_elements();
             size_=other.size();
             construct_elements(other);
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator> temp(other,
+            dynarray<T,Allocator,host_only,GrowthPolicy> temp(other,
             std::allocator_traits<allocator_type>::select_on_container_copy_construction(
             other.get_allocator()));
             using std::swap;
@@ -2370,21 +3085,31 @@ namespace hopeless
         return *this;
     }
 
-    template<typename T,typename Allocator>
-    dynarray<T,Allocator>& dynarray<T,Allocator>::operator =(dynarray && other)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    dynarray<T,Allocator,host_only,GrowthPolicy>& dynarray<T,Allocator,host_only,GrowthPolicy>::operator =(dynarray && other)noexcept{
         destroy_dealloc();
         using std::swap;
         swap(*this,std::forward<dynarray&>(other));
         return *this;
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename... Args>
-    inline void dynarray<T,Allocator>::create_dynarr(Args && ...args)noexcept{
-        auto temp = std::allocator_traits<allocator_type>::allocate(cap_alloc_.y(),capacity());
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::create_dynarr(Args && ...args)noexcept{
+        // value initialising is just zeroing for these, zeroed memory from the allocator is free until it is touched
+        constexpr bool zeroed = (sizeof...(Args) == 0) && is_zero_initializable_v<T> && has_allocate_zeroed_v<allocator_type>;
+        constexpr bool overwrite = (std::is_same_v<std::decay_t<Args>,for_overwrite_t> || ...);
+        pointer temp;
+        if constexpr (zeroed){
+            temp = cap_alloc_.y().allocate_zeroed(capacity());
+        }else{
+            temp = std::allocator_traits<allocator_type>::allocate(cap_alloc_.y(),capacity());
+        }
         if (temp){
             data_buffer_ = reinterpret_cast<T*>(temp);
-            construct_elements(std::forward<Args>(args)...);
+            if constexpr (!zeroed && !overwrite){
+                construct_elements(std::forward<Args>(args)...);
+            }
         }else{
             if (capacity()>0)
             {
@@ -2401,180 +3126,222 @@ namespace hopeless
         }
     }
     
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::construct_elements(const T & value)noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (size_type i = 0; i < size_; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i],value);
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(const T & value)noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,const T&>){
+            bulk_construct_fill(cap_alloc_.y(),data_buffer_,0,size_,value);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (size_type i = 0; i < size_; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i],value);
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
     
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::construct_elements(const size_type begin, const size_type end, const_reference value)noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (difference_type i = begin; i < end; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i], std::forward<const_reference>(value)); it=i;
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(const size_type begin, const size_type end, const_reference value)noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,const T&>){
+            bulk_construct_fill(cap_alloc_.y(),data_buffer_,begin,end,value);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (difference_type i = begin; i < end; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i], std::forward<const_reference>(value)); it=i;
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::construct_elements()noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (size_type i = 0; i < size_; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i]);
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements()noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T>){
+            bulk_construct_default(cap_alloc_.y(),data_buffer_,0,size_);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (size_type i = 0; i < size_; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i]);
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::construct_elements(const size_type begin, const size_type end)noexcept{
-        difference_type it=-1;
-        try
-        {
-            for (difference_type i = begin; i < end; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
-                                &data_buffer_[i]); it=i;
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(const size_type begin, const size_type end)noexcept{
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T>){
+            bulk_construct_default(cap_alloc_.y(),data_buffer_,begin,end);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                for (difference_type i = begin; i < end; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),
+                                    &data_buffer_[i]); it=i;
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator>::construct_elements(const Container & container)noexcept 
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(const Container & container)noexcept 
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
             decltype(std::declval<Container>().size())>{
-        size_type ptr = 0;
-        difference_type it=-1;
-        try
-        {
-            for (const auto & i : container){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],i);++ptr;
+        if constexpr (is_plain_construct_v<allocator_type,T> && has_contiguous_data_of_v<const Container,T>){
+            bulk_memcpy(data_buffer_,container.data(),static_cast<size_type>(container.size()));
+        }else if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*container.begin())> &&
+                      is_random_access_iterator_v<decltype(container.begin())>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,0,container.begin(),std::distance(container.begin(),container.end()));
+        }else{
+            size_type ptr = 0;
+            difference_type it=-1;
+            try
+            {
+                for (const auto & i : container){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],i);++ptr;
+                }
+            }
+            catch(...)
+            {
+                std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator>::construct_elements(Container && container)noexcept 
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(Container && container)noexcept 
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
             decltype(std::declval<Container>().size())>
     {
-        size_type ptr = 0;
-        difference_type it=-1;
-        try
-        {
-            for (auto & i : container){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],std::move(i));++ptr;
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(std::move(*container.begin()))> &&
+                      is_random_access_iterator_v<decltype(container.begin())>){
+            bulk_construct_move(cap_alloc_.y(),data_buffer_,0,container.begin(),std::distance(container.begin(),container.end()));
+        }else{
+            size_type ptr = 0;
+            difference_type it=-1;
+            try
+            {
+                for (auto & i : container){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],std::move(i));++ptr;
+                }
+            }
+            catch(...)
+            {
+                std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            std::cerr<<"Failed to construct elements of dynarray with ranged based for on Container, does the container support rnage based for?"<<std::endl;
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator>::construct_elements(const size_type begin, const size_type end,
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(const size_type begin, const size_type end,
         const Container & container)noexcept 
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
             decltype(std::declval<Container>().size())>{
-        difference_type it=-1;
-        try
-        {
-            #pragma omp loop
-            for (difference_type i = begin; i < end; ++i){
-                std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[i],container[i]);
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*container.begin())> &&
+                      is_random_access_iterator_v<decltype(container.begin())>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,begin,container.begin()+begin,end-begin);
+        }else{
+            difference_type it=-1;
+            try
+            {
+                #pragma omp loop
+                for (difference_type i = begin; i < end; ++i){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[i],container[i]);
+                }
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
             }
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
         }
     }
     
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template< typename InputIt >
-    inline auto dynarray<T,Allocator>::construct_elements(InputIt first, InputIt last)noexcept 
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::construct_elements(InputIt first, InputIt last)noexcept 
         -> type_<void,
             decltype(*std::declval<InputIt>()),
             decltype(++std::declval<InputIt>()),
             decltype(first != last)
             >{
-        size_type ptr = 0;
-        difference_type it=-1;
-        try
-        {
-            for (auto iter=first;iter!=last;++iter){std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],*iter);++ptr;}
-        }
-        catch(...)
-        {
-            size_=it & -static_cast<difference_type>(it>-1);
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
+        if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*first)> && is_random_access_iterator_v<InputIt>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,0,first,std::distance(first,last));
+        }else{
+            size_type ptr = 0;
+            difference_type it=-1;
+            try
+            {
+                for (auto iter=first;iter!=last;++iter){std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&data_buffer_[ptr],*iter);++ptr;}
+            }
+            catch(...)
+            {
+                size_=it & -static_cast<difference_type>(it>-1);
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
+            }
         }
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::destroy_elements()noexcept{
-        if constexpr (!(bool)(std::is_fundamental_v<T>)){
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::destroy_elements()noexcept{
+        // trivially destructible elements have nothing to run, the memory is just reused or freed
+        if constexpr (is_nothrow_alloc_destructible_v<allocator_type,T> && !is_trivial_destroy_v<allocator_type,T>){
+            for (difference_type i=size_-1; i >= 0;--i){
+                std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
+            }
+        }else if constexpr (!is_trivial_destroy_v<allocator_type,T>){
             difference_type it=-1;
             try
             {
-                for (difference_type i=size_; i >= 0;--i){
+                for (difference_type i=size_-1; i >= 0;--i){
                     std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
                     it=i;
                 }
@@ -2587,13 +3354,18 @@ namespace hopeless
             }
         }
     }
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::destroy_elements(const size_type new_size,const size_type old_size)noexcept{
-        if constexpr (!(bool)(std::is_fundamental_v<T>)){
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::destroy_elements(const size_type new_size,const size_type old_size)noexcept{
+        // trivially destructible elements have nothing to run, the memory is just reused or freed
+        if constexpr (is_nothrow_alloc_destructible_v<allocator_type,T> && !is_trivial_destroy_v<allocator_type,T>){
+            for (difference_type i=old_size-1; i >= new_size;--i){
+                std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
+            }
+        }else if constexpr (!is_trivial_destroy_v<allocator_type,T>){
             difference_type it=-1;
             try
             {
-                for (difference_type i=old_size; i >= new_size;--i){
+                for (difference_type i=old_size-1; i >= new_size;--i){
                     std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[i]);
                     it=i;
                 }
@@ -2608,8 +3380,8 @@ namespace hopeless
         size_ = new_size;
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::destroy_dealloc()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::destroy_dealloc()noexcept{
         destroy_elements();
         size_=0;
         std::allocator_traits<allocator_type>::deallocate(cap_alloc_.y(), reinterpret_cast<pointer>(data_buffer_), capacity());
@@ -2617,23 +3389,23 @@ namespace hopeless
         data_buffer_ = nullptr;
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::assign(size_type count, const_reference value)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::assign(size_type count, const_reference value)noexcept{
         if (capacity()>=count){
             destroy_elements();
             size_=count;
             construct_elements(std::forward<const_reference>(value));
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator> temp(count,std::forward<const_reference>(value),get_allocator());
+            dynarray<T,Allocator,host_only,GrowthPolicy> temp(count,std::forward<const_reference>(value),get_allocator());
             using std::swap;
             swap(*this,temp);
         }
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename InputIt >
-    inline void dynarray<T,Allocator>::assign( 
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::assign( 
             type_<InputIt,
                 decltype(std::declval<InputIt>().operator->(),
                 std::declval<InputIt>().operator*())> first,
@@ -2645,33 +3417,33 @@ namespace hopeless
             construct_elements(std::forward<InputIt>(first),std::forward<InputIt>(last));
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator> temp(first,last,get_allocator());
+            dynarray<T,Allocator,host_only,GrowthPolicy> temp(first,last,get_allocator());
             using std::swap;
             swap(*this,temp);
         }
     } 
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::assign(std::initializer_list<T> ilist)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::assign(std::initializer_list<T> ilist)noexcept{
         if (capacity()>=ilist.size()){
             destroy_elements();
             size_=ilist.size();
             construct_elements(std::forward<std::initializer_list<T>>(ilist));
         }else{
             destroy_dealloc();
-            dynarray<T,Allocator> temp(std::forward<std::initializer_list<T>>(ilist),get_allocator());
+            dynarray<T,Allocator,host_only,GrowthPolicy> temp(std::forward<std::initializer_list<T>>(ilist),get_allocator());
             using std::swap;
             swap(*this,temp);
         }
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::allocator_type dynarray<T,Allocator>::get_allocator()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::allocator_type dynarray<T,Allocator,host_only,GrowthPolicy>::get_allocator()const noexcept{
         return cap_alloc_.y();
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::at(size_type pos){
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::at(size_type pos){
         if ((pos>=size_) || (pos<0)){
             std::cerr<<"Error Dynarray indexing with at() out of bounds"
             throw std::out_of_range("Bad pos passed to at()");
@@ -2681,8 +3453,8 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reference dynarray<T,Allocator>::at(size_type pos)const{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reference dynarray<T,Allocator,host_only,GrowthPolicy>::at(size_type pos)const{
         if ((pos>=size_) || (pos<0)){
             std::cerr<<"Error Dynarray indexing with at() out of bounds"
             throw std::out_of_range("Bad pos passed to at()");
@@ -2692,148 +3464,143 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::front(){
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::front(){
         return data_buffer_[0];
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reference dynarray<T,Allocator>::front()const{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reference dynarray<T,Allocator,host_only,GrowthPolicy>::front()const{
         return data_buffer_[0];
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::back(){
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::back(){
         return data_buffer_[size_];
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reference dynarray<T,Allocator>::back()const{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reference dynarray<T,Allocator,host_only,GrowthPolicy>::back()const{
         return data_buffer_[size_];
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline T* dynarray<T,Allocator>::data()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline T* dynarray<T,Allocator,host_only,GrowthPolicy>::data()noexcept{
         return data_buffer_;
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline const T* dynarray<T,Allocator>::data()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline const T* dynarray<T,Allocator,host_only,GrowthPolicy>::data()const noexcept{
         return data_buffer_;
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::begin()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::begin()noexcept{
         return rand_access_iterator(data_buffer_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_iterator dynarray<T,Allocator>::begin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::begin()const noexcept{
         return const_rand_access_iterator(data_buffer_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_iterator dynarray<T,Allocator>::cbegin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::cbegin()const noexcept{
         return const_rand_access_iterator(data_buffer_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::end()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::end()noexcept{
         return rand_access_iterator(data_buffer_+size_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_iterator dynarray<T,Allocator>::end()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::end()const noexcept{
         return const_rand_access_iterator(data_buffer_+size_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_iterator dynarray<T,Allocator>::cend()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::cend()const noexcept{
         return const_rand_access_iterator(data_buffer_+size_);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reverse_iterator dynarray<T,Allocator>::rbegin()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reverse_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::rbegin()noexcept{
         return std::reverse_iterator<rand_access_iterator>(rand_access_iterator(data_buffer_));
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reverse_iterator dynarray<T,Allocator>::rbegin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::rbegin()const noexcept{
         return std::reverse_iterator<const_rand_access_iterator>(const_rand_access_iterator(data_buffer_));
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reverse_iterator dynarray<T,Allocator>::crbegin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::crbegin()const noexcept{
         return std::reverse_iterator<const_rand_access_iterator>(const_rand_access_iterator(data_buffer_));
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::reverse_iterator dynarray<T,Allocator>::rend()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::reverse_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::rend()noexcept{
         return std::reverse_iterator<rand_access_iterator>(rand_access_iterator(data_buffer_+size_));
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reverse_iterator dynarray<T,Allocator>::rend()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::rend()const noexcept{
         return std::reverse_iterator<const_rand_access_iterator>(const_rand_access_iterator(data_buffer_+size_));
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::const_reverse_iterator dynarray<T,Allocator>::crend()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator dynarray<T,Allocator,host_only,GrowthPolicy>::crend()const noexcept{
         return std::reverse_iterator<const_rand_access_iterator>(const_rand_access_iterator(data_buffer_+size_));
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline bool dynarray<T,Allocator>::empty()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline bool dynarray<T,Allocator,host_only,GrowthPolicy>::empty()const noexcept{
         return (size_ == 0);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::size_type dynarray<T,Allocator>::size()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::size_type dynarray<T,Allocator,host_only,GrowthPolicy>::size()const noexcept{
         return size_;
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::size_type dynarray<T,Allocator>::max_size()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::size_type dynarray<T,Allocator,host_only,GrowthPolicy>::max_size()const noexcept{
         return (std::numeric_limits<size_type>::max()/sizeof(T))  -1;       
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::reserve(size_type new_cap)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::reserve(size_type new_cap)noexcept{
         if (new_cap > capacity())
         {
             buffer_resize(new_cap);
         }
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::grow_reserve(size_type new_cap)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::grow_reserve(size_type new_cap)noexcept{
         if (new_cap > capacity()){
-            const size_type s = (capacity() * HOPELESS_DYNARRAY_CAPACITY_GROWTH_RATE);
-            const bool sufficient_growth = (capacity() * HOPELESS_DYNARRAY_CAPACITY_GROWTH_RATE)>new_cap;
-            new_cap = sufficient_growth * s + static_cast<size_type>(!sufficient_growth) * new_cap;         //will have to profile this versus using if else or ternary
-            buffer_resize(new_cap);
+            buffer_resize(GrowthPolicy::next_capacity(capacity(),new_cap,sizeof(T)));
         }
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::buffer_resize(const size_type & new_cap)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::buffer_resize(const size_type & new_cap)noexcept{
         auto temp = reinterpret_cast<T*>(std::allocator_traits<allocator_type>::allocate(cap_alloc_.y(),new_cap));
         if (temp){
-            try{
-                for (size_type i = 0; i < size_;++i){
-                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&temp[i],std::move(data_buffer_[i]));
+            try_or_report<is_nothrow_relocatable_v<allocator_type,T>>([&]{
+                if constexpr (is_plain_construct_v<allocator_type,T>){
+                    bulk_memcpy(temp,data_buffer_,size_);
+                }else{
+                    for (size_type i = 0; i < size_;++i){
+                        std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),&temp[i],std::move(data_buffer_[i]));
+                    }
                 }
                 destroy_elements();
                 std::allocator_traits<allocator_type>::deallocate(cap_alloc_.y(), reinterpret_cast<pointer>(data_buffer_), capacity());
                 data_buffer_ = temp;
                 cap_alloc_.x() = new_cap;
-            }
-            catch(...)
-            {
-                std::cout << "Dynarray failed to resize" << '\n';
-                std::exception_ptr exception=std::current_exception();
-                cout_exception(exception);
-            }
+            },"Dynarray failed to resize");
         }else{
             if (new_cap>0)
             {
@@ -2847,13 +3614,13 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator>  
+    template<typename T,typename Allocator,typename GrowthPolicy>  
     template<typename... Args>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::insert_one(const_iterator pos,Args && ...args)noexcept{
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::insert_one(const_iterator pos,Args && ...args)noexcept{
         const difference_type offset = pos - begin();                                   
         grow_reserve(size() + 1);    //invalidates iterators
         pos = begin() + offset;
-        try{
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T> && std::is_nothrow_constructible_v<T,Args&&...>>([&]{
             if (pos != end()){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+size(),std::move(data_buffer_[size()-1]));
                 size_+=1;
@@ -2865,32 +3632,23 @@ namespace hopeless
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+size(),std::forward<Args>(args)...);
                 size_+=1;
             }
-        }
-        catch(...){
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator>  
+    template<typename T,typename Allocator,typename GrowthPolicy>  
     template<typename... Args>
-    inline void dynarray<T,Allocator>::append(Args && ...args)noexcept{
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::append(Args && ...args)noexcept{
         grow_reserve(size() + 1);    //invalidates iterators
-        try
-        {
+        try_or_report<is_nothrow_alloc_constructible_v<allocator_type,T,Args&&...>>([&]{
             std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+size(),std::forward<Args>(args)...);
             size_+=1;
-        }catch(...){
-            std::cerr << "Hopeless dynarray failed to construct element" << '\n';
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        },"Hopeless dynarray failed to construct element");
     }
 
-    template<typename T,typename Allocator>  
+    template<typename T,typename Allocator,typename GrowthPolicy>  
     template<typename... Args>
-    inline void dynarray<T,Allocator>::resize_arr(size_type & new_size,Args && ... args)noexcept{
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::resize_arr(size_type & new_size,Args && ... args)noexcept{
         grow_reserve(new_size);
         if (new_size < size()){
             destroy_elements(new_size,size());
@@ -2900,9 +3658,9 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator> 
+    template<typename T,typename Allocator,typename GrowthPolicy> 
     template<typename index_container>
-    inline void dynarray<T,Allocator>::setup_buffered_insert(index_container & insert_indices, size_type count){
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::setup_buffered_insert(index_container & insert_indices, size_type count){
         const size_type old_size = size();
         typedef typename std::allocator_traits<allocator_type>::rebind_alloc<size_type> s_allocator_type;
         s_allocator_type s_alloc(cap_alloc_.y());
@@ -2928,9 +3686,9 @@ namespace hopeless
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(arr_indx),old_size);
     }
 
-    template<typename T,typename Allocator> 
+    template<typename T,typename Allocator,typename GrowthPolicy> 
     template<typename indices>
-    inline void dynarray<T,Allocator>::setup_buffered_insert(indices insert_indices[], size_type count){
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::setup_buffered_insert(indices insert_indices[], size_type count){
         const size_type old_size = size();
         typedef typename std::allocator_traits<allocator_type>::rebind_alloc<size_type> s_allocator_type;
         s_allocator_type s_alloc(cap_alloc_.y());
@@ -2957,37 +3715,36 @@ namespace hopeless
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(arr_indx),old_size);
     }
 
-    template<typename T,typename Allocator>
-    constexpr inline dynarray<T,Allocator>::size_type dynarray<T,Allocator>::capacity()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    constexpr inline dynarray<T,Allocator,host_only,GrowthPolicy>::size_type dynarray<T,Allocator,host_only,GrowthPolicy>::capacity()const noexcept{
         return cap_alloc_.x();       
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::shrink_to_fit()noexcept{
-        buffer_resize(size(),true);
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::shrink_to_fit()noexcept{
+        buffer_resize(size());
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::clear()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::clear()noexcept{
         destroy_elements(0,size());
     }
 
-    template<typename T,typename Allocator>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::insert(const_iterator pos, const value_type& value)noexcept{    
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::insert(const_iterator pos, const value_type& value)noexcept{    
         return insert_one(pos,std::forward<const T&>(value));
     }
 
-    template<typename T,typename Allocator>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::insert(const_iterator pos, T&& value)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::insert(const_iterator pos, T&& value)noexcept{
         return insert_one(pos,std::forward<const T&>(value));
     }
-    template<typename T,typename Allocator>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::insert(const_iterator pos, size_type count, const T& value)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::insert(const_iterator pos, size_type count, const T& value)noexcept{
         const difference_type offset = pos - begin();   // using this to keep track (bookeep in case of iterator invalidation)                                 
         grow_reserve(size() + count);        // may invalidate iterators
         pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T>>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;      // how many elements at the end of the dynarray to move construct
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){                 // everything from the last element down to the number of elements move construct
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -3005,24 +3762,20 @@ namespace hopeless
                data_buffer_[offset+i]=value;
             }
             size_ += count;
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename InputIt>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::insert(const_iterator pos, InputIt first, InputIt last)noexcept{
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)noexcept{
         const difference_type offset = pos - begin();                   // using this to keep track (bookeep in case of iterator invalidation)
         const difference_type count = std::distance(first,last);        // total number of elements to construct                                
         grow_reserve(size() + count);        // may invalidate iterators
         pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T> &&
+            is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*first)> && std::is_nothrow_assignable_v<T&,decltype(*first)> &&
+            noexcept(--last) && noexcept(++first)>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;      
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -3040,23 +3793,17 @@ namespace hopeless
                 ++first;
             }
             size_ += count;
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::insert(const_iterator pos, std::initializer_list<T> ilist)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::insert(const_iterator pos, std::initializer_list<T> ilist)noexcept{
         const difference_type offset = pos - begin();                   // using this to keep track (bookeep in case of iterator invalidation)
         const difference_type count = ilist.size();        // total number of elements to construct
         grow_reserve(size() + count);        // may invalidate iterators
         pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T>>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;      
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -3074,18 +3821,13 @@ namespace hopeless
                 data_buffer_[offset+i] = *(ilist.begin()+i);
             }
             size_ += count;
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container>
-    inline auto dynarray<T,Allocator>::insert(const_iterator pos,Container && container)noexcept
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::insert(const_iterator pos,Container && container)noexcept
     -> type_<iterator,
         decltype(std::declval<Container>().begin()),
         decltype(std::declval<Container>().end()),
@@ -3098,8 +3840,9 @@ namespace hopeless
             grow_reserve(size() + count);        // invalidates iterators
             pos = begin() + offset;                     // using offset we can get back a iterator that points the correct element
         }
-        try
-        {
+        try_or_report<is_nothrow_shiftable_v<allocator_type,T> &&
+            is_nothrow_alloc_constructible_v<allocator_type,T,decltype(std::move(*container.begin()))> &&
+            std::is_nothrow_assignable_v<T&,decltype(*container.begin())> && noexcept(container.end()-1)>([&]{
             const difference_type num_move_c =((end()-pos)<count) ? (end()-pos):count;   
             for (difference_type i = size_-1; i >=  size_-num_move_c; --i){
                 std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_+i+count,std::move(data_buffer_[i]));
@@ -3117,18 +3860,13 @@ namespace hopeless
                 data_buffer_[offset+i] = *(container.begin()+i);
             }
             size_ += count;
-        }
-        catch(...)
-        {
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        });
         return rand_access_iterator(pos.ptr());
     }
     
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container, typename index_container>
-    inline auto dynarray<T,Allocator>::buffered_insert(const Container & insert_elements,index_container & insert_indices)
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::buffered_insert(const Container & insert_elements,index_container & insert_indices)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -3150,9 +3888,9 @@ namespace hopeless
         }
     }
     
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container, typename indices>
-    inline auto dynarray<T,Allocator>::buffered_insert(const Container & insert_elements,indices insert_indices[], size_type count)
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::buffered_insert(const Container & insert_elements,indices insert_indices[], size_type count)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -3167,9 +3905,9 @@ namespace hopeless
         }
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container, typename index_container>
-    inline auto dynarray<T,Allocator>::buffered_insert(Container && insert_elements,index_container & insert_indices)
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::buffered_insert(Container && insert_elements,index_container & insert_indices)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -3191,9 +3929,9 @@ namespace hopeless
         }
     }
     
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename Container, typename indices>
-    inline auto dynarray<T,Allocator>::buffered_insert(Container && insert_elements,indices insert_indices[], size_type count)
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::buffered_insert(Container && insert_elements,indices insert_indices[], size_type count)
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -3209,9 +3947,9 @@ namespace hopeless
     }
 
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename index_container>
-    inline auto dynarray<T,Allocator>::buffered_erase(index_container & erase_indices)
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::buffered_erase(index_container & erase_indices)
         -> type_<void,
             decltype(std::declval<index_container>().begin()),
             decltype(std::declval<index_container>().end()),
@@ -3244,9 +3982,9 @@ namespace hopeless
         std::allocator_traits<d_allocator_type>::deallocate(d_alloc,reinterpret_cast<typename d_allocator_type::pointer>(arr_indx),old_size);
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename indices>
-    inline auto dynarray<T,Allocator>::buffered_erase(indices erase_indices[], size_type count)
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::buffered_erase(indices erase_indices[], size_type count)
         -> type_<void,
             decltype(static_cast<int>(std::declval<indices>()))>
     {
@@ -3275,8 +4013,8 @@ namespace hopeless
         std::allocator_traits<d_allocator_type>::deallocate(d_alloc,reinterpret_cast<typename d_allocator_type::pointer>(arr_indx),old_size);
     }
 
-    template<typename T,typename Allocator>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::erase(const_iterator pos)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::erase(const_iterator pos)noexcept{
         const difference_type offset = pos - begin();
         for (difference_type i = offset; i < size_-1; ++i){
             data_buffer_[i] = std::move(data_buffer_[i+1]);
@@ -3286,8 +4024,8 @@ namespace hopeless
         return iterator(data_buffer_+offset);
     }
 
-    template<typename T,typename Allocator>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::erase(const_iterator first, const_iterator last)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::erase(const_iterator first, const_iterator last)noexcept{
         const difference_type offset = first - begin();
         const difference_type count = last - first;
         for (difference_type i = offset; i < size_ - count; ++i){
@@ -3297,51 +4035,216 @@ namespace hopeless
         return iterator(data_buffer_+offset);
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::push_back(const_reference value)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::push_back(const_reference value)noexcept{
         append(std::forward<const T&>(value));
     }
 
-    template<typename T,typename Allocator>
-    inline void dynarray<T,Allocator>::push_back(T&& value)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::push_back(T&& value)noexcept{
         append(std::forward<T&&>(value));
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    template<typename It>
+    inline typename dynarray<T,Allocator,host_only,GrowthPolicy>::difference_type
+    dynarray<T,Allocator,host_only,GrowthPolicy>::buffer_offset_of(It & it)const noexcept{
+        if constexpr (std::is_reference_v<decltype(*it)> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(*it)>>,T>){
+            auto && referred = *it;     // move iterators give an rvalue reference
+            const T * element = std::addressof(referred);
+            if (std::less_equal<const T*>()(data_buffer_,element) && std::less<const T*>()(element,data_buffer_ + size_)){
+                return element - data_buffer_;
+            }
+        }
+        return -1;
+    }
+
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    template<typename InputIt>
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::append_range(InputIt first, InputIt last)noexcept
+        -> type_<void,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)
+            >
+    {
+        const difference_type count = std::distance(first,last);
+        if (count <= 0){
+            return;
+        }
+        const size_type old_size = size();
+        // the range may be part of this array, growing frees the buffer it points into before it is read
+        const difference_type alias_offset = (old_size + count > capacity()) ? buffer_offset_of(first):-1;
+        constexpr bool pointer_to_T = std::is_pointer_v<InputIt> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>,T>;
+        if constexpr (!pointer_to_T){
+            if (alias_offset >= 0){
+                // only a pointer can be re-based onto the new buffer, copy the elements out first
+                dynarray<T,Allocator,host_only,GrowthPolicy> temp;
+                temp.append_range(first,last);
+                if (temp.size() != count){
+                    return;
+                }
+                if constexpr (std::is_trivially_copyable_v<T>){
+                    append_range(temp.data(),temp.data() + count);
+                }else{
+                    append_range(std::make_move_iterator(temp.data()),std::make_move_iterator(temp.data() + count));
+                }
+                return;
+            }
+        }
+        grow_reserve(old_size + count);
+        if (capacity() < old_size + count){
+            return;
+        }
+        if constexpr (pointer_to_T){
+            if (alias_offset >= 0){
+                first = data_buffer_ + alias_offset;
+                last = first + count;
+            }
+        }
+        if constexpr (pointer_to_T && std::is_trivially_copyable_v<T>){
+            bulk_memcpy(data_buffer_ + old_size,first,count);
+        }else if constexpr (is_nothrow_alloc_constructible_v<allocator_type,T,decltype(*first)> && is_random_access_iterator_v<InputIt>){
+            bulk_construct_copy(cap_alloc_.y(),data_buffer_,old_size,first,count);
+        }else{
+            difference_type it = old_size;
+            try{
+                for (auto iter = first; iter != last; ++iter){
+                    std::allocator_traits<allocator_type>::construct(cap_alloc_.y(),data_buffer_ + it,*iter);
+                    ++it;
+                }
+            }catch(...){
+                size_ = it;
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
+                return;
+            }
+        }
+        size_ = old_size + count;
+    }
+
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    template<typename Container>
+    inline auto dynarray<T,Allocator,host_only,GrowthPolicy>::append_range(const Container & container)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end()),
+            decltype(std::declval<Container>().size())>
+    {
+        if constexpr (has_contiguous_data_v<const Container>){
+            append_range(container.data(),container.data() + std::distance(container.begin(),container.end()));
+        }else{
+            append_range(container.begin(),container.end());
+        }
+    }
+
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename... Args>
-    inline dynarray<T,Allocator>::iterator dynarray<T,Allocator>::emplace(const_iterator pos, Args&&...args)noexcept{
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::iterator dynarray<T,Allocator,host_only,GrowthPolicy>::emplace(const_iterator pos, Args&&...args)noexcept{
         return insert_one(pos,std::forward<Args>(args)...);
     }
 
-    template<typename T,typename Allocator>
+    template<typename T,typename Allocator,typename GrowthPolicy>
     template<typename... Args>
-    inline dynarray<T,Allocator>::reference dynarray<T,Allocator>::emplace_back(Args && ...args)noexcept{
+    inline dynarray<T,Allocator,host_only,GrowthPolicy>::reference dynarray<T,Allocator,host_only,GrowthPolicy>::emplace_back(Args && ...args)noexcept{
         append(std::forward<Args>(args)...);
         return data_buffer_[size()-1];
     }
 
-    template<typename T, typename Allocator>
-    inline void dynarray<T,Allocator>::pop_back()noexcept{
+    template<typename T, typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::pop_back()noexcept{
         // will crash and burn if the dynarray is empty obviously
-        try{
+        try_or_report<is_nothrow_alloc_destructible_v<allocator_type,T>>([&]{
             std::allocator_traits<allocator_type>::destroy(cap_alloc_.y(),&data_buffer_[size()-1]);
             --size_;
-        }catch(...){
-            std::cerr << "Failed to call pop_back on hopeless dynarray" << '\n';
-            std::exception_ptr exception=std::current_exception();
-            cout_exception(exception);
-        }
+        },"Failed to call pop_back on hopeless dynarray");
     }
 
-    template<typename T, typename Allocator>
-    inline void dynarray<T,Allocator>::resize(size_type new_size)noexcept{
+    template<typename T, typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::resize(size_type new_size)noexcept{
         resize_arr(new_size);
     }
 
-    template<typename T, typename Allocator>
-    inline void dynarray<T,Allocator>::resize(size_type new_size, const_reference value)noexcept{
+    template<typename T, typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::resize(size_type new_size, const_reference value)noexcept{
         resize_arr(new_size,std::forward<const_reference>(value));
     }
-#endif
+
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::resize_uninitialized(size_type new_size)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "resize_uninitialized needs an implicit lifetime type");
+        grow_reserve(new_size);
+        if (capacity() >= new_size){
+            size_ = new_size;
+        }
+    }
+
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    inline void dynarray<T,Allocator,host_only,GrowthPolicy>::reserve_and_set_size(size_type new_size)noexcept{
+        static_assert(std::is_trivially_copyable_v<T>, "reserve_and_set_size needs an implicit lifetime type");
+        if (new_size > capacity()){
+            buffer_resize(new_size);
+        }
+        if (capacity() >= new_size){
+            size_ = new_size;
+        }
+    }
+
+    // element wise comparison, sizes first, trivially copyable elements go through simd_kernels.hpp (memcmp when equal
+    // values always have equal bytes), the allocator, offload and growth policies don't take part
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator ==(const dynarray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const dynarray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        if (lhs.size() != rhs.size()){
+            return false;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>){
+            return kernels::equal(lhs.data(),rhs.data(),lhs.size());
+        }else{
+            return std::equal(lhs.data(),lhs.data() + lhs.size(),rhs.data());
+        }
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator !=(const dynarray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const dynarray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return !(lhs == rhs);
+    }
+
+    // lexicographic, like std::vector
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator <(const dynarray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                           const dynarray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        if constexpr (std::is_trivially_copyable_v<T>){
+            return kernels::lexicographical_compare(lhs.data(),lhs.size(),rhs.data(),rhs.size());
+        }else{
+            return std::lexicographical_compare(lhs.data(),lhs.data() + lhs.size(),rhs.data(),rhs.data() + rhs.size());
+        }
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator >(const dynarray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                           const dynarray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return rhs < lhs;
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator <=(const dynarray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const dynarray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return !(rhs < lhs);
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator >=(const dynarray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const dynarray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return !(lhs < rhs);
+    }
 }
 #endif
\ No newline at end of file
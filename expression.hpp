@@ -0,0 +1,264 @@
+// lazy element wise arithmetic over dynarray and dyn_extent_span, a + b * x only builds a small tree of operands
+// (references to the dynarrays, copies of the spans and scalars), nothing is computed until hopeless::par::assign() runs the
+// whole tree as one fused loop, parallel simd on the host or a single target teams kernel on the device copies
+//      hopeless::par::assign(hopeless::par::host,c,a * x + b);
+//      hopeless::par::assign(hopeless::par::target<>,c,a * x + b);     // a, b and c mirrored dynarrays (or device spans)
+// the dynarrays (and the memory behind the spans) have to outlive the expression, every array has to have the destination's size
+// the destination can also appear in the expression (c = c * 2 + a), element i is only read before it is written
+#pragma once
+
+#ifndef HOPELESS_EXPRESSION
+#define HOPELESS_EXPRESSION
+
+#include<iostream>
+#include<cstddef>
+#include<type_traits>
+#include<functional>
+#include<utility>
+#include<omp.h>
+
+#include "dynarray.hpp"
+#include "dyn_extent_span.hpp"
+#include "par.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename Node>
+    struct expression
+    {
+        Node node;
+    };
+
+    namespace expr_detail
+    {
+        template<typename T>
+        struct is_array : std::false_type{};
+        template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+        struct is_array<dynarray<T,Allocator,OffloadPolicy,GrowthPolicy>> : std::true_type{};
+        template<typename T>
+        struct is_array<dyn_extent_span<T>> : std::true_type{};
+
+        template<typename T>
+        struct is_span : std::false_type{};
+        template<typename T>
+        struct is_span<dyn_extent_span<T>> : std::true_type{};
+
+        template<typename T>
+        struct is_expression : std::false_type{};
+        template<typename Node>
+        struct is_expression<expression<Node>> : std::true_type{};
+
+        template<typename T>
+        inline constexpr bool is_array_v = is_array<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+        template<typename T>
+        inline constexpr bool is_expression_v = is_expression<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+        template<typename T>
+        inline constexpr bool is_scalar_v = std::is_arithmetic_v<std::remove_cv_t<std::remove_reference_t<T>>>;
+
+        // at least one side has to be an array or an expression so plain arithmetic is left alone
+        template<typename L, typename R>
+        inline constexpr bool is_operand_pair_v = (is_array_v<L> || is_expression_v<L> || is_array_v<R> || is_expression_v<R>)
+            && (is_array_v<L> || is_expression_v<L> || is_scalar_v<L>)
+            && (is_array_v<R> || is_expression_v<R> || is_scalar_v<R>);
+
+        // unbound nodes, built by the operators
+        // containers are held by pointer, spans are copied since they are cheap views and often temporaries (arr.some_span())
+        template<typename Range>
+        struct array_ref
+        {
+            const Range * range;
+            constexpr inline const Range & get()const noexcept{return *range;}
+        };
+
+        template<typename T>
+        struct array_ref<dyn_extent_span<T>>
+        {
+            dyn_extent_span<T> range;
+            constexpr inline const dyn_extent_span<T> & get()const noexcept{return range;}
+        };
+
+        template<typename T>
+        struct scalar
+        {
+            T value;
+        };
+
+        template<typename Op, typename Arg>
+        struct unary
+        {
+            Op op;
+            Arg arg;
+        };
+
+        template<typename Op, typename Lhs, typename Rhs>
+        struct binary
+        {
+            Op op;
+            Lhs lhs;
+            Rhs rhs;
+        };
+
+        template<typename T>
+        inline auto make_node(const T & operand)noexcept{
+            if constexpr (is_expression_v<T>){
+                return operand.node;
+            }else if constexpr (is_span<T>::value){
+                return array_ref<T>{operand};
+            }else if constexpr (is_array_v<T>){
+                return array_ref<T>{&operand};
+            }else{
+                return scalar<T>{operand};
+            }
+        }
+
+        #pragma omp declare target
+        // bound nodes, the arrays replaced by the pointers of the execution space, this is what runs in the loop
+        template<typename T>
+        struct bound_array
+        {
+            const T * data;
+            constexpr inline T operator ()(const std::ptrdiff_t i)const noexcept{return data[i];}
+        };
+
+        template<typename T>
+        struct bound_scalar
+        {
+            T value;
+            constexpr inline T operator ()(const std::ptrdiff_t)const noexcept{return value;}
+        };
+
+        template<typename Op, typename Arg>
+        struct bound_unary
+        {
+            Op op;
+            Arg arg;
+            constexpr inline auto operator ()(const std::ptrdiff_t i)const noexcept{return op(arg(i));}
+        };
+
+        template<typename Op, typename Lhs, typename Rhs>
+        struct bound_binary
+        {
+            Op op;
+            Lhs lhs;
+            Rhs rhs;
+            constexpr inline auto operator ()(const std::ptrdiff_t i)const noexcept{return op(lhs(i),rhs(i));}
+        };
+        #pragma omp end declare target
+
+        template<typename Exec, typename Range>
+        inline auto bind(const Exec & exec, const array_ref<Range> & node)noexcept{
+            const auto view = par::par_detail::make_view(exec,node.get());
+            return bound_array<std::remove_cv_t<std::remove_reference_t<decltype(*view.data)>>>{view.data};
+        }
+
+        template<typename Exec, typename T>
+        inline bound_scalar<T> bind(const Exec &, const scalar<T> & node)noexcept{
+            return {node.value};
+        }
+
+        template<typename Exec, typename Op, typename Arg>
+        inline auto bind(const Exec & exec, const unary<Op,Arg> & node)noexcept{
+            return bound_unary<Op,decltype(bind(exec,node.arg))>{node.op,bind(exec,node.arg)};
+        }
+
+        template<typename Exec, typename Op, typename Lhs, typename Rhs>
+        inline auto bind(const Exec & exec, const binary<Op,Lhs,Rhs> & node)noexcept{
+            return bound_binary<Op,decltype(bind(exec,node.lhs)),decltype(bind(exec,node.rhs))>{node.op,bind(exec,node.lhs),bind(exec,node.rhs)};
+        }
+
+        // false if some array in the tree doesn't have n elements
+        template<typename Range>
+        inline bool sizes_match(const array_ref<Range> & node, const std::ptrdiff_t n)noexcept{
+            return static_cast<std::ptrdiff_t>(node.get().size()) == n;
+        }
+
+        template<typename T>
+        inline bool sizes_match(const scalar<T> &, const std::ptrdiff_t)noexcept{
+            return true;
+        }
+
+        template<typename Op, typename Arg>
+        inline bool sizes_match(const unary<Op,Arg> & node, const std::ptrdiff_t n)noexcept{
+            return sizes_match(node.arg,n);
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        inline bool sizes_match(const binary<Op,Lhs,Rhs> & node, const std::ptrdiff_t n)noexcept{
+            return sizes_match(node.lhs,n) && sizes_match(node.rhs,n);
+        }
+
+        template<typename Op, typename L, typename R>
+        inline auto make_binary(const L & lhs, const R & rhs)noexcept{
+            auto l = make_node(lhs);
+            auto r = make_node(rhs);
+            return expression<binary<Op,decltype(l),decltype(r)>>{{Op(),l,r}};
+        }
+    }
+
+    template<typename L, typename R, typename = std::enable_if_t<expr_detail::is_operand_pair_v<L,R>>>
+    inline auto operator +(const L & lhs, const R & rhs)noexcept{
+        return expr_detail::make_binary<std::plus<>>(lhs,rhs);
+    }
+
+    template<typename L, typename R, typename = std::enable_if_t<expr_detail::is_operand_pair_v<L,R>>>
+    inline auto operator -(const L & lhs, const R & rhs)noexcept{
+        return expr_detail::make_binary<std::minus<>>(lhs,rhs);
+    }
+
+    template<typename L, typename R, typename = std::enable_if_t<expr_detail::is_operand_pair_v<L,R>>>
+    inline auto operator *(const L & lhs, const R & rhs)noexcept{
+        return expr_detail::make_binary<std::multiplies<>>(lhs,rhs);
+    }
+
+    template<typename L, typename R, typename = std::enable_if_t<expr_detail::is_operand_pair_v<L,R>>>
+    inline auto operator /(const L & lhs, const R & rhs)noexcept{
+        return expr_detail::make_binary<std::divides<>>(lhs,rhs);
+    }
+
+    template<typename A, typename = std::enable_if_t<expr_detail::is_array_v<A> || expr_detail::is_expression_v<A>>>
+    inline auto operator -(const A & arg)noexcept{
+        auto a = expr_detail::make_node(arg);
+        return expression<expr_detail::unary<std::negate<>,decltype(a)>>{{std::negate<>(),a}};
+    }
+
+    namespace par
+    {
+        // out[i] = expr at i for every element of out, one loop over the whole expression
+        template<typename OutRange, typename Node>
+        inline void assign(const host_space & exec, OutRange && out_range, const expression<Node> & expr)noexcept{
+            const auto out = par_detail::make_view(exec,out_range);
+            const std::ptrdiff_t n = out.size;
+            if (!expr_detail::sizes_match(expr.node,n)){
+                std::cerr<<"Error par::assign() called with an expression whose arrays don't have the destination's size "<<n<<std::endl;
+                return;
+            }
+            const auto e = expr_detail::bind(exec,expr.node);
+            auto * dst = out.data;
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            #pragma omp parallel for simd schedule(static,chunk) if(n > chunk)
+            for (std::ptrdiff_t i = 0; i < n; ++i){
+                dst[i] = e(i);
+            }
+        }
+
+        // the bound tree only holds device pointers and scalars so it goes in firstprivate
+        template<int dev_no, typename OutRange, typename Node>
+        inline void assign(const target_space<dev_no> & exec, OutRange && out_range, const expression<Node> & expr)noexcept{
+            const auto out = par_detail::make_view(exec,out_range);
+            const std::ptrdiff_t n = out.size;
+            if (!expr_detail::sizes_match(expr.node,n)){
+                std::cerr<<"Error par::assign() called with an expression whose arrays don't have the destination's size "<<n<<std::endl;
+                return;
+            }
+            const auto e = expr_detail::bind(exec,expr.node);
+            auto * dst = out.data;
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            #pragma omp target teams distribute parallel for simd dist_schedule(static,chunk) firstprivate(e) is_device_ptr(dst) device(dev_no)
+            for (std::ptrdiff_t i = 0; i < n; ++i){
+                dst[i] = e(i);
+            }
+        }
+    }
+}
+#endif
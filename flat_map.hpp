@@ -0,0 +1,415 @@
+// sorted map with the keys and the values in two dynarrays (so a lookup only touches keys), same batch insert and
+// erase as flat_set, operator () finds a key on the device and gives a pointer to the device copy of its value
+// NOTE! the device copy is only up to date after map_data_to_omp_dev() (or with HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE)
+#pragma once
+
+#ifndef HOPELESS_FLAT_MAP
+#define HOPELESS_FLAT_MAP
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<type_traits>
+#include<memory>
+#include<functional>
+#include<algorithm>
+#include<initializer_list>
+#include<utility>
+#include<iterator>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "flat_set.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename Key, typename T, typename Compare = std::less<Key>, typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY>
+    struct flat_map
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef Compare key_compare;
+        typedef std::ptrdiff_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef dynarray<Key,hopeless::allocator<Key>,OffloadPolicy> key_container_type;
+        typedef dynarray<T,hopeless::allocator<T>,OffloadPolicy> mapped_container_type;
+
+        flat_map()noexcept;
+        explicit flat_map(const Compare & comp)noexcept;
+        flat_map(std::initializer_list<value_type> init, const Compare & comp = Compare())noexcept;
+
+        // device side lookup, the device copy of the value or nullptr
+        #pragma omp declare target
+        inline T * operator ()(const Key & key)const noexcept;
+        #pragma omp end declare target
+
+        inline T & operator [](const Key & key)noexcept;   // inserts T() if key isn't there
+        inline T & at(const Key & key);
+        inline const T & at(const Key & key)const;
+        inline size_type find_index(const Key & key)const noexcept;     // -1 if not there
+        inline bool contains(const Key & key)const noexcept;
+        inline size_type count(const Key & key)const noexcept;
+        inline size_type lower_bound_index(const Key & key)const noexcept;
+
+        constexpr inline const Key & key(const size_type i)const noexcept;     // i-th smallest key and its value
+        constexpr inline T & value(const size_type i)noexcept;
+        constexpr inline const T & value(const size_type i)const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        inline void reserve(size_type new_cap)noexcept;
+        inline void shrink_to_fit()noexcept;
+        inline void clear()noexcept;
+        constexpr inline const key_container_type & keys()const noexcept;
+        constexpr inline const mapped_container_type & values()const noexcept;
+        constexpr inline mapped_container_type & values()noexcept;
+        constexpr inline key_compare key_comp()const noexcept;
+
+        // single pair, O(n), returns false and leaves the stored value alone if the key was there
+        inline bool insert(const Key & key, const T & value)noexcept;
+        inline bool insert_or_assign(const Key & key, const T & value)noexcept;
+        // batch of pairs, sorted once (by key, the first of equal keys wins) and merged in from the back, stored keys are kept
+        template<typename InputIt>
+        inline auto insert(InputIt first, InputIt last)noexcept
+            -> type_<void,
+                decltype(std::declval<InputIt>()->first),
+                decltype(std::declval<InputIt>()->second),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        template<typename Container>
+        inline auto insert_range(const Container & container)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end())>;
+
+        inline size_type erase(const Key & key)noexcept;
+        // batch of keys, one compaction pass over both columns
+        template<typename InputIt>
+        inline auto erase_keys(InputIt first, InputIt last)noexcept
+            -> type_<size_type,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        template<typename Container>
+        inline auto erase_keys(const Container & container)noexcept
+            -> type_<size_type,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end())>;
+
+        inline void map_data_to_omp_dev()noexcept;
+        inline void map_data_from_omp_dev()noexcept;
+
+    private:
+    // member variables
+        key_container_type keys_;
+        mapped_container_type values_;
+        Compare comp_;
+    };
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    flat_map<Key,T,Compare,OffloadPolicy>::flat_map()noexcept
+        :keys_(),
+        values_(),
+        comp_(){}
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    flat_map<Key,T,Compare,OffloadPolicy>::flat_map(const Compare & comp)noexcept
+        :keys_(),
+        values_(),
+        comp_(comp){}
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    flat_map<Key,T,Compare,OffloadPolicy>::flat_map(std::initializer_list<value_type> init, const Compare & comp)noexcept
+        :keys_(),
+        values_(),
+        comp_(comp)
+    {
+        insert(init.begin(),init.end());
+    }
+
+    #pragma omp declare target
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline T * flat_map<Key,T,Compare,OffloadPolicy>::operator ()(const Key & key)const noexcept{
+        size_type n = keys_.size();
+        if (n <= 0){
+            return nullptr;
+        }
+        size_type base = 0;
+        while (n > 1){
+            const size_type half = n / 2;
+            base = comp_(keys_(base + half - 1),key) ? base + half:base;
+            n -= half;
+        }
+        base += static_cast<size_type>(comp_(keys_(base),key));
+        return ((base < keys_.size()) && !comp_(key,keys_(base))) ? &values_(base):nullptr;
+    }
+    #pragma omp end declare target
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline typename flat_map<Key,T,Compare,OffloadPolicy>::size_type
+    flat_map<Key,T,Compare,OffloadPolicy>::lower_bound_index(const Key & key)const noexcept{
+        return flat_detail::lower_bound_index(keys_.data(),keys_.size(),key,comp_);
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline typename flat_map<Key,T,Compare,OffloadPolicy>::size_type
+    flat_map<Key,T,Compare,OffloadPolicy>::find_index(const Key & key)const noexcept{
+        const size_type i = lower_bound_index(key);
+        return ((i < size()) && !comp_(key,keys_.data()[i])) ? i:-1;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline T & flat_map<Key,T,Compare,OffloadPolicy>::operator [](const Key & key)noexcept{
+        const size_type i = lower_bound_index(key);
+        if ((i >= size()) || comp_(key,keys_.data()[i])){
+            keys_.insert(keys_.cbegin() + i,key);
+            values_.insert(values_.cbegin() + i,T());
+        }
+        return values_[i];
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline T & flat_map<Key,T,Compare,OffloadPolicy>::at(const Key & key){
+        const size_type i = find_index(key);
+        if (i < 0){
+            std::cerr<<"Error flat_map at() called with a key that isn't stored"<<std::endl;
+            throw std::out_of_range("Key passed to at() not found");
+        }
+        return values_[i];
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline const T & flat_map<Key,T,Compare,OffloadPolicy>::at(const Key & key)const{
+        const size_type i = find_index(key);
+        if (i < 0){
+            std::cerr<<"Error flat_map at() called with a key that isn't stored"<<std::endl;
+            throw std::out_of_range("Key passed to at() not found");
+        }
+        return values_.data()[i];
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline bool flat_map<Key,T,Compare,OffloadPolicy>::contains(const Key & key)const noexcept{
+        return (find_index(key) >= 0);
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline typename flat_map<Key,T,Compare,OffloadPolicy>::size_type
+    flat_map<Key,T,Compare,OffloadPolicy>::count(const Key & key)const noexcept{
+        return static_cast<size_type>(contains(key));
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline const Key & flat_map<Key,T,Compare,OffloadPolicy>::key(const size_type i)const noexcept{
+        return keys_.data()[i];
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline T & flat_map<Key,T,Compare,OffloadPolicy>::value(const size_type i)noexcept{
+        return values_[i];
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline const T & flat_map<Key,T,Compare,OffloadPolicy>::value(const size_type i)const noexcept{
+        return values_.data()[i];
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline bool flat_map<Key,T,Compare,OffloadPolicy>::empty()const noexcept{
+        return keys_.empty();
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline typename flat_map<Key,T,Compare,OffloadPolicy>::size_type
+    flat_map<Key,T,Compare,OffloadPolicy>::size()const noexcept{
+        return keys_.size();
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline void flat_map<Key,T,Compare,OffloadPolicy>::reserve(size_type new_cap)noexcept{
+        keys_.reserve(new_cap);
+        values_.reserve(new_cap);
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline void flat_map<Key,T,Compare,OffloadPolicy>::shrink_to_fit()noexcept{
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline void flat_map<Key,T,Compare,OffloadPolicy>::clear()noexcept{
+        keys_.clear();
+        values_.clear();
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline const typename flat_map<Key,T,Compare,OffloadPolicy>::key_container_type &
+    flat_map<Key,T,Compare,OffloadPolicy>::keys()const noexcept{
+        return keys_;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline const typename flat_map<Key,T,Compare,OffloadPolicy>::mapped_container_type &
+    flat_map<Key,T,Compare,OffloadPolicy>::values()const noexcept{
+        return values_;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline typename flat_map<Key,T,Compare,OffloadPolicy>::mapped_container_type &
+    flat_map<Key,T,Compare,OffloadPolicy>::values()noexcept{
+        return values_;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    constexpr inline typename flat_map<Key,T,Compare,OffloadPolicy>::key_compare
+    flat_map<Key,T,Compare,OffloadPolicy>::key_comp()const noexcept{
+        return comp_;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline bool flat_map<Key,T,Compare,OffloadPolicy>::insert(const Key & key, const T & value)noexcept{
+        const size_type i = lower_bound_index(key);
+        if ((i < size()) && !comp_(key,keys_.data()[i])){
+            return false;
+        }
+        keys_.insert(keys_.cbegin() + i,key);
+        values_.insert(values_.cbegin() + i,value);
+        return true;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline bool flat_map<Key,T,Compare,OffloadPolicy>::insert_or_assign(const Key & key, const T & value)noexcept{
+        const size_type i = lower_bound_index(key);
+        if ((i < size()) && !comp_(key,keys_.data()[i])){
+            values_[i] = value;
+            return false;
+        }
+        keys_.insert(keys_.cbegin() + i,key);
+        values_.insert(values_.cbegin() + i,value);
+        return true;
+    }
+
+    // the pairs are split into a key and a value column and sorted through an index permutation,
+    // then both stored columns are merged from the back with the flat_set merge
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    template<typename InputIt>
+    inline auto flat_map<Key,T,Compare,OffloadPolicy>::insert(InputIt first, InputIt last)noexcept
+        -> type_<void,
+            decltype(std::declval<InputIt>()->first),
+            decltype(std::declval<InputIt>()->second),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        dynarray<Key,hopeless::allocator<Key>,host_only> batch_keys;
+        dynarray<T,hopeless::allocator<T>,host_only> batch_values;
+        for (; first != last; ++first){
+            batch_keys.push_back(first->first);
+            batch_values.push_back(first->second);
+        }
+        const size_type count = batch_keys.size();
+        if (count == 0){
+            return;
+        }
+        dynarray<size_type,hopeless::allocator<size_type>,host_only> order(count,hopeless::for_overwrite);
+        const size_type m = flat_detail::sort_unique_order(batch_keys.data(),order.data(),count,comp_);
+        // the merge reads the batch keys in order
+        dynarray<Key,hopeless::allocator<Key>,host_only> sorted_keys;
+        sorted_keys.reserve(m);
+        for (size_type j = 0; j < m; ++j){
+            sorted_keys.push_back(batch_keys[order[j]]);
+        }
+        const size_type old_size = size();
+        const size_type added = flat_detail::count_new(keys_.data(),old_size,sorted_keys.data(),m,comp_);
+        if (added == 0){
+            return;
+        }
+        keys_.resize(old_size + added);
+        values_.resize(old_size + added);
+        T * values = values_.data();
+        flat_detail::merge_sorted(keys_.data(),old_size,added,sorted_keys.data(),m,comp_,
+            [values](const size_type to, const size_type from){values[to] = std::move(values[from]);},
+            [values,&batch_values,&order](const size_type to, const size_type j){values[to] = batch_values[order[j]];});
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    template<typename Container>
+    inline auto flat_map<Key,T,Compare,OffloadPolicy>::insert_range(const Container & container)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end())>
+    {
+        insert(container.begin(),container.end());
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline typename flat_map<Key,T,Compare,OffloadPolicy>::size_type
+    flat_map<Key,T,Compare,OffloadPolicy>::erase(const Key & key)noexcept{
+        const size_type i = find_index(key);
+        if (i < 0){
+            return 0;
+        }
+        keys_.erase(keys_.cbegin() + i);
+        values_.erase(values_.cbegin() + i);
+        return 1;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    template<typename InputIt>
+    inline auto flat_map<Key,T,Compare,OffloadPolicy>::erase_keys(InputIt first, InputIt last)noexcept
+        -> type_<size_type,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        dynarray<Key,hopeless::allocator<Key>,host_only> batch;
+        batch.append_range(first,last);
+        if (batch.empty() || empty()){
+            return 0;
+        }
+        const size_type m = flat_detail::sort_unique(batch.data(),batch.size(),comp_);
+        const size_type old_size = size();
+        T * values = values_.data();
+        const size_type w = flat_detail::erase_sorted(keys_.data(),old_size,batch.data(),m,comp_,
+            [values](const size_type to, const size_type from){values[to] = std::move(values[from]);});
+        keys_.resize(w);
+        values_.resize(w);
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+        return old_size - w;
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    template<typename Container>
+    inline auto flat_map<Key,T,Compare,OffloadPolicy>::erase_keys(const Container & container)noexcept
+        -> type_<size_type,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end())>
+    {
+        return erase_keys(container.begin(),container.end());
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline void flat_map<Key,T,Compare,OffloadPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            keys_.map_data_to_omp_dev();
+            values_.map_data_to_omp_dev();
+        }
+    }
+
+    template<typename Key, typename T, typename Compare, typename OffloadPolicy>
+    inline void flat_map<Key,T,Compare,OffloadPolicy>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            keys_.map_data_from_omp_dev();
+            values_.map_data_from_omp_dev();
+        }
+    }
+}
+#endif
@@ -0,0 +1,495 @@
+// sorted set of unique keys stored in one dynarray, lookups are a branchless binary search on the host ([] style
+// functions) and on the device (operator ()), batches are inserted with one sort and one backward merge in place
+// and erased with one compaction pass
+// NOTE! the device copy is only up to date after map_data_to_omp_dev() (or with HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE)
+#pragma once
+
+#ifndef HOPELESS_FLAT_SET
+#define HOPELESS_FLAT_SET
+
+#include<iostream>
+#include<cstddef>
+#include<type_traits>
+#include<memory>
+#include<functional>
+#include<algorithm>
+#include<initializer_list>
+#include<utility>
+#include<iterator>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    namespace flat_detail{
+        // first index in [0,n) with !comp(keys[i],key), n if none, the loop has no data dependent branch
+        template<typename Key, typename Compare>
+        constexpr inline std::ptrdiff_t lower_bound_index(const Key * keys, std::ptrdiff_t n, const Key & key, const Compare & comp)noexcept{
+            if (n <= 0){
+                return 0;
+            }
+            std::ptrdiff_t base = 0;
+            while (n > 1){
+                const std::ptrdiff_t half = n / 2;
+                base = comp(keys[base + half - 1],key) ? base + half:base;
+                n -= half;
+            }
+            return base + static_cast<std::ptrdiff_t>(comp(keys[base],key));
+        }
+
+        // sort the batch and drop keys that compare equal, returns the new batch length
+        template<typename Key, typename Compare>
+        inline std::ptrdiff_t sort_unique(Key * batch, std::ptrdiff_t n, const Compare & comp)noexcept{
+            std::stable_sort(batch,batch + n,comp);
+            return std::unique(batch,batch + n,[&comp](const Key & a, const Key & b){return !comp(a,b) && !comp(b,a);}) - batch;
+        }
+
+        // number of keys of the sorted batch that aren't in the sorted keys
+        template<typename Key, typename Compare>
+        inline std::ptrdiff_t count_new(const Key * keys, std::ptrdiff_t n, const Key * batch, std::ptrdiff_t m, const Compare & comp)noexcept{
+            std::ptrdiff_t i = 0;
+            std::ptrdiff_t found = 0;
+            for (std::ptrdiff_t j = 0; j < m; ++j){
+                while ((i < n) && comp(keys[i],batch[j])){
+                    ++i;
+                }
+                found += static_cast<std::ptrdiff_t>((i < n) && !comp(batch[j],keys[i]));
+            }
+            return m - found;
+        }
+
+        // like sort_unique but sorts the indices in order instead of the batch (so other columns can follow),
+        // the first of keys that compare equal is kept, returns how many indices are left
+        template<typename Key, typename Compare>
+        inline std::ptrdiff_t sort_unique_order(const Key * batch, std::ptrdiff_t * order, std::ptrdiff_t n, const Compare & comp)noexcept{
+            for (std::ptrdiff_t k = 0; k < n; ++k){
+                order[k] = k;
+            }
+            std::stable_sort(order,order + n,[batch,&comp](const std::ptrdiff_t a, const std::ptrdiff_t b){return comp(batch[a],batch[b]);});
+            std::ptrdiff_t m = 0;
+            for (std::ptrdiff_t k = 0; k < n; ++k){
+                if ((m == 0) || comp(batch[order[m-1]],batch[order[k]])){
+                    order[m++] = order[k];
+                }
+            }
+            return m;
+        }
+
+        // merge the sorted unique batch into keys[0,n), keys has room for the added = count_new(...) new ones,
+        // walked from the back so every stored key moves straight to its final slot,
+        // move(to,from) and put(to,j) are called for every key moved and every batch[j] stored so a parallel column can follow
+        template<typename Key, typename Compare, typename Move, typename Put>
+        inline void merge_sorted(Key * keys, std::ptrdiff_t n, std::ptrdiff_t added, const Key * batch, std::ptrdiff_t m,
+            const Compare & comp, Move && move, Put && put)noexcept{
+            std::ptrdiff_t i = n - 1;
+            std::ptrdiff_t w = n + added - 1;
+            for (std::ptrdiff_t j = m - 1; j >= 0; --j){
+                while ((i >= 0) && comp(batch[j],keys[i])){
+                    keys[w] = std::move(keys[i]);
+                    move(w,i);
+                    --w;
+                    --i;
+                }
+                if ((i >= 0) && !comp(keys[i],batch[j])){
+                    continue;   // already stored
+                }
+                keys[w] = batch[j];
+                put(w,j);
+                --w;
+            }
+        }
+
+        // drop the keys of keys[0,n) that are in the sorted batch in one forward pass, returns how many are left,
+        // move(to,from) is called for every key moved so a parallel column can follow
+        template<typename Key, typename Compare, typename Move>
+        inline std::ptrdiff_t erase_sorted(Key * keys, std::ptrdiff_t n, const Key * batch, std::ptrdiff_t m,
+            const Compare & comp, Move && move)noexcept{
+            std::ptrdiff_t w = 0;
+            std::ptrdiff_t j = 0;
+            for (std::ptrdiff_t r = 0; r < n; ++r){
+                while ((j < m) && comp(batch[j],keys[r])){
+                    ++j;
+                }
+                if ((j < m) && !comp(keys[r],batch[j])){
+                    continue;
+                }
+                if (w != r){
+                    keys[w] = std::move(keys[r]);
+                    move(w,r);
+                }
+                ++w;
+            }
+            return w;
+        }
+    }
+
+    template<typename Key, typename Compare = std::less<Key>, typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY>
+    struct flat_set
+    {
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef Compare key_compare;
+        typedef std::ptrdiff_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef dynarray<Key,hopeless::allocator<Key>,OffloadPolicy> container_type;
+        typedef typename container_type::const_iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+
+        flat_set()noexcept;
+        explicit flat_set(const Compare & comp)noexcept;
+        flat_set(std::initializer_list<Key> init, const Compare & comp = Compare())noexcept;
+        template<typename InputIt>
+        flat_set(type_<InputIt,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>())> first,
+            InputIt last, const Compare & comp = Compare())noexcept;
+
+        // device side lookup, index of key in the device copy or -1
+        #pragma omp declare target
+        inline size_type operator ()(const Key & key)const noexcept;
+        #pragma omp end declare target
+
+        constexpr inline const Key & operator [](const size_type i)const noexcept;   // i-th smallest key
+        inline size_type find_index(const Key & key)const noexcept;     // -1 if not there
+        inline const_iterator find(const Key & key)const noexcept;
+        inline bool contains(const Key & key)const noexcept;
+        inline size_type count(const Key & key)const noexcept;
+        inline size_type lower_bound_index(const Key & key)const noexcept;
+        inline const_iterator lower_bound(const Key & key)const noexcept;
+        inline const_iterator upper_bound(const Key & key)const noexcept;
+
+        inline const_iterator begin()const noexcept;
+        inline const_iterator cbegin()const noexcept;
+        inline const_iterator end()const noexcept;
+        inline const_iterator cend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        inline void reserve(size_type new_cap)noexcept;
+        inline void shrink_to_fit()noexcept;
+        inline void clear()noexcept;
+        constexpr inline const container_type & keys()const noexcept;
+        constexpr inline key_compare key_comp()const noexcept;
+
+        // single key, O(n) like dynarray::insert, returns false if it was already there
+        inline bool insert(const Key & key)noexcept;
+        // batch, the keys are sorted once and merged in from the back so every stored key moves at most once
+        template<typename InputIt>
+        inline auto insert(InputIt first, InputIt last)noexcept
+            -> type_<void,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        template<typename Container>
+        inline auto insert_range(const Container & container)noexcept
+            -> type_<void,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end())>;
+
+        inline size_type erase(const Key & key)noexcept;
+        // batch, one compaction pass over the stored keys
+        template<typename InputIt>
+        inline auto erase_keys(InputIt first, InputIt last)noexcept
+            -> type_<size_type,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        template<typename Container>
+        inline auto erase_keys(const Container & container)noexcept
+            -> type_<size_type,
+                decltype(std::declval<Container>().begin()),
+                decltype(std::declval<Container>().end())>;
+
+        inline void map_data_to_omp_dev()noexcept;
+        inline void map_data_from_omp_dev()noexcept;
+
+    private:
+        inline void merge_sorted_batch(const Key * batch, size_type m)noexcept;
+        inline size_type erase_sorted_batch(const Key * batch, size_type m)noexcept;
+
+    // member variables
+        container_type keys_;
+        Compare comp_;
+    };
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    flat_set<Key,Compare,OffloadPolicy>::flat_set()noexcept
+        :keys_(),
+        comp_(){}
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    flat_set<Key,Compare,OffloadPolicy>::flat_set(const Compare & comp)noexcept
+        :keys_(),
+        comp_(comp){}
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    flat_set<Key,Compare,OffloadPolicy>::flat_set(std::initializer_list<Key> init, const Compare & comp)noexcept
+        :keys_(),
+        comp_(comp)
+    {
+        insert(init.begin(),init.end());
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    template<typename InputIt>
+    flat_set<Key,Compare,OffloadPolicy>::flat_set(type_<InputIt,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>())> first,
+        InputIt last, const Compare & comp)noexcept
+        :keys_(),
+        comp_(comp)
+    {
+        insert(first,last);
+    }
+
+    #pragma omp declare target
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::operator ()(const Key & key)const noexcept{
+        size_type n = keys_.size();
+        if (n <= 0){
+            return -1;
+        }
+        size_type base = 0;
+        while (n > 1){
+            const size_type half = n / 2;
+            base = comp_(keys_(base + half - 1),key) ? base + half:base;
+            n -= half;
+        }
+        base += static_cast<size_type>(comp_(keys_(base),key));
+        return ((base < keys_.size()) && !comp_(key,keys_(base))) ? base:-1;
+    }
+    #pragma omp end declare target
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    constexpr inline const Key & flat_set<Key,Compare,OffloadPolicy>::operator [](const size_type i)const noexcept{
+        return keys_.data()[i];
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::lower_bound_index(const Key & key)const noexcept{
+        return flat_detail::lower_bound_index(keys_.data(),keys_.size(),key,comp_);
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::find_index(const Key & key)const noexcept{
+        const size_type i = lower_bound_index(key);
+        return ((i < size()) && !comp_(key,keys_.data()[i])) ? i:-1;
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::find(const Key & key)const noexcept{
+        const size_type i = find_index(key);
+        return (i < 0) ? cend():cbegin() + i;
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline bool flat_set<Key,Compare,OffloadPolicy>::contains(const Key & key)const noexcept{
+        return (find_index(key) >= 0);
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::count(const Key & key)const noexcept{
+        return static_cast<size_type>(contains(key));
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::lower_bound(const Key & key)const noexcept{
+        return cbegin() + lower_bound_index(key);
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::upper_bound(const Key & key)const noexcept{
+        const size_type i = lower_bound_index(key);
+        return cbegin() + i + static_cast<size_type>((i < size()) && !comp_(key,keys_.data()[i]));
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::begin()const noexcept{
+        return keys_.cbegin();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::cbegin()const noexcept{
+        return keys_.cbegin();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::end()const noexcept{
+        return keys_.cend();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::const_iterator
+    flat_set<Key,Compare,OffloadPolicy>::cend()const noexcept{
+        return keys_.cend();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    constexpr inline bool flat_set<Key,Compare,OffloadPolicy>::empty()const noexcept{
+        return keys_.empty();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    constexpr inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::size()const noexcept{
+        return keys_.size();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline void flat_set<Key,Compare,OffloadPolicy>::reserve(size_type new_cap)noexcept{
+        keys_.reserve(new_cap);
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline void flat_set<Key,Compare,OffloadPolicy>::shrink_to_fit()noexcept{
+        keys_.shrink_to_fit();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline void flat_set<Key,Compare,OffloadPolicy>::clear()noexcept{
+        keys_.clear();
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    constexpr inline const typename flat_set<Key,Compare,OffloadPolicy>::container_type &
+    flat_set<Key,Compare,OffloadPolicy>::keys()const noexcept{
+        return keys_;
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    constexpr inline typename flat_set<Key,Compare,OffloadPolicy>::key_compare
+    flat_set<Key,Compare,OffloadPolicy>::key_comp()const noexcept{
+        return comp_;
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline bool flat_set<Key,Compare,OffloadPolicy>::insert(const Key & key)noexcept{
+        const size_type i = lower_bound_index(key);
+        if ((i < size()) && !comp_(key,keys_.data()[i])){
+            return false;
+        }
+        keys_.insert(keys_.cbegin() + i,key);
+        return true;
+    }
+
+    // batch is sorted and unique, the stored keys are walked from the back and each one moves straight to its final slot
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline void flat_set<Key,Compare,OffloadPolicy>::merge_sorted_batch(const Key * batch, size_type m)noexcept{
+        const size_type old_size = size();
+        const size_type added = flat_detail::count_new(keys_.data(),old_size,batch,m,comp_);
+        if (added == 0){
+            return;
+        }
+        keys_.resize(old_size + added);
+        flat_detail::merge_sorted(keys_.data(),old_size,added,batch,m,comp_,[](size_type, size_type){},[](size_type, size_type){});
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    template<typename InputIt>
+    inline auto flat_set<Key,Compare,OffloadPolicy>::insert(InputIt first, InputIt last)noexcept
+        -> type_<void,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        dynarray<Key,hopeless::allocator<Key>,host_only> batch;
+        batch.append_range(first,last);
+        if (batch.empty()){
+            return;
+        }
+        const size_type m = flat_detail::sort_unique(batch.data(),batch.size(),comp_);
+        merge_sorted_batch(batch.data(),m);
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    template<typename Container>
+    inline auto flat_set<Key,Compare,OffloadPolicy>::insert_range(const Container & container)noexcept
+        -> type_<void,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end())>
+    {
+        insert(container.begin(),container.end());
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::erase(const Key & key)noexcept{
+        const size_type i = find_index(key);
+        if (i < 0){
+            return 0;
+        }
+        keys_.erase(keys_.cbegin() + i);
+        return 1;
+    }
+
+    // batch is sorted, one forward pass keeps everything not in it
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline typename flat_set<Key,Compare,OffloadPolicy>::size_type
+    flat_set<Key,Compare,OffloadPolicy>::erase_sorted_batch(const Key * batch, size_type m)noexcept{
+        const size_type old_size = size();
+        const size_type w = flat_detail::erase_sorted(keys_.data(),old_size,batch,m,comp_,[](size_type, size_type){});
+        keys_.resize(w);
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+        return old_size - w;
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    template<typename InputIt>
+    inline auto flat_set<Key,Compare,OffloadPolicy>::erase_keys(InputIt first, InputIt last)noexcept
+        -> type_<size_type,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        dynarray<Key,hopeless::allocator<Key>,host_only> batch;
+        batch.append_range(first,last);
+        if (batch.empty() || empty()){
+            return 0;
+        }
+        const size_type m = flat_detail::sort_unique(batch.data(),batch.size(),comp_);
+        return erase_sorted_batch(batch.data(),m);
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    template<typename Container>
+    inline auto flat_set<Key,Compare,OffloadPolicy>::erase_keys(const Container & container)noexcept
+        -> type_<size_type,
+            decltype(std::declval<Container>().begin()),
+            decltype(std::declval<Container>().end())>
+    {
+        return erase_keys(container.begin(),container.end());
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline void flat_set<Key,Compare,OffloadPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            keys_.map_data_to_omp_dev();
+        }
+    }
+
+    template<typename Key, typename Compare, typename OffloadPolicy>
+    inline void flat_set<Key,Compare,OffloadPolicy>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            keys_.map_data_from_omp_dev();
+        }
+    }
+}
+#endif
@@ -0,0 +1,699 @@
+// resizable array with a movable gap of free capacity, for repeated inserts and erases around a cursor
+// the elements are [0,gap_begin) and [gap_end,capacity) of the buffer, an insert or erase at the gap is O(1) and
+// moving the gap only moves the elements between the old and new position (one memmove)
+// the device can't see a split buffer so compact() moves the gap to the end and hands back a contiguous span,
+// map_data_to_omp_dev() compacts and copies that span, operator () indexes the device copy
+// NOTE! iterators aren't meant for the device
+#pragma once
+
+#ifndef HOPELESS_GAP_BUFFER
+#define HOPELESS_GAP_BUFFER
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<cstring>
+#include<type_traits>
+#include<memory>
+#include<initializer_list>
+#include<utility>
+#include<iterator>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "growth_policy.hpp"
+#include "offload_policy.hpp"
+#include "dyn_extent_span.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename T, typename Allocator = hopeless::allocator<T>,
+                        typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY,
+                        typename GrowthPolicy = HOPELESS_DYNARRAY_DEFAULT_GROWTH_POLICY>
+    struct gap_buffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+    public:
+        template<bool is_const> struct gap_iterator;
+
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::ptrdiff_t size_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef gap_iterator<false> iterator;
+        typedef gap_iterator<true> const_iterator;
+        typedef typename std::reverse_iterator<iterator> reverse_iterator;
+        typedef typename std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        // the container and a logical index, the gap is skipped by the indexing
+        template<bool is_const>
+        struct gap_iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::conditional_t<is_const,const T&,T&> reference;
+            typedef std::conditional_t<is_const,const T*,T*> pointer;
+            typedef std::ptrdiff_t difference_type;
+            typedef std::conditional_t<is_const,const gap_buffer,gap_buffer> container_type;
+        protected:
+            container_type * buf;
+            difference_type pos;
+        public:
+            constexpr gap_iterator()noexcept:buf(nullptr),pos(0){}
+            constexpr gap_iterator(container_type * container, difference_type i)noexcept:buf(container),pos(i){}
+            template<bool other_const, typename = std::enable_if_t<is_const && !other_const>>
+            constexpr gap_iterator(const gap_iterator<other_const> & it)noexcept:buf(it.container()),pos(it.index()){}
+
+            inline gap_iterator & operator ++()noexcept{++pos;return *this;}
+            inline gap_iterator  operator ++(int)noexcept{auto temp = *this; ++pos; return temp;}
+            inline gap_iterator & operator --()noexcept{--pos;return *this;}
+            inline gap_iterator  operator --(int)noexcept{auto temp = *this; --pos; return temp;}
+            inline gap_iterator & operator +=(const difference_type n)noexcept{pos+=n;return *this;}
+            inline gap_iterator & operator -=(const difference_type n)noexcept{pos-=n;return *this;}
+            inline gap_iterator  operator +(const difference_type n)const noexcept{return gap_iterator(buf,pos + n);}
+            inline gap_iterator  operator -(const difference_type n)const noexcept{return gap_iterator(buf,pos - n);}
+            inline friend gap_iterator operator +(const difference_type n, const gap_iterator it)noexcept{return gap_iterator(it.buf,it.pos + n);}
+
+            inline reference operator *()const noexcept{return (*buf)[pos];}
+            inline pointer operator ->()const noexcept{return &(*buf)[pos];}
+            inline reference operator [](const difference_type n)const noexcept{return (*buf)[pos + n];}
+
+            constexpr inline container_type * container()const noexcept{return buf;}
+            constexpr inline difference_type index()const noexcept{return pos;}
+
+            inline friend bool operator > (const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos>rhs.pos);}
+            inline friend bool operator < (const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos<rhs.pos);}
+            inline friend bool operator != (const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos!=rhs.pos);}
+            inline friend bool operator == (const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos==rhs.pos);}
+            inline friend bool operator >= (const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos>=rhs.pos);}
+            inline friend bool operator <= (const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos<=rhs.pos);}
+            inline friend difference_type operator -(const gap_iterator lhs, const gap_iterator rhs)noexcept{return (lhs.pos - rhs.pos);}
+        };
+
+        constexpr inline reference operator [](const size_type i)noexcept;
+        constexpr inline const_reference operator [](const size_type i)const noexcept;
+        // device copy, valid after map_data_to_omp_dev() and until the next change on the host
+        #pragma omp declare target
+        constexpr inline reference operator ()(const size_type i)const noexcept;
+        #pragma omp end declare target
+
+        gap_buffer()noexcept;
+        explicit gap_buffer(size_type count, const T& value = T())noexcept;
+        gap_buffer(std::initializer_list<T> init)noexcept;
+        gap_buffer(const gap_buffer & other)noexcept;
+        gap_buffer(gap_buffer && other)noexcept;
+        ~gap_buffer()noexcept;
+
+        gap_buffer& operator =(const gap_buffer & other)noexcept;
+        gap_buffer& operator =(gap_buffer && other)noexcept;
+        void swap(gap_buffer & rhs)noexcept;
+
+        inline reference at(size_type pos);
+        inline const_reference at(size_type pos)const;
+        constexpr inline reference front()noexcept;
+        constexpr inline const_reference front()const noexcept;
+        constexpr inline reference back()noexcept;
+        constexpr inline const_reference back()const noexcept;
+
+        inline iterator begin()noexcept;
+        inline const_iterator begin()const noexcept;
+        inline const_iterator cbegin()const noexcept;
+        inline iterator end()noexcept;
+        inline const_iterator end()const noexcept;
+        inline const_iterator cend()const noexcept;
+        inline reverse_iterator rbegin()noexcept;
+        inline const_reverse_iterator rbegin()const noexcept;
+        inline reverse_iterator rend()noexcept;
+        inline const_reverse_iterator rend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;
+        constexpr inline size_type cursor()const noexcept;     // logical index the gap sits in front of
+        constexpr inline size_type gap_size()const noexcept;
+
+        inline void move_cursor(size_type pos)noexcept;    // move the gap so the next insert at pos is O(1)
+        inline void reserve(size_type new_cap)noexcept;
+        inline void shrink_to_fit()noexcept;
+        inline void clear()noexcept;
+
+        // every insert and erase first moves the gap to the position, the ones after are then local
+        inline iterator insert(const_iterator pos, const T& value)noexcept;
+        inline iterator insert(const_iterator pos, size_type count, const T& value)noexcept;
+        template<typename InputIt>
+        inline auto insert(const_iterator pos, InputIt first, InputIt last)noexcept
+            -> type_<iterator,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        inline iterator erase(const_iterator pos)noexcept;
+        inline iterator erase(const_iterator first, const_iterator last)noexcept;
+        inline void push_back(const T& value)noexcept;
+        inline void pop_back()noexcept;
+        inline void resize(size_type new_size, const T& value = T())noexcept;
+
+        // move the gap to the end, the elements are then [data(),data()+size()) until the next insert or erase away from the end
+        inline dyn_extent_span<T> compact()noexcept;
+        constexpr inline T* data()noexcept;     // only contiguous right after compact()
+
+        // compact and copy everything to (or from) the device, host_only does nothing
+        inline void map_data_to_omp_dev()noexcept;
+        inline void map_data_from_omp_dev()noexcept;
+        constexpr inline dyn_extent_span<T> device_span()const noexcept;    // the device copy, for passing to target regions
+
+    private:
+        constexpr inline size_type physical(const size_type i)const noexcept;
+        inline bool open_gap(size_type count)noexcept;     // make sure the gap holds at least count, moves the tail once
+        inline void dev_buffer_resize()noexcept;
+        inline void free_dev_buffer()noexcept;
+
+    // member variables
+        T * data_buffer_;
+        T * device_data_buffer_;
+        size_type gap_begin_;
+        size_type gap_end_;
+        size_type capacity_;
+        size_type device_capacity_;
+        allocator_type alloc_;
+    };
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::physical(const size_type i)const noexcept{
+        return (i < gap_begin_) ? i:i + (gap_end_ - gap_begin_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::operator [](const size_type i)noexcept{
+        return data_buffer_[physical(i)];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::operator [](const size_type i)const noexcept{
+        return data_buffer_[physical(i)];
+    }
+
+    #pragma omp declare target
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::operator ()(const size_type i)const noexcept{
+        return device_data_buffer_[i];
+    }
+    #pragma omp end declare target
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::gap_buffer()noexcept
+        :data_buffer_(nullptr),
+        device_data_buffer_(nullptr),
+        gap_begin_(0),
+        gap_end_(0),
+        capacity_(0),
+        device_capacity_(0),
+        alloc_(){}
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::gap_buffer(size_type count, const T& value)noexcept
+        :gap_buffer()
+    {
+        resize(count,value);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::gap_buffer(std::initializer_list<T> init)noexcept
+        :gap_buffer()
+    {
+        insert(cend(),init.begin(),init.end());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::gap_buffer(const gap_buffer & other)noexcept
+        :gap_buffer()
+    {
+        *this = other;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::gap_buffer(gap_buffer && other)noexcept
+        :gap_buffer()
+    {
+        swap(other);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::~gap_buffer()noexcept{
+        free_dev_buffer();
+        std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>&
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::operator =(const gap_buffer & other)noexcept{
+        if (this == &other){
+            return *this;
+        }
+        clear();
+        if (!open_gap(other.size())){
+            return *this;
+        }
+        // the gap is at 0 after clear(), copy the two halves of other in front of the tail
+        const size_type front_count = other.gap_begin_;
+        const size_type back_count = other.capacity_ - other.gap_end_;
+        std::memcpy(static_cast<void*>(data_buffer_),static_cast<const void*>(other.data_buffer_),sizeof(T)*front_count);
+        std::memcpy(static_cast<void*>(data_buffer_ + front_count),static_cast<const void*>(other.data_buffer_ + other.gap_end_),sizeof(T)*back_count);
+        gap_begin_ = front_count + back_count;
+        return *this;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>&
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::operator =(gap_buffer && other)noexcept{
+        if (this != &other){
+            gap_buffer temp;
+            swap(other);
+            other.swap(temp);
+        }
+        return *this;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::swap(gap_buffer & rhs)noexcept{
+        using std::swap;
+        swap(data_buffer_,rhs.data_buffer_);
+        swap(device_data_buffer_,rhs.device_data_buffer_);
+        swap(gap_begin_,rhs.gap_begin_);
+        swap(gap_end_,rhs.gap_end_);
+        swap(capacity_,rhs.capacity_);
+        swap(device_capacity_,rhs.device_capacity_);
+        swap(alloc_,rhs.alloc_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::at(size_type pos){
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error gap_buffer indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::at(size_type pos)const{
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error gap_buffer indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::front()noexcept{
+        return (*this)[0];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::front()const noexcept{
+        return (*this)[0];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::back()noexcept{
+        return (*this)[size()-1];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::back()const noexcept{
+        return (*this)[size()-1];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::begin()noexcept{
+        return iterator(this,0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::begin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::cbegin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::end()noexcept{
+        return iterator(this,size());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::end()const noexcept{
+        return const_iterator(this,size());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::cend()const noexcept{
+        return const_iterator(this,size());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reverse_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::rbegin()noexcept{
+        return reverse_iterator(end());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_reverse_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::rbegin()const noexcept{
+        return const_reverse_iterator(end());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reverse_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::rend()noexcept{
+        return reverse_iterator(begin());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::const_reverse_iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::rend()const noexcept{
+        return const_reverse_iterator(begin());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline bool gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::empty()const noexcept{
+        return (size() == 0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::size()const noexcept{
+        return capacity_ - (gap_end_ - gap_begin_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::capacity()const noexcept{
+        return capacity_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::cursor()const noexcept{
+        return gap_begin_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::gap_size()const noexcept{
+        return gap_end_ - gap_begin_;
+    }
+
+    // only the elements between the old and the new cursor cross the gap
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::move_cursor(size_type pos)noexcept{
+        if (pos < gap_begin_){
+            const size_type count = gap_begin_ - pos;
+            std::memmove(static_cast<void*>(data_buffer_ + gap_end_ - count),static_cast<const void*>(data_buffer_ + pos),sizeof(T)*count);
+            gap_begin_ -= count;
+            gap_end_ -= count;
+        }else if (pos > gap_begin_){
+            const size_type count = pos - gap_begin_;
+            std::memmove(static_cast<void*>(data_buffer_ + gap_begin_),static_cast<const void*>(data_buffer_ + gap_end_),sizeof(T)*count);
+            gap_begin_ += count;
+            gap_end_ += count;
+        }
+    }
+
+    // grows through GrowthPolicy, the new buffer has the gap where the old one had it
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline bool gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::open_gap(size_type count)noexcept{
+        if (gap_end_ - gap_begin_ >= count){
+            return true;
+        }
+        const size_type new_cap = GrowthPolicy::next_capacity(capacity_,size() + count,sizeof(T));
+        T * temp = std::allocator_traits<allocator_type>::allocate(alloc_,new_cap);
+        if (!temp){
+            std::cerr<<"ERROR gap_buffer failed to allocate memory"<<std::endl;
+            return false;
+        }
+        const size_type back_count = capacity_ - gap_end_;
+        if (data_buffer_){
+            std::memcpy(static_cast<void*>(temp),static_cast<const void*>(data_buffer_),sizeof(T)*gap_begin_);
+            std::memcpy(static_cast<void*>(temp + new_cap - back_count),static_cast<const void*>(data_buffer_ + gap_end_),sizeof(T)*back_count);
+        }
+        std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+        data_buffer_ = temp;
+        gap_end_ = new_cap - back_count;
+        capacity_ = new_cap;
+        return true;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::reserve(size_type new_cap)noexcept{
+        if (new_cap > capacity_){
+            // exact, open_gap would round up through the growth policy
+            T * temp = std::allocator_traits<allocator_type>::allocate(alloc_,new_cap);
+            if (!temp){
+                std::cerr<<"ERROR gap_buffer failed to allocate memory"<<std::endl;
+                return;
+            }
+            const size_type back_count = capacity_ - gap_end_;
+            if (data_buffer_){
+                std::memcpy(static_cast<void*>(temp),static_cast<const void*>(data_buffer_),sizeof(T)*gap_begin_);
+                std::memcpy(static_cast<void*>(temp + new_cap - back_count),static_cast<const void*>(data_buffer_ + gap_end_),sizeof(T)*back_count);
+            }
+            std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+            data_buffer_ = temp;
+            gap_end_ = new_cap - back_count;
+            capacity_ = new_cap;
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::shrink_to_fit()noexcept{
+        const size_type count = size();
+        if (count == capacity_){
+            return;
+        }
+        compact();
+        T * temp = nullptr;
+        if (count > 0){
+            temp = std::allocator_traits<allocator_type>::allocate(alloc_,count);
+            if (!temp){
+                std::cerr<<"ERROR gap_buffer failed to allocate memory"<<std::endl;
+                return;
+            }
+            std::memcpy(static_cast<void*>(temp),static_cast<const void*>(data_buffer_),sizeof(T)*count);
+        }
+        std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+        data_buffer_ = temp;
+        capacity_ = count;
+        gap_begin_ = count;
+        gap_end_ = count;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::clear()noexcept{
+        gap_begin_ = 0;
+        gap_end_ = capacity_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::insert(const_iterator pos, const T& value)noexcept{
+        return insert(pos,1,value);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::insert(const_iterator pos, size_type count, const T& value)noexcept{
+        const size_type index = pos.index();
+        if (count <= 0){
+            return iterator(this,index);
+        }
+        const T temp(value);    // value may live in the buffer
+        if (!open_gap(count)){
+            return iterator(this,index);
+        }
+        move_cursor(index);
+        for (size_type i = 0; i < count; ++i){
+            data_buffer_[gap_begin_ + i] = temp;
+        }
+        gap_begin_ += count;
+        return iterator(this,index);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    template<typename InputIt>
+    inline auto gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)noexcept
+        -> type_<iterator,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        const size_type index = pos.index();
+        if constexpr (is_random_access_iterator_v<InputIt>){
+            if (!open_gap(last - first)){
+                return iterator(this,index);
+            }
+        }
+        move_cursor(index);
+        for (; first != last; ++first){
+            if (gap_begin_ == gap_end_){
+                if (!open_gap(1)){
+                    break;
+                }
+            }
+            data_buffer_[gap_begin_] = *first;
+            ++gap_begin_;
+        }
+        return iterator(this,index);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::erase(const_iterator pos)noexcept{
+        return erase(pos,pos + 1);
+    }
+
+    // the erased elements just become part of the gap
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::erase(const_iterator first, const_iterator last)noexcept{
+        const size_type begin = first.index();
+        const size_type count = last.index() - begin;
+        if (count > 0){
+            move_cursor(begin);
+            gap_end_ += count;
+        }
+        return iterator(this,begin);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::push_back(const T& value)noexcept{
+        insert(cend(),1,value);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::pop_back()noexcept{
+        erase(cend() - 1);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::resize(size_type new_size, const T& value)noexcept{
+        const size_type old_size = size();
+        if (new_size > old_size){
+            insert(cend(),new_size - old_size,value);
+        }else if (new_size < old_size){
+            erase(cbegin() + new_size,cend());
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline dyn_extent_span<T> gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::compact()noexcept{
+        move_cursor(size());
+        return dyn_extent_span<T>(data_buffer_,size());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline T* gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::data()noexcept{
+        return data_buffer_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::free_dev_buffer()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (device_data_buffer_){
+                omp_target_free(device_data_buffer_,OffloadPolicy::device);
+            }
+        }
+        device_data_buffer_ = nullptr;
+        device_capacity_ = 0;
+    }
+
+    // the device buffer follows the host capacity so a few inserts between transfers don't reallocate it
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::dev_buffer_resize()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (device_capacity_ >= size() && device_data_buffer_){
+                return;
+            }
+            T * temp = (T *) omp_target_alloc(capacity_ * sizeof(T), OffloadPolicy::device);
+            if (!temp && capacity_ > 0){
+                std::cerr<<"ERROR gap_buffer failed to allocate memory on offload device"<<std::endl;
+                return;
+            }
+            free_dev_buffer();
+            device_data_buffer_ = temp;
+            device_capacity_ = capacity_;
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            compact();
+            dev_buffer_resize();
+            if (!device_data_buffer_ || size() == 0){
+                return;
+            }
+            try{
+                bool fail = omp_target_memcpy(device_data_buffer_,data_buffer_,size() * sizeof(T),0,0,
+                                              OffloadPolicy::device,omp_get_initial_device());
+                if(fail){
+                    throw std::runtime_error("ERROR gap_buffer failed to copy data to the device");
+                }
+            }catch(std::runtime_error& e){
+                std::cerr<<e.what()<<std::endl;
+            }catch(...){
+                std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+            }
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            compact();
+            const size_type count = (device_capacity_ < size()) ? device_capacity_:size();
+            if (!device_data_buffer_ || count == 0){
+                return;
+            }
+            try{
+                bool fail = omp_target_memcpy(data_buffer_,device_data_buffer_,count * sizeof(T),0,0,
+                                              omp_get_initial_device(),OffloadPolicy::device);
+                if(fail){
+                    throw std::runtime_error("ERROR gap_buffer failed to copy data from the device");
+                }
+            }catch(std::runtime_error& e){
+                std::cerr<<e.what()<<std::endl;
+            }catch(...){
+                std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+            }
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline dyn_extent_span<T> gap_buffer<T,Allocator,OffloadPolicy,GrowthPolicy>::device_span()const noexcept{
+        return dyn_extent_span<T>(device_data_buffer_,size());
+    }
+}
+#endif
@@ -0,0 +1,107 @@
+// capacity growth policies for dynarray (and r2darray through its dynarray), passed as the GrowthPolicy template parameter
+// a policy only needs a static next_capacity(current capacity, required capacity, element size in bytes)
+// returning a capacity >= required capacity, everything is integer arithmetic
+#pragma once
+
+#ifndef HOPELESS_GROWTH_POLICY
+#define HOPELESS_GROWTH_POLICY
+
+#include<cstddef>
+#include<limits>
+
+namespace hopeless
+{
+    namespace growth_detail{
+        constexpr inline std::ptrdiff_t max_cap(const std::ptrdiff_t elem_size)noexcept{
+            return std::numeric_limits<std::ptrdiff_t>::max()/elem_size;
+        }
+
+        // smallest power of two >= n, n > 0
+        constexpr inline std::ptrdiff_t next_pow2(std::ptrdiff_t n)noexcept{
+            std::ptrdiff_t p = 1;
+            while (p < n && p <= (std::numeric_limits<std::ptrdiff_t>::max()>>1)){
+                p <<= 1;
+            }
+            return (p < n) ? n:p;
+        }
+
+        // n rounded up to a multiple of m, m > 0
+        constexpr inline std::ptrdiff_t round_up(const std::ptrdiff_t n, const std::ptrdiff_t m)noexcept{
+            return (n > std::numeric_limits<std::ptrdiff_t>::max() - (m-1)) ? n:((n + m - 1)/m) * m;
+        }
+
+        // number of elements that fit in bytes but never less than required
+        constexpr inline std::ptrdiff_t bytes_to_cap(const std::ptrdiff_t bytes, const std::ptrdiff_t required_cap, const std::ptrdiff_t elem_size)noexcept{
+            const std::ptrdiff_t cap = bytes/elem_size;
+            return (cap > required_cap) ? cap:required_cap;
+        }
+    }
+
+    // capacity * num/den, e.g. geometric_growth<2,1> doubles and geometric_growth<3,2> is the 1.5 factor
+    template<std::ptrdiff_t num, std::ptrdiff_t den = 1>
+    struct geometric_growth
+    {
+        static_assert((den > 0) && (num > den), "growth ratio should be greater than 1");
+        static constexpr inline std::ptrdiff_t next_capacity(const std::ptrdiff_t cur_cap, const std::ptrdiff_t required_cap, const std::ptrdiff_t elem_size)noexcept{
+            const std::ptrdiff_t max = growth_detail::max_cap(elem_size);
+            // split so cur_cap * num doesn't overflow before the division
+            const std::ptrdiff_t grown = (cur_cap/den > max/num) ? max:(cur_cap/den) * num + ((cur_cap%den) * num)/den;
+            return (grown > required_cap) ? grown:required_cap;
+        }
+    };
+
+    // buffer size in bytes is a power of two and at least one page, so a page sized allocator never has a partial page at the end
+    template<std::ptrdiff_t page_bytes = 4096>
+    struct pow2_page_growth
+    {
+        static_assert((page_bytes > 0) && !(page_bytes & (page_bytes - 1)), "page size should be a power of two");
+        static constexpr inline std::ptrdiff_t next_capacity(const std::ptrdiff_t cur_cap, const std::ptrdiff_t required_cap, const std::ptrdiff_t elem_size)noexcept{
+            if (required_cap > growth_detail::max_cap(elem_size)/2){
+                return required_cap;
+            }
+            const std::ptrdiff_t bytes = growth_detail::next_pow2(required_cap * elem_size);
+            return growth_detail::bytes_to_cap((bytes < page_bytes) ? page_bytes:bytes,required_cap,elem_size);
+        }
+    };
+
+    // doubles and rounds the buffer up to a whole number of huge pages once it is bigger than one,
+    // below that it behaves like pow2_page_growth so small arrays don't take a whole huge page
+    template<std::ptrdiff_t huge_page_bytes = 2097152, std::ptrdiff_t page_bytes = 4096>
+    struct huge_page_growth
+    {
+        static_assert((page_bytes > 0) && (huge_page_bytes >= page_bytes) && !(huge_page_bytes % page_bytes), "huge page size should be a multiple of the page size");
+        static constexpr inline std::ptrdiff_t next_capacity(const std::ptrdiff_t cur_cap, const std::ptrdiff_t required_cap, const std::ptrdiff_t elem_size)noexcept{
+            const std::ptrdiff_t max = growth_detail::max_cap(elem_size);
+            if (required_cap > max/2){
+                return required_cap;
+            }
+            const std::ptrdiff_t target = (cur_cap > max/2) ? required_cap:((2 * cur_cap > required_cap) ? 2 * cur_cap:required_cap);
+            const std::ptrdiff_t bytes = target * elem_size;
+            if (bytes < huge_page_bytes){
+                return pow2_page_growth<page_bytes>::next_capacity(cur_cap,target,elem_size);
+            }
+            return growth_detail::bytes_to_cap(growth_detail::round_up(bytes,huge_page_bytes),required_cap,elem_size);
+        }
+    };
+
+    // doubles until the buffer reaches threshold_bytes then grows by threshold_bytes at a time,
+    // for big arrays where over allocating by half the array is worse than reallocating more often
+    template<std::ptrdiff_t threshold_bytes = 67108864>
+    struct capped_linear_growth
+    {
+        static_assert(threshold_bytes > 0, "threshold should be positive");
+        static constexpr inline std::ptrdiff_t next_capacity(const std::ptrdiff_t cur_cap, const std::ptrdiff_t required_cap, const std::ptrdiff_t elem_size)noexcept{
+            const std::ptrdiff_t max = growth_detail::max_cap(elem_size);
+            const std::ptrdiff_t step_cap = (threshold_bytes/elem_size > 0) ? threshold_bytes/elem_size:1;
+            std::ptrdiff_t grown;
+            if (cur_cap < step_cap){
+                grown = 2 * cur_cap;
+                grown = (grown > step_cap) ? step_cap:grown;
+            }else{
+                grown = (cur_cap > max - step_cap) ? max:cur_cap + step_cap;
+            }
+            return (grown > required_cap) ? grown:required_cap;
+        }
+    };
+}
+#endif
@@ -6,7 +6,11 @@
 #pragma once
 
 #include <type_traits>
+#include <iostream>
 #include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
 
 // define if using openmp offloading
 #define HOPELESS_TARGET_OMP_DEV
@@ -14,9 +18,38 @@
 //define if you want to map changes to device after calls to functions such as insert and push_back (emplace_back is excluded)
 //#define HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE              // also applies to r2darray
 
-// control how capcity of dynarray grows
-#ifndef HOPELESS_DYNARRAY_CAPACITY_GROWTH_RATE
-    #define HOPELESS_DYNARRAY_CAPACITY_GROWTH_RATE 1.61803400516510009765625f  // this is the golden ratio, is it better than 2? I don't know
+// define if the openmp runtime has omp_target_memcpy_async (OpenMP 5.1), transfer_batch then uses it instead of one task per copy
+//#define HOPELESS_OMP_TARGET_MEMCPY_ASYNC
+
+// dynarray::sync_indices_to/from_omp_dev does one range copy spanning all the indices unless that range
+// is more than this many times the size of the packed values + indices, then it gathers/scatters instead
+#ifndef HOPELESS_DYNARRAY_SPARSE_SYNC_BYTE_RATIO
+    #define HOPELESS_DYNARRAY_SPARSE_SYNC_BYTE_RATIO 4
+#endif
+
+// bulk construction in dynarray (fill, copy, assign ...) runs in parallel once it is at least this many elements
+#ifndef HOPELESS_DYNARRAY_PARALLEL_THRESHOLD
+    #define HOPELESS_DYNARRAY_PARALLEL_THRESHOLD 65536
+#endif
+
+// elements per device thread for the chunked hopeless::par algorithms (reductions, scans, copy_if) on a target_space
+#ifndef HOPELESS_PAR_TARGET_CHUNK
+    #define HOPELESS_PAR_TARGET_CHUNK 1024
+#endif
+
+// attribute on the kernels in simd_kernels.hpp, by default gcc on x86-64 linux builds them for avx512f, avx2 and the baseline
+// and picks one when the program loads (ifunc), define it empty to only build the baseline or to your own target list
+#ifndef HOPELESS_SIMD_CLONES
+    #if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+        #define HOPELESS_SIMD_CLONES __attribute__((target_clones("avx512f","avx2","default")))
+    #else
+        #define HOPELESS_SIMD_CLONES
+    #endif
+#endif
+
+// control how capcity of dynarray grows when no GrowthPolicy is given, the policies are in growth_policy.hpp
+#ifndef HOPELESS_DYNARRAY_DEFAULT_GROWTH_POLICY
+    #define HOPELESS_DYNARRAY_DEFAULT_GROWTH_POLICY hopeless::geometric_growth<1618034,1000000>  // this is the golden ratio, is it better than 2? I don't know
 #endif
 
 // the device number of the device to offload to
@@ -24,6 +57,15 @@
     #define HOPELESS_DEFAULT_OMP_OFFLOAD_DEV 0
 #endif
 
+// offload policy of dynarray and r2darray when none is given, hopeless::host_only or hopeless::mirrored<dev_no>
+#ifndef HOPELESS_DEFAULT_OFFLOAD_POLICY
+    #ifdef HOPELESS_TARGET_OMP_DEV
+        #define HOPELESS_DEFAULT_OFFLOAD_POLICY hopeless::mirrored<HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>
+    #else
+        #define HOPELESS_DEFAULT_OFFLOAD_POLICY hopeless::host_only
+    #endif
+#endif
+
 namespace hopeless{
 
     // a bit of tweaking of std::void_t to use with defered decltype for SFINAE
@@ -40,6 +82,101 @@ namespace hopeless{
         also can be used in arguement type for same purpose
     */
 
+    // true if constructing a T from Args through Allocator can't throw, loops doing that don't need try/catch
+    // and can be put in parallel regions
+    template<typename Allocator, typename T, typename... Args>
+    inline constexpr bool is_nothrow_alloc_constructible_v = noexcept(std::allocator_traits<Allocator>::construct(
+        std::declval<Allocator&>(),std::declval<T*>(),std::declval<Args>()...));
+
+    // allocators without their own construct(), allocator_traits then just placement news so for a trivially copyable T
+    // constructing is copying bytes and bulk construction can go through the kernels in simd_kernels.hpp
+    template<typename Allocator, typename T, typename Enable = void>
+    struct has_construct_member : std::false_type{};
+    template<typename Allocator, typename T>
+    struct has_construct_member<Allocator,T,std::void_t<decltype(std::declval<Allocator&>().construct(
+        std::declval<T*>(),std::declval<const T&>()))>> : std::true_type{};
+    template<typename Allocator, typename T>
+    inline constexpr bool is_plain_construct_v = std::is_trivially_copyable_v<T> && !has_construct_member<Allocator,T>::value;
+
+    // same for destroy(), without one allocator_traits::destroy of a trivially destructible T does nothing
+    template<typename Allocator, typename T, typename Enable = void>
+    struct has_destroy_member : std::false_type{};
+    template<typename Allocator, typename T>
+    struct has_destroy_member<Allocator,T,std::void_t<decltype(std::declval<Allocator&>().destroy(
+        std::declval<T*>()))>> : std::true_type{};
+    template<typename Allocator, typename T>
+    inline constexpr bool is_trivial_destroy_v = std::is_trivially_destructible_v<T> && !has_destroy_member<Allocator,T>::value;
+
+    template<typename Allocator, typename T>
+    inline constexpr bool is_nothrow_alloc_destructible_v = noexcept(std::allocator_traits<Allocator>::destroy(
+        std::declval<Allocator&>(),std::declval<T*>()));
+
+    // moving the elements to a new buffer (resizing) can't throw
+    template<typename Allocator, typename T>
+    inline constexpr bool is_nothrow_relocatable_v = is_nothrow_alloc_constructible_v<Allocator,T,T&&> &&
+        is_nothrow_alloc_destructible_v<Allocator,T>;
+
+    // shifting the elements along for an insert (move/copy construct at the end, move/copy assign the rest) can't throw
+    template<typename Allocator, typename T>
+    inline constexpr bool is_nothrow_shiftable_v = is_nothrow_alloc_constructible_v<Allocator,T,T&&> &&
+        is_nothrow_alloc_constructible_v<Allocator,T,const T&> && std::is_nothrow_move_assignable_v<T> &&
+        std::is_nothrow_copy_assignable_v<T>;
+
+    template<typename It, typename Enable = void>
+    struct is_random_access_iterator : std::false_type{};
+    template<typename It>
+    struct is_random_access_iterator<It,std::void_t<typename std::iterator_traits<It>::iterator_category>>
+        : std::is_base_of<std::random_access_iterator_tag,typename std::iterator_traits<It>::iterator_category>{};
+    template<typename It>
+    inline constexpr bool is_random_access_iterator_v = is_random_access_iterator<It>::value;
+
+    // containers with data() returning a pointer to their elements stored contiguously (dynarray, std::vector, std::array ...)
+    template<typename Container, typename Enable = void>
+    struct has_contiguous_data : std::false_type{};
+    template<typename Container>
+    struct has_contiguous_data<Container,std::void_t<decltype(std::declval<Container&>().data())>>
+        : std::is_pointer<decltype(std::declval<Container&>().data())>{};
+    template<typename Container>
+    inline constexpr bool has_contiguous_data_v = has_contiguous_data<Container>::value;
+    // and those elements are T
+    template<typename Container, typename T, typename Enable = void>
+    struct has_contiguous_data_of : std::false_type{};
+    template<typename Container, typename T>
+    struct has_contiguous_data_of<Container,T,std::enable_if_t<has_contiguous_data_v<Container>>>
+        : std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<Container&>().data())>>,T>{};
+    template<typename Container, typename T>
+    inline constexpr bool has_contiguous_data_of_v = has_contiguous_data_of<Container,T>::value;
+
+    // tag for constructors that leave elements uninitialised, e.g. dynarray<double> out(n,hopeless::for_overwrite)
+    struct for_overwrite_t{
+        explicit for_overwrite_t() = default;
+    };
+    inline constexpr for_overwrite_t for_overwrite{};
+
+    // tag for constructors that size a container for an expected element count,
+    // e.g. device_hash_map<int,float> map(hopeless::with_capacity,1000)
+    struct with_capacity_t{
+        explicit with_capacity_t() = default;
+    };
+    inline constexpr with_capacity_t with_capacity{};
+
+    // types whose value initialised state is all zero bytes, dynarray(count) then asks the allocator for zeroed memory 
+    // instead of constructing every element, specialise for your own trivial types if that holds for them
+    template<typename T>
+    struct is_zero_initializable : std::bool_constant<std::is_trivially_default_constructible_v<T> &&
+        (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)>{};
+    template<typename T>
+    inline constexpr bool is_zero_initializable_v = is_zero_initializable<T>::value;
+
+    // allocators with allocate_zeroed(n) returning zero filled memory, like hopeless::allocator
+    template<typename Allocator, typename Enable = void>
+    struct has_allocate_zeroed : std::false_type{};
+    template<typename Allocator>
+    struct has_allocate_zeroed<Allocator,std::void_t<decltype(std::declval<Allocator&>().allocate_zeroed(
+        std::declval<typename std::allocator_traits<Allocator>::size_type>()))>> : std::true_type{};
+    template<typename Allocator>
+    inline constexpr bool has_allocate_zeroed_v = has_allocate_zeroed<Allocator>::value;
+
     inline void cout_exception(std::exception_ptr exception)noexcept{
         try{
             if (exception){std::rethrow_exception(exception);}
@@ -49,6 +186,25 @@ namespace hopeless{
             std::cerr << "Unknown failure, possibly custom exception or memory corruption issues?" << "\n";
         }
     }
+
+    // runs f inside a try/catch that reports what went wrong, when nothrow says nothing in f can throw f is just called
+    // and the exception handling compiles away (it otherwise keeps the loops in f from being inlined and vectorised)
+    template<bool nothrow, typename F>
+    inline void try_or_report(F && f, const char * what = nullptr)noexcept{
+        if constexpr (nothrow){
+            f();
+        }else{
+            try{
+                f();
+            }catch(...){
+                if (what){
+                    std::cerr << what << '\n';
+                }
+                std::exception_ptr exception=std::current_exception();
+                cout_exception(exception);
+            }
+        }
+    }
 }
 #endif
-
+
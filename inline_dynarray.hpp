@@ -0,0 +1,423 @@
+// array with a compile time capacity N and a runtime size, the elements live inside the object and it never allocates
+// meant for scratch space inside target regions (per thread or per team), e.g.
+//      hopeless::inline_dynarray<int,32> found;     // declared inside the kernel
+//      if (hit){found.push_back(i);}
+// everything but at() is declare target and constexpr, elements have to be trivially copyable (as on the device
+// for dynarray) so the storage is a plain T[N] and an inline_dynarray can be mapped or passed firstprivate by value
+// NOTE! there is nowhere to report errors on the device, push_back()/insert() past N do nothing (size stays N),
+// an insert() keeps every element already there and only adds as many new ones as there is room left for,
+// check full() first when that matters, iterators are plain pointers and stay valid as nothing ever moves
+#pragma once
+
+#ifndef HOPELESS_INLINE_DYNARRAY
+#define HOPELESS_INLINE_DYNARRAY
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<type_traits>
+#include<initializer_list>
+#include<utility>
+#include<iterator>
+
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename T, std::ptrdiff_t N>
+    struct inline_dynarray
+    {
+        static_assert(N > 0, "inline_dynarray needs room for at least one element");
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                      "inline_dynarray elements should be trivially copyable and default constructible");
+    public:
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::ptrdiff_t size_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef typename std::reverse_iterator<iterator> reverse_iterator;
+        typedef typename std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        enum : std::ptrdiff_t {inline_capacity = N};     // not a static member so the type stays mappable
+
+        #pragma omp declare target
+        constexpr inline_dynarray()noexcept;
+        constexpr explicit inline_dynarray(size_type count)noexcept;
+        constexpr inline_dynarray(size_type count, const T& value)noexcept;
+        constexpr inline_dynarray(std::initializer_list<T> init)noexcept;
+        inline_dynarray(for_overwrite_t)noexcept;          // leaves the storage uninitialised, not constexpr
+
+        constexpr inline reference operator [](const size_type i)noexcept;
+        constexpr inline const_reference operator [](const size_type i)const noexcept;
+        // same as [], for code written against dynarray's device access
+        constexpr inline reference operator ()(const size_type i)noexcept;
+        constexpr inline const_reference operator ()(const size_type i)const noexcept;
+
+        constexpr inline reference front()noexcept;
+        constexpr inline const_reference front()const noexcept;
+        constexpr inline reference back()noexcept;
+        constexpr inline const_reference back()const noexcept;
+        constexpr inline T* data()noexcept;
+        constexpr inline const T* data()const noexcept;
+
+        constexpr inline iterator begin()noexcept;
+        constexpr inline const_iterator begin()const noexcept;
+        constexpr inline const_iterator cbegin()const noexcept;
+        constexpr inline iterator end()noexcept;
+        constexpr inline const_iterator end()const noexcept;
+        constexpr inline const_iterator cend()const noexcept;
+        constexpr inline reverse_iterator rbegin()noexcept;
+        constexpr inline const_reverse_iterator rbegin()const noexcept;
+        constexpr inline reverse_iterator rend()noexcept;
+        constexpr inline const_reverse_iterator rend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline bool full()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;
+        constexpr inline size_type max_size()const noexcept;
+        constexpr inline void clear()noexcept;
+
+        constexpr inline iterator insert(const_iterator pos, const T& value)noexcept;
+        constexpr inline iterator insert(const_iterator pos, size_type count, const T& value)noexcept;
+        // the range is walked twice (count then copy) so it has to be a forward range
+        template<typename ForwardIt, typename = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag,
+            typename std::iterator_traits<ForwardIt>::iterator_category>>>
+        constexpr inline iterator insert(const_iterator pos, ForwardIt first, ForwardIt last)noexcept;
+        constexpr inline iterator insert(const_iterator pos, std::initializer_list<T> ilist)noexcept;
+        template<typename... Args>
+        constexpr inline iterator emplace(const_iterator pos, Args&&... args)noexcept;
+        constexpr inline iterator erase(const_iterator pos)noexcept;
+        constexpr inline iterator erase(const_iterator first, const_iterator last)noexcept;
+
+        constexpr inline void push_back(const T& value)noexcept;
+        template<typename... Args>
+        constexpr inline reference emplace_back(Args && ...args)noexcept;   // back() if full, the element isn't added
+        constexpr inline void pop_back()noexcept;
+
+        constexpr inline void resize(size_type new_size)noexcept;      // clamped to N
+        constexpr inline void resize(size_type new_size, const T& value)noexcept;
+        #pragma omp end declare target
+
+        constexpr inline reference at(size_type pos);
+        constexpr inline const_reference at(size_type pos)const;
+
+    private:
+        #pragma omp declare target
+        constexpr inline size_type open_gap(size_type index, size_type count)noexcept;  // shifts [index,size_) up, returns how many fit
+        #pragma omp end declare target
+
+    // member variables
+        T elements_[N];
+        size_type size_;
+    };
+
+    #pragma omp declare target
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline_dynarray<T,N>::inline_dynarray()noexcept
+        :elements_(),
+        size_(0){}
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline_dynarray<T,N>::inline_dynarray(size_type count)noexcept
+        :elements_(),
+        size_((count < 0) ? 0:((count > N) ? N:count)){}
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline_dynarray<T,N>::inline_dynarray(size_type count, const T& value)noexcept
+        :elements_(),
+        size_(0)
+    {
+        resize(count,value);
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline_dynarray<T,N>::inline_dynarray(std::initializer_list<T> init)noexcept
+        :elements_(),
+        size_(0)
+    {
+        insert(end(),init);
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    inline_dynarray<T,N>::inline_dynarray(for_overwrite_t)noexcept
+        :size_(0){}
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reference inline_dynarray<T,N>::operator [](const size_type i)noexcept{
+        return elements_[i];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reference inline_dynarray<T,N>::operator [](const size_type i)const noexcept{
+        return elements_[i];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reference inline_dynarray<T,N>::operator ()(const size_type i)noexcept{
+        return elements_[i];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reference inline_dynarray<T,N>::operator ()(const size_type i)const noexcept{
+        return elements_[i];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reference inline_dynarray<T,N>::front()noexcept{
+        return elements_[0];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reference inline_dynarray<T,N>::front()const noexcept{
+        return elements_[0];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reference inline_dynarray<T,N>::back()noexcept{
+        return elements_[size_-1];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reference inline_dynarray<T,N>::back()const noexcept{
+        return elements_[size_-1];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline T* inline_dynarray<T,N>::data()noexcept{
+        return elements_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline const T* inline_dynarray<T,N>::data()const noexcept{
+        return elements_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::begin()noexcept{
+        return elements_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_iterator inline_dynarray<T,N>::begin()const noexcept{
+        return elements_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_iterator inline_dynarray<T,N>::cbegin()const noexcept{
+        return elements_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::end()noexcept{
+        return elements_ + size_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_iterator inline_dynarray<T,N>::end()const noexcept{
+        return elements_ + size_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_iterator inline_dynarray<T,N>::cend()const noexcept{
+        return elements_ + size_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reverse_iterator inline_dynarray<T,N>::rbegin()noexcept{
+        return reverse_iterator(end());
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reverse_iterator inline_dynarray<T,N>::rbegin()const noexcept{
+        return const_reverse_iterator(end());
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reverse_iterator inline_dynarray<T,N>::rend()noexcept{
+        return reverse_iterator(begin());
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reverse_iterator inline_dynarray<T,N>::rend()const noexcept{
+        return const_reverse_iterator(begin());
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline bool inline_dynarray<T,N>::empty()const noexcept{
+        return (size_ == 0);
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline bool inline_dynarray<T,N>::full()const noexcept{
+        return (size_ == N);
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::size_type inline_dynarray<T,N>::size()const noexcept{
+        return size_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::size_type inline_dynarray<T,N>::capacity()const noexcept{
+        return N;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::size_type inline_dynarray<T,N>::max_size()const noexcept{
+        return N;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline void inline_dynarray<T,N>::clear()noexcept{
+        size_ = 0;
+    }
+
+    // makes room for count elements at index, never drops an element already there so count is cut to the room
+    // left (0 when full), returns how many of the count fit
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::size_type inline_dynarray<T,N>::open_gap(const size_type index, size_type count)noexcept{
+        if ((count <= 0) || (index < 0) || (index > size_)){
+            return 0;
+        }
+        count = (count > N - size_) ? (N - size_):count;
+        if (count == 0){
+            return 0;
+        }
+        const size_type new_size = size_ + count;
+        for (size_type i = new_size - 1; i >= index + count; --i){
+            elements_[i] = elements_[i - count];
+        }
+        size_ = new_size;
+        return count;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::insert(const_iterator pos, const T& value)noexcept{
+        return emplace(pos,value);
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::insert(const_iterator pos, size_type count, const T& value)noexcept{
+        const size_type index = pos - cbegin();
+        const T temp = value;           // value may be one of the elements being shifted
+        count = open_gap(index,count);
+        for (size_type i = index; i < index + count; ++i){
+            elements_[i] = temp;
+        }
+        return elements_ + index;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    template<typename ForwardIt, typename>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::insert(const_iterator pos, ForwardIt first, ForwardIt last)noexcept{
+        const size_type index = pos - cbegin();
+        size_type count = 0;
+        for (ForwardIt it = first; it != last; ++it){
+            ++count;
+        }
+        count = open_gap(index,count);
+        for (size_type i = index; i < index + count; ++i, ++first){
+            elements_[i] = *first;
+        }
+        return elements_ + index;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::insert(const_iterator pos, std::initializer_list<T> ilist)noexcept{
+        return insert(pos,ilist.begin(),ilist.end());
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    template<typename... Args>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::emplace(const_iterator pos, Args&&... args)noexcept{
+        const size_type index = pos - cbegin();
+        T temp(std::forward<Args>(args)...);    // built first in case args refer to something in the array
+        if (open_gap(index,1) == 1){
+            elements_[index] = temp;
+        }
+        return elements_ + index;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::erase(const_iterator pos)noexcept{
+        return erase(pos,pos + 1);
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::iterator inline_dynarray<T,N>::erase(const_iterator first, const_iterator last)noexcept{
+        const size_type begin = first - cbegin();
+        const size_type end = last - cbegin();
+        if (end <= begin){
+            return elements_ + begin;
+        }
+        for (size_type i = end; i < size_; ++i){
+            elements_[i - (end - begin)] = elements_[i];
+        }
+        size_ -= end - begin;
+        return elements_ + begin;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline void inline_dynarray<T,N>::push_back(const T& value)noexcept{
+        if (size_ < N){
+            elements_[size_] = value;
+            ++size_;
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    template<typename... Args>
+    constexpr inline typename inline_dynarray<T,N>::reference inline_dynarray<T,N>::emplace_back(Args && ...args)noexcept{
+        if (size_ < N){
+            elements_[size_] = T(std::forward<Args>(args)...);
+            ++size_;
+        }
+        return elements_[size_-1];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline void inline_dynarray<T,N>::pop_back()noexcept{
+        --size_;
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline void inline_dynarray<T,N>::resize(size_type new_size)noexcept{
+        resize(new_size,T());
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline void inline_dynarray<T,N>::resize(size_type new_size, const T& value)noexcept{
+        new_size = (new_size < 0) ? 0:((new_size > N) ? N:new_size);
+        const T temp = value;
+        for (size_type i = size_; i < new_size; ++i){
+            elements_[i] = temp;
+        }
+        size_ = new_size;
+    }
+    #pragma omp end declare target
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::reference inline_dynarray<T,N>::at(size_type pos){
+        if ((pos>=size_) || (pos<0)){
+            std::cerr<<"Error inline_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return elements_[pos];
+    }
+
+    template<typename T, std::ptrdiff_t N>
+    constexpr inline typename inline_dynarray<T,N>::const_reference inline_dynarray<T,N>::at(size_type pos)const{
+        if ((pos>=size_) || (pos<0)){
+            std::cerr<<"Error inline_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return elements_[pos];
+    }
+}
+#endif
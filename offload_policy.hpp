@@ -0,0 +1,23 @@
+// offload policies for dynarray and r2darray, passed as the OffloadPolicy template parameter
+// host_only instances never allocate or copy anything on a device
+// mirrored<dev_no> instances keep a copy of their data on openmp offload device dev_no (needs HOPELESS_TARGET_OMP_DEV)
+#pragma once
+
+#ifndef HOPELESS_OFFLOAD_POLICY
+#define HOPELESS_OFFLOAD_POLICY
+
+namespace hopeless
+{
+    struct host_only
+    {
+        static constexpr bool offload = false;
+    };
+
+    template<int dev_no>
+    struct mirrored
+    {
+        static constexpr bool offload = true;
+        static constexpr int device = dev_no;
+    };
+}
+#endif
@@ -0,0 +1,562 @@
+// parallel algorithms over dynarray, dyn_extent_span and r2darray rows (r2darray[i] on the host, device_row(i) on the device)
+// every algorithm takes an execution space first, par::host_space runs an omp parallel loop on the host copy and
+// par::target_space<dev_no> runs one target teams loop on the device copy (mirrored dynarray device_data(), or a
+// dyn_extent_span that already points to device memory), e.g.
+//      double s = hopeless::par::reduce(hopeless::par::host,arr,0.0);
+//      hopeless::par::transform(hopeless::par::target<>,arr,out,[](double x){return 2*x;});
+// chunk is the number of consecutive elements one thread works through (0 picks one chunk per host thread,
+// HOPELESS_PAR_TARGET_CHUNK on the device), reductions and scans keep one partial per chunk and combine the
+// partials on the host in chunk order, so op only has to be associative
+// NOTE! a target_space works on whatever is on the device, map_data_to_omp_dev() first and map_data_from_omp_dev() after
+#pragma once
+
+#ifndef HOPELESS_PAR
+#define HOPELESS_PAR
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<type_traits>
+#include<functional>
+#include<utility>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "dyn_extent_span.hpp"
+#include "offload_policy.hpp"
+#include "simd_kernels.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    namespace par
+    {
+        // run on the host threads
+        struct host_space
+        {
+            std::ptrdiff_t chunk = 0;
+        };
+
+        // run on openmp offload device dev_no
+        template<int dev_no>
+        struct target_space
+        {
+            enum : int {device = dev_no};
+            std::ptrdiff_t chunk = HOPELESS_PAR_TARGET_CHUNK;
+        };
+
+        inline constexpr host_space host{};
+    #ifdef HOPELESS_TARGET_OMP_DEV
+        template<int dev_no = HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>
+        inline constexpr target_space<dev_no> target{};
+    #endif
+
+        namespace par_detail
+        {
+            template<typename Exec>
+            struct is_target : std::false_type{};
+            template<int dev_no>
+            struct is_target<target_space<dev_no>> : std::true_type{};
+
+            // first element and count of a range in the memory the execution space works on
+            template<typename T>
+            struct view
+            {
+                T * data;
+                std::ptrdiff_t size;
+            };
+
+            template<typename Range>
+            inline auto make_view(const host_space &, Range && range)noexcept
+                -> type_<view<std::remove_reference_t<decltype(*range.data())>>,
+                    decltype(range.size())>
+            {
+                return {range.data(),static_cast<std::ptrdiff_t>(range.size())};
+            }
+
+            // spans are taken to already point to device memory, e.g. r2darray::device_row()
+            template<int dev_no, typename T>
+            inline view<T> make_view(const target_space<dev_no> &, const dyn_extent_span<T> & span)noexcept{
+                return {span.data(),span.size()};
+            }
+
+        #ifdef HOPELESS_TARGET_OMP_DEV
+            template<int dev_no, typename T, typename Allocator, int array_dev_no, typename GrowthPolicy>
+            inline view<T> make_view(const target_space<dev_no> &, const dynarray<T,Allocator,mirrored<array_dev_no>,GrowthPolicy> & array)noexcept{
+                static_assert(dev_no == array_dev_no, "target_space device and dynarray device differ");
+                return {array.device_data(),array.size()};
+            }
+        #endif
+
+            inline std::ptrdiff_t chunk_size(const host_space & exec, const std::ptrdiff_t n)noexcept{
+                if (exec.chunk > 0){
+                    return exec.chunk;
+                }
+                if (n < HOPELESS_DYNARRAY_PARALLEL_THRESHOLD){
+                    return (n > 0) ? n:1;
+                }
+                const std::ptrdiff_t threads = omp_get_max_threads();
+                return (n + threads - 1) / threads;
+            }
+
+            template<int dev_no>
+            inline std::ptrdiff_t chunk_size(const target_space<dev_no> & exec, const std::ptrdiff_t)noexcept{
+                return (exec.chunk > 0) ? exec.chunk:HOPELESS_PAR_TARGET_CHUNK;
+            }
+
+            // the loops hand the (up to three) data pointers to f as arguments instead of letting f capture them,
+            // so on the device they can go through is_device_ptr, pass a null int * for the unused ones
+            // f(i,a,b,c) for i in [0,n)
+            template<typename A, typename B, typename C, typename F>
+            inline void for_each_index(const host_space & exec, const std::ptrdiff_t n, A * a, B * b, C * c, F f)noexcept{
+                const std::ptrdiff_t chunk = chunk_size(exec,n);
+                #pragma omp parallel for simd schedule(static,chunk) if(n > chunk)
+                for (std::ptrdiff_t i = 0; i < n; ++i){
+                    f(i,a,b,c);
+                }
+            }
+
+            template<int dev_no, typename A, typename B, typename C, typename F>
+            inline void for_each_index(const target_space<dev_no> & exec, const std::ptrdiff_t n, A * a, B * b, C * c, F f)noexcept{
+                const std::ptrdiff_t chunk = chunk_size(exec,n);
+                #pragma omp target teams distribute parallel for simd dist_schedule(static,chunk) is_device_ptr(a,b,c) device(dev_no)
+                for (std::ptrdiff_t i = 0; i < n; ++i){
+                    f(i,a,b,c);
+                }
+            }
+
+            // f(k,begin,end,a,b,c) for every chunk k of [0,n)
+            template<typename A, typename B, typename C, typename F>
+            inline void for_each_chunk(const host_space &, const std::ptrdiff_t n, const std::ptrdiff_t chunk, A * a, B * b, C * c, F f)noexcept{
+                const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+                #pragma omp parallel for schedule(static) if(chunks > 1)
+                for (std::ptrdiff_t k = 0; k < chunks; ++k){
+                    const std::ptrdiff_t begin = k * chunk;
+                    f(k,begin,(begin + chunk < n) ? begin + chunk:n,a,b,c);
+                }
+            }
+
+            template<int dev_no, typename A, typename B, typename C, typename F>
+            inline void for_each_chunk(const target_space<dev_no> &, const std::ptrdiff_t n, const std::ptrdiff_t chunk, A * a, B * b, C * c, F f)noexcept{
+                const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+                #pragma omp target teams distribute parallel for is_device_ptr(a,b,c) device(dev_no)
+                for (std::ptrdiff_t k = 0; k < chunks; ++k){
+                    const std::ptrdiff_t begin = k * chunk;
+                    f(k,begin,(begin + chunk < n) ? begin + chunk:n,a,b,c);
+                }
+            }
+
+            inline void checked_memcpy(void * dst, const void * src, const std::size_t bytes, const int dst_dev, const int src_dev)noexcept{
+                try{
+                    bool fail = omp_target_memcpy(dst,src,bytes,0,0,dst_dev,src_dev);
+                    if(fail){
+                        throw std::runtime_error("ERROR par failed to copy scratch data between host and device");
+                    }
+                }catch(std::runtime_error& e){
+                    std::cerr<<e.what()<<std::endl;
+                }catch(...){
+                    std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+                }
+            }
+
+            // one value per chunk, on the host for host_space and on the device (with a host copy) for target_space
+            template<typename T, typename Exec>
+            struct scratch
+            {
+                dynarray<T,hopeless::allocator<T>,host_only> host;
+                T * dev;
+
+                explicit scratch(const std::ptrdiff_t count)noexcept
+                    :host(count,for_overwrite),
+                    dev(nullptr)
+                {
+                    if constexpr (is_target<Exec>::value){
+                        dev = (T *) omp_target_alloc(count * sizeof(T),Exec::device);
+                        if (!dev && count > 0){
+                            std::cerr<<"ERROR par failed to allocate scratch memory on offload device"<<std::endl;
+                        }
+                    }
+                }
+                scratch(const scratch &) = delete;
+                scratch& operator =(const scratch &) = delete;
+                ~scratch()noexcept{
+                    if constexpr (is_target<Exec>::value){
+                        if (dev){
+                            omp_target_free(dev,Exec::device);
+                        }
+                    }
+                }
+
+                inline T * kernel_data()noexcept{
+                    if constexpr (is_target<Exec>::value){
+                        return dev;
+                    }else{
+                        return host.data();
+                    }
+                }
+                inline void pull()noexcept{
+                    if constexpr (is_target<Exec>::value){
+                        checked_memcpy(host.data(),dev,host.size() * sizeof(T),omp_get_initial_device(),Exec::device);
+                    }
+                }
+                inline void push()noexcept{
+                    if constexpr (is_target<Exec>::value){
+                        checked_memcpy(dev,host.data(),host.size() * sizeof(T),Exec::device,omp_get_initial_device());
+                    }
+                }
+            };
+
+            // on the host, runs of arithmetic elements go through the kernels in simd_kernels.hpp
+            template<typename Exec, typename E>
+            inline constexpr bool use_kernels_v = !is_target<Exec>::value && std::is_arithmetic_v<E>;
+
+            // kernel(first,count) on every chunk of data[0,n) (n > 0), the chunk results folded with combine
+            template<typename T, typename E, typename Kernel, typename Combine>
+            inline T host_chunk_reduce(const host_space & exec, const E * data, const std::ptrdiff_t n, Kernel kernel, Combine combine)noexcept{
+                const std::ptrdiff_t chunk = chunk_size(exec,n);
+                const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+                scratch<T,host_space> partials(chunks);
+                T * p = partials.kernel_data();
+                #pragma omp parallel for schedule(static) if(chunks > 1)
+                for (std::ptrdiff_t k = 0; k < chunks; ++k){
+                    const std::ptrdiff_t begin = k * chunk;
+                    p[k] = kernel(data + begin,((begin + chunk < n) ? begin + chunk:n) - begin);
+                }
+                T acc = p[0];
+                for (std::ptrdiff_t k = 1; k < chunks; ++k){
+                    acc = combine(acc,p[k]);
+                }
+                return acc;
+            }
+
+            template<typename T>
+            struct indexed
+            {
+                T value;
+                std::ptrdiff_t index;
+            };
+
+            // smallest element by comp (the first of equal ones) and its index, index is -1 for an empty range
+            template<typename Exec, typename Range, typename Compare>
+            inline auto arg_extreme(const Exec & exec, Range && range, Compare comp)noexcept{
+                const auto in = make_view(exec,range);
+                typedef std::remove_cv_t<std::remove_reference_t<decltype(*in.data)>> E;
+                const std::ptrdiff_t n = in.size;
+                if (n <= 0){
+                    return indexed<E>{E(),-1};
+                }
+                const std::ptrdiff_t chunk = chunk_size(exec,n);
+                scratch<indexed<E>,Exec> partials((n + chunk - 1) / chunk);
+                for_each_chunk(exec,n,chunk,in.data,partials.kernel_data(),(int *) nullptr,
+                    [comp](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * data, indexed<E> * p, int *){
+                        indexed<E> best{data[begin],begin};
+                        for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                            if (comp(data[i],best.value)){
+                                best.value = data[i];
+                                best.index = i;
+                            }
+                        }
+                        p[k] = best;
+                    });
+                partials.pull();
+                indexed<E> best = partials.host[0];
+                for (std::ptrdiff_t k = 1; k < partials.host.size(); ++k){
+                    if (comp(partials.host[k].value,best.value)){
+                        best = partials.host[k];
+                    }
+                }
+                return best;
+            }
+        }
+
+        template<typename Exec, typename Range, typename T, typename BinaryOp, typename UnaryOp>
+        inline T transform_reduce(const Exec & exec, Range && range, T init, BinaryOp reduce_op, UnaryOp transform_op)noexcept{
+            const auto in = par_detail::make_view(exec,range);
+            const std::ptrdiff_t n = in.size;
+            if (n <= 0){
+                return init;
+            }
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            par_detail::scratch<T,Exec> partials((n + chunk - 1) / chunk);
+            par_detail::for_each_chunk(exec,n,chunk,in.data,partials.kernel_data(),(int *) nullptr,
+                [reduce_op,transform_op](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * data, T * p, int *){
+                    T acc = transform_op(data[begin]);
+                    for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                        acc = reduce_op(acc,transform_op(data[i]));
+                    }
+                    p[k] = acc;
+                });
+            partials.pull();
+            for (std::ptrdiff_t k = 0; k < partials.host.size(); ++k){
+                init = reduce_op(init,partials.host[k]);
+            }
+            return init;
+        }
+
+        // pairwise over two ranges of the same length, e.g. a dot product
+        template<typename Exec, typename Range1, typename Range2, typename T, typename BinaryOp, typename BinaryTransform>
+        inline T transform_reduce(const Exec & exec, Range1 && range1, Range2 && range2, T init, BinaryOp reduce_op, BinaryTransform transform_op)noexcept{
+            const auto in1 = par_detail::make_view(exec,range1);
+            const auto in2 = par_detail::make_view(exec,range2);
+            const std::ptrdiff_t n = (in1.size < in2.size) ? in1.size:in2.size;
+            if (n <= 0){
+                return init;
+            }
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            par_detail::scratch<T,Exec> partials((n + chunk - 1) / chunk);
+            par_detail::for_each_chunk(exec,n,chunk,in1.data,in2.data,partials.kernel_data(),
+                [reduce_op,transform_op](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * data1, auto * data2, T * p){
+                    T acc = transform_op(data1[begin],data2[begin]);
+                    for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                        acc = reduce_op(acc,transform_op(data1[i],data2[i]));
+                    }
+                    p[k] = acc;
+                });
+            partials.pull();
+            for (std::ptrdiff_t k = 0; k < partials.host.size(); ++k){
+                init = reduce_op(init,partials.host[k]);
+            }
+            return init;
+        }
+
+        template<typename Exec, typename Range1, typename Range2, typename T>
+        inline T transform_reduce(const Exec & exec, Range1 && range1, Range2 && range2, T init)noexcept{
+            return transform_reduce(exec,range1,range2,init,std::plus<>(),std::multiplies<>());
+        }
+
+        template<typename Exec, typename Range, typename T, typename BinaryOp>
+        inline T reduce(const Exec & exec, Range && range, T init, BinaryOp op)noexcept{
+            return transform_reduce(exec,range,init,op,[](const auto & x){return static_cast<T>(x);});
+        }
+
+        template<typename Exec, typename Range, typename T>
+        inline T reduce(const Exec & exec, Range && range, T init)noexcept{
+            const auto in = par_detail::make_view(exec,range);
+            typedef std::remove_cv_t<std::remove_reference_t<decltype(*in.data)>> E;
+            if constexpr (par_detail::use_kernels_v<Exec,E> && std::is_same_v<E,T>){
+                if (in.size <= 0){
+                    return init;
+                }
+                return init + par_detail::host_chunk_reduce<T>(exec,in.data,in.size,
+                    [](const E * first, const std::ptrdiff_t count){return kernels::sum(first,count);},std::plus<>());
+            }else{
+                return reduce(exec,range,init,std::plus<>());
+            }
+        }
+
+        // out[i] = op(in[i]) for the length of in, out has to be at least as long
+        template<typename Exec, typename InRange, typename OutRange, typename UnaryOp>
+        inline void transform(const Exec & exec, InRange && in_range, OutRange && out_range, UnaryOp op)noexcept{
+            const auto in = par_detail::make_view(exec,in_range);
+            const auto out = par_detail::make_view(exec,out_range);
+            par_detail::for_each_index(exec,in.size,in.data,out.data,(int *) nullptr,
+                [op](const std::ptrdiff_t i, auto * src, auto * dst, int *){
+                    dst[i] = op(src[i]);
+                });
+        }
+
+        template<typename Exec, typename InRange1, typename InRange2, typename OutRange, typename BinaryOp>
+        inline void transform(const Exec & exec, InRange1 && in_range1, InRange2 && in_range2, OutRange && out_range, BinaryOp op)noexcept{
+            const auto in1 = par_detail::make_view(exec,in_range1);
+            const auto in2 = par_detail::make_view(exec,in_range2);
+            const auto out = par_detail::make_view(exec,out_range);
+            par_detail::for_each_index(exec,(in1.size < in2.size) ? in1.size:in2.size,in1.data,in2.data,out.data,
+                [op](const std::ptrdiff_t i, auto * src1, auto * src2, auto * dst){
+                    dst[i] = op(src1[i],src2[i]);
+                });
+        }
+
+        template<typename Exec, typename OutRange, typename T>
+        inline void fill(const Exec & exec, OutRange && out_range, const T & value)noexcept{
+            const auto out = par_detail::make_view(exec,out_range);
+            typedef std::remove_cv_t<std::remove_reference_t<decltype(*out.data)>> E;
+            if constexpr (par_detail::use_kernels_v<Exec,E>){
+                const E fill_value = static_cast<E>(value);
+                par_detail::for_each_chunk(exec,out.size,par_detail::chunk_size(exec,out.size),out.data,(int *) nullptr,(int *) nullptr,
+                    [fill_value](const std::ptrdiff_t, const std::ptrdiff_t begin, const std::ptrdiff_t end, E * dst, int *, int *){
+                        kernels::fill(dst + begin,end - begin,fill_value);
+                    });
+            }else{
+                const T fill_value = value;
+                par_detail::for_each_index(exec,out.size,out.data,(int *) nullptr,(int *) nullptr,
+                    [fill_value](const std::ptrdiff_t i, auto * dst, int *, int *){
+                        dst[i] = fill_value;
+                    });
+            }
+        }
+
+        // out[i] = in[0] op ... op in[i], in and out may be the same range
+        template<typename Exec, typename InRange, typename OutRange, typename BinaryOp>
+        inline void inclusive_scan(const Exec & exec, InRange && in_range, OutRange && out_range, BinaryOp op)noexcept{
+            const auto in = par_detail::make_view(exec,in_range);
+            const auto out = par_detail::make_view(exec,out_range);
+            typedef std::remove_cv_t<std::remove_reference_t<decltype(*out.data)>> E;
+            const std::ptrdiff_t n = in.size;
+            if (n <= 0){
+                return;
+            }
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            par_detail::scratch<E,Exec> partials((n + chunk - 1) / chunk);
+            par_detail::for_each_chunk(exec,n,chunk,in.data,partials.kernel_data(),(int *) nullptr,
+                [op](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * src, E * p, int *){
+                    E acc = src[begin];
+                    for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                        acc = op(acc,src[i]);
+                    }
+                    p[k] = acc;
+                });
+            // partial k becomes the carry into chunk k (chunk 0 has none)
+            partials.pull();
+            E carry = partials.host[0];
+            for (std::ptrdiff_t k = 1; k < partials.host.size(); ++k){
+                const E next = op(carry,partials.host[k]);
+                partials.host[k] = carry;
+                carry = next;
+            }
+            partials.push();
+            par_detail::for_each_chunk(exec,n,chunk,in.data,out.data,partials.kernel_data(),
+                [op](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * src, auto * dst, E * p){
+                    E acc = (k == 0) ? E(src[begin]):op(p[k],src[begin]);
+                    dst[begin] = acc;
+                    for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                        acc = op(acc,src[i]);
+                        dst[i] = acc;
+                    }
+                });
+        }
+
+        template<typename Exec, typename InRange, typename OutRange>
+        inline void inclusive_scan(const Exec & exec, InRange && in_range, OutRange && out_range)noexcept{
+            inclusive_scan(exec,in_range,out_range,std::plus<>());
+        }
+
+        // out[i] = init op in[0] op ... op in[i-1], in and out may be the same range
+        template<typename Exec, typename InRange, typename OutRange, typename T, typename BinaryOp>
+        inline void exclusive_scan(const Exec & exec, InRange && in_range, OutRange && out_range, T init, BinaryOp op)noexcept{
+            const auto in = par_detail::make_view(exec,in_range);
+            const auto out = par_detail::make_view(exec,out_range);
+            const std::ptrdiff_t n = in.size;
+            if (n <= 0){
+                return;
+            }
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            par_detail::scratch<T,Exec> partials((n + chunk - 1) / chunk);
+            par_detail::for_each_chunk(exec,n,chunk,in.data,partials.kernel_data(),(int *) nullptr,
+                [op](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * src, T * p, int *){
+                    T acc = src[begin];
+                    for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                        acc = op(acc,src[i]);
+                    }
+                    p[k] = acc;
+                });
+            partials.pull();
+            T carry = init;
+            for (std::ptrdiff_t k = 0; k < partials.host.size(); ++k){
+                const T next = op(carry,partials.host[k]);
+                partials.host[k] = carry;
+                carry = next;
+            }
+            partials.push();
+            par_detail::for_each_chunk(exec,n,chunk,in.data,out.data,partials.kernel_data(),
+                [op](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * src, auto * dst, T * p){
+                    T acc = p[k];
+                    for (std::ptrdiff_t i = begin; i < end; ++i){
+                        const T value = src[i];
+                        dst[i] = acc;
+                        acc = op(acc,value);
+                    }
+                });
+        }
+
+        template<typename Exec, typename InRange, typename OutRange, typename T>
+        inline void exclusive_scan(const Exec & exec, InRange && in_range, OutRange && out_range, T init)noexcept{
+            exclusive_scan(exec,in_range,out_range,init,std::plus<>());
+        }
+
+        // index of the first smallest/largest element, -1 for an empty range
+        template<typename Exec, typename Range>
+        inline std::ptrdiff_t argmin(const Exec & exec, Range && range)noexcept{
+            return par_detail::arg_extreme(exec,range,[](const auto & a, const auto & b){return a < b;}).index;
+        }
+
+        template<typename Exec, typename Range>
+        inline std::ptrdiff_t argmax(const Exec & exec, Range && range)noexcept{
+            return par_detail::arg_extreme(exec,range,[](const auto & a, const auto & b){return b < a;}).index;
+        }
+
+        // the range must not be empty
+        template<typename Exec, typename Range>
+        inline auto min(const Exec & exec, Range && range)noexcept{
+            const auto in = par_detail::make_view(exec,range);
+            typedef std::remove_cv_t<std::remove_reference_t<decltype(*in.data)>> E;
+            if constexpr (par_detail::use_kernels_v<Exec,E>){
+                return par_detail::host_chunk_reduce<E>(exec,in.data,in.size,
+                    [](const E * first, const std::ptrdiff_t count){return kernels::min(first,count);},
+                    [](const E a, const E b){return (b < a) ? b:a;});
+            }else{
+                return par_detail::arg_extreme(exec,range,[](const auto & a, const auto & b){return a < b;}).value;
+            }
+        }
+
+        template<typename Exec, typename Range>
+        inline auto max(const Exec & exec, Range && range)noexcept{
+            const auto in = par_detail::make_view(exec,range);
+            typedef std::remove_cv_t<std::remove_reference_t<decltype(*in.data)>> E;
+            if constexpr (par_detail::use_kernels_v<Exec,E>){
+                return par_detail::host_chunk_reduce<E>(exec,in.data,in.size,
+                    [](const E * first, const std::ptrdiff_t count){return kernels::max(first,count);},
+                    [](const E a, const E b){return (a < b) ? b:a;});
+            }else{
+                return par_detail::arg_extreme(exec,range,[](const auto & a, const auto & b){return b < a;}).value;
+            }
+        }
+
+        template<typename Exec, typename Range, typename UnaryPredicate>
+        inline std::ptrdiff_t count_if(const Exec & exec, Range && range, UnaryPredicate pred)noexcept{
+            return transform_reduce(exec,range,std::ptrdiff_t(0),std::plus<>(),
+                [pred](const auto & x){return static_cast<std::ptrdiff_t>(pred(x) ? 1:0);});
+        }
+
+        // stable, out has to hold as many elements as in (or at least as many as pass), returns the number copied
+        template<typename Exec, typename InRange, typename OutRange, typename UnaryPredicate>
+        inline std::ptrdiff_t copy_if(const Exec & exec, InRange && in_range, OutRange && out_range, UnaryPredicate pred)noexcept{
+            const auto in = par_detail::make_view(exec,in_range);
+            const auto out = par_detail::make_view(exec,out_range);
+            const std::ptrdiff_t n = in.size;
+            if (n <= 0){
+                return 0;
+            }
+            const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+            par_detail::scratch<std::ptrdiff_t,Exec> offsets((n + chunk - 1) / chunk);
+            par_detail::for_each_chunk(exec,n,chunk,in.data,offsets.kernel_data(),(int *) nullptr,
+                [pred](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * src, std::ptrdiff_t * p, int *){
+                    std::ptrdiff_t count = 0;
+                    for (std::ptrdiff_t i = begin; i < end; ++i){
+                        count += static_cast<std::ptrdiff_t>(pred(src[i]) ? 1:0);
+                    }
+                    p[k] = count;
+                });
+            offsets.pull();
+            std::ptrdiff_t total = 0;
+            for (std::ptrdiff_t k = 0; k < offsets.host.size(); ++k){
+                const std::ptrdiff_t count = offsets.host[k];
+                offsets.host[k] = total;
+                total += count;
+            }
+            offsets.push();
+            par_detail::for_each_chunk(exec,n,chunk,in.data,out.data,offsets.kernel_data(),
+                [pred](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto * src, auto * dst, std::ptrdiff_t * p){
+                    std::ptrdiff_t w = p[k];
+                    for (std::ptrdiff_t i = begin; i < end; ++i){
+                        if (pred(src[i])){
+                            dst[w] = src[i];
+                            ++w;
+                        }
+                    }
+                });
+            return total;
+        }
+    }
+}
+#endif
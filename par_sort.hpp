@@ -0,0 +1,410 @@
+// parallel sort and sort_by_key for the hopeless::par execution spaces (par.hpp), on the host copy or the device copy
+// integral and floating point keys with the default order go through an LSD radix sort (8 bit digits, per chunk
+// histograms, a pass is skipped when every key has the same digit), anything else (or a custom comparator) goes
+// through a bottom up merge sort where every level is split into equal output blocks by a co-rank binary search,
+// both are stable, the scratch buffers come from the container's allocator (omp_target_alloc on the device)
+//      hopeless::par::sort(hopeless::par::host,keys);
+//      hopeless::par::sort_by_key(hopeless::par::target<>,keys,values);
+// NOTE! elements are moved by plain assignment through raw scratch memory, so they have to be trivially copyable
+#pragma once
+
+#ifndef HOPELESS_PAR_SORT
+#define HOPELESS_PAR_SORT
+
+#include<iostream>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<type_traits>
+#include<functional>
+#include<memory>
+#include<tuple>
+#include<utility>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "par.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    namespace par
+    {
+        namespace sort_detail
+        {
+            enum : std::ptrdiff_t {radix = 256, digit_bits = 8, insertion_run = 32, max_radix_chunks = 16384};
+
+            template<typename K>
+            inline constexpr bool is_radix_sortable_v = (std::is_integral_v<K> && !std::is_same_v<K,bool>)
+                || (std::is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+
+            template<std::size_t bytes> struct unsigned_of;
+            template<> struct unsigned_of<1>{typedef std::uint8_t type;};
+            template<> struct unsigned_of<2>{typedef std::uint16_t type;};
+            template<> struct unsigned_of<4>{typedef std::uint32_t type;};
+            template<> struct unsigned_of<8>{typedef std::uint64_t type;};
+
+            #pragma omp declare target
+            // unsigned image of a key that sorts the same way as the key
+            template<typename K>
+            inline typename unsigned_of<sizeof(K)>::type radix_bits(const K key)noexcept{
+                typedef typename unsigned_of<sizeof(K)>::type U;
+                constexpr U sign = U(1) << (sizeof(K) * 8 - 1);
+                U u;
+                std::memcpy(&u,&key,sizeof(K));
+                if constexpr (std::is_floating_point_v<K>){
+                    return (u & sign) ? U(~u):U(u | sign);
+                }else if constexpr (std::is_signed_v<K>){
+                    return u ^ sign;
+                }else{
+                    return u;
+                }
+            }
+
+            template<typename K>
+            inline std::ptrdiff_t digit_of(const K key, const int shift)noexcept{
+                return static_cast<std::ptrdiff_t>((radix_bits(key) >> shift) & (radix - 1));
+            }
+
+            // number of elements of the merged output [0,o) that come from a (stable, a first on ties)
+            template<typename K, typename Compare>
+            inline std::ptrdiff_t co_rank(const std::ptrdiff_t o, const K * a, const std::ptrdiff_t na,
+                                          const K * b, const std::ptrdiff_t nb, const Compare & comp)noexcept{
+                std::ptrdiff_t lo = (o > nb) ? o - nb:0;
+                std::ptrdiff_t hi = (o < na) ? o:na;
+                while (lo < hi){
+                    const std::ptrdiff_t i = (lo + hi) / 2;
+                    const std::ptrdiff_t j = o - i;
+                    if ((j > 0) && !comp(b[j-1],a[i])){
+                        lo = i + 1;     // a[i] goes before b[j-1], take more from a
+                    }else{
+                        hi = i;
+                    }
+                }
+                return lo;
+            }
+            #pragma omp end declare target
+
+            // f(k,begin,end,ptrs) for every chunk k of [0,n), ptrs is a tuple of data pointers, on the device it is
+            // copied in firstprivate so the pointers keep their device addresses
+            template<typename Ptrs, typename F>
+            inline void for_each_chunk(const host_space &, const std::ptrdiff_t n, const std::ptrdiff_t chunk, Ptrs ptrs, F f)noexcept{
+                const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+                #pragma omp parallel for schedule(static) if(chunks > 1)
+                for (std::ptrdiff_t k = 0; k < chunks; ++k){
+                    const std::ptrdiff_t begin = k * chunk;
+                    f(k,begin,(begin + chunk < n) ? begin + chunk:n,ptrs);
+                }
+            }
+
+            template<int dev_no, typename Ptrs, typename F>
+            inline void for_each_chunk(const target_space<dev_no> &, const std::ptrdiff_t n, const std::ptrdiff_t chunk, Ptrs ptrs, F f)noexcept{
+                const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+                #pragma omp target teams distribute parallel for firstprivate(ptrs) device(dev_no)
+                for (std::ptrdiff_t k = 0; k < chunks; ++k){
+                    const std::ptrdiff_t begin = k * chunk;
+                    f(k,begin,(begin + chunk < n) ? begin + chunk:n,ptrs);
+                }
+            }
+
+            // n uninitialised elements, from alloc on the host or omp_target_alloc for a target_space
+            template<typename T, typename Exec, typename Allocator = hopeless::allocator<T>>
+            struct sort_buffer
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+
+                T * data;
+                std::ptrdiff_t count;
+                Allocator alloc;
+
+                sort_buffer(const std::ptrdiff_t n, const Allocator & allocator = Allocator())noexcept
+                    :data(nullptr),
+                    count(n),
+                    alloc(allocator)
+                {
+                    if (n <= 0){
+                        return;
+                    }
+                    if constexpr (par_detail::is_target<Exec>::value){
+                        data = (T *) omp_target_alloc(n * sizeof(T),Exec::device);
+                        if (!data){
+                            std::cerr<<"ERROR par sort failed to allocate scratch memory on offload device"<<std::endl;
+                        }
+                    }else{
+                        data = std::allocator_traits<Allocator>::allocate(alloc,n);
+                        if (!data){
+                            std::cerr<<"ERROR par sort failed to allocate scratch memory"<<std::endl;
+                        }
+                    }
+                }
+                sort_buffer(const sort_buffer &) = delete;
+                sort_buffer& operator =(const sort_buffer &) = delete;
+                ~sort_buffer()noexcept{
+                    if (!data){
+                        return;
+                    }
+                    if constexpr (par_detail::is_target<Exec>::value){
+                        omp_target_free(data,Exec::device);
+                    }else{
+                        std::allocator_traits<Allocator>::deallocate(alloc,data,count);
+                    }
+                }
+            };
+
+            // the range's own allocator rebound to T if it has one
+            template<typename T, typename Range>
+            inline auto scratch_allocator(const Range & range, int)noexcept
+                -> type_<typename std::allocator_traits<std::remove_cv_t<std::remove_reference_t<decltype(range.get_allocator())>>>::template rebind_alloc<T>,
+                    decltype(range.get_allocator())>
+            {
+                return typename std::allocator_traits<std::remove_cv_t<std::remove_reference_t<decltype(range.get_allocator())>>>::template rebind_alloc<T>(range.get_allocator());
+            }
+
+            template<typename T, typename Range>
+            inline hopeless::allocator<T> scratch_allocator(const Range &, long)noexcept{
+                return hopeless::allocator<T>();
+            }
+
+            template<typename Exec, typename T>
+            inline void copy_back(const Exec & exec, const std::ptrdiff_t n, T * src, T * dst)noexcept{
+                par_detail::for_each_index(exec,n,src,dst,(int *) nullptr,
+                    [](const std::ptrdiff_t i, T * s, T * d, int *){
+                        d[i] = s[i];
+                    });
+            }
+
+            inline std::ptrdiff_t radix_chunk(const host_space & exec, const std::ptrdiff_t n)noexcept{
+                return par_detail::chunk_size(exec,n);
+            }
+
+            // the per chunk histograms are radix entries each, so the chunk count is capped
+            template<int dev_no>
+            inline std::ptrdiff_t radix_chunk(const target_space<dev_no> & exec, const std::ptrdiff_t n)noexcept{
+                const std::ptrdiff_t chunk = par_detail::chunk_size(exec,n);
+                const std::ptrdiff_t min_chunk = (n + max_radix_chunks - 1) / max_radix_chunks;
+                return (chunk > min_chunk) ? chunk:min_chunk;
+            }
+
+            // values is only touched if has_values, keys_tmp and values_tmp hold n elements each
+            template<bool has_values, typename Exec, typename K, typename V>
+            inline void radix_sort(const Exec & exec, K * keys, V * values, K * keys_tmp, V * values_tmp, const std::ptrdiff_t n)noexcept{
+                const std::ptrdiff_t chunk = radix_chunk(exec,n);
+                const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+                sort_buffer<std::ptrdiff_t,Exec> hist(chunks * radix);
+                par_detail::scratch<std::ptrdiff_t,Exec> bases(radix);
+                if (!hist.data || (par_detail::is_target<Exec>::value && !bases.dev)){
+                    return;
+                }
+                K * src_k = keys;
+                K * dst_k = keys_tmp;
+                V * src_v = values;
+                V * dst_v = values_tmp;
+                for (int shift = 0; shift < static_cast<int>(sizeof(K) * 8); shift += digit_bits){
+                    // count the digits of every chunk
+                    par_detail::for_each_chunk(exec,n,chunk,src_k,hist.data,(int *) nullptr,
+                        [shift](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, K * src, std::ptrdiff_t * h, int *){
+                            std::ptrdiff_t * hk = h + k * radix;
+                            for (std::ptrdiff_t d = 0; d < radix; ++d){
+                                hk[d] = 0;
+                            }
+                            for (std::ptrdiff_t i = begin; i < end; ++i){
+                                ++hk[digit_of(src[i],shift)];
+                            }
+                        });
+                    // per digit exclusive scan over the chunks, the digit totals go to bases
+                    par_detail::for_each_index(exec,radix,hist.data,bases.kernel_data(),(int *) nullptr,
+                        [chunks](const std::ptrdiff_t d, std::ptrdiff_t * h, std::ptrdiff_t * t, int *){
+                            std::ptrdiff_t running = 0;
+                            for (std::ptrdiff_t k = 0; k < chunks; ++k){
+                                const std::ptrdiff_t count = h[k * radix + d];
+                                h[k * radix + d] = running;
+                                running += count;
+                            }
+                            t[d] = running;
+                        });
+                    bases.pull();
+                    bool one_digit = false;
+                    std::ptrdiff_t base = 0;
+                    for (std::ptrdiff_t d = 0; d < radix; ++d){
+                        const std::ptrdiff_t count = bases.host[d];
+                        one_digit = one_digit || (count == n);
+                        bases.host[d] = base;
+                        base += count;
+                    }
+                    if (one_digit){
+                        continue;   // every key has this digit, the pass wouldn't move anything
+                    }
+                    bases.push();
+                    for_each_chunk(exec,n,chunk,std::make_tuple(src_k,dst_k,src_v,dst_v,hist.data,bases.kernel_data()),
+                        [shift](const std::ptrdiff_t k, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto ptrs){
+                            K * src = std::get<0>(ptrs);
+                            K * dst = std::get<1>(ptrs);
+                            std::ptrdiff_t * hk = std::get<4>(ptrs) + k * radix;
+                            const std::ptrdiff_t * b = std::get<5>(ptrs);
+                            for (std::ptrdiff_t i = begin; i < end; ++i){
+                                const std::ptrdiff_t d = digit_of(src[i],shift);
+                                const std::ptrdiff_t pos = b[d] + hk[d];
+                                ++hk[d];
+                                dst[pos] = src[i];
+                                if constexpr (has_values){
+                                    std::get<3>(ptrs)[pos] = std::get<2>(ptrs)[i];
+                                }
+                            }
+                        });
+                    std::swap(src_k,dst_k);
+                    std::swap(src_v,dst_v);
+                }
+                if (src_k != keys){
+                    copy_back(exec,n,src_k,keys);
+                    if constexpr (has_values){
+                        copy_back(exec,n,src_v,values);
+                    }
+                }
+            }
+
+            template<bool has_values, typename Exec, typename K, typename V, typename Compare>
+            inline void merge_sort(const Exec & exec, K * keys, V * values, K * keys_tmp, V * values_tmp, const std::ptrdiff_t n, Compare comp)noexcept{
+                // stable insertion sort of short runs
+                for_each_chunk(exec,n,insertion_run,std::make_tuple(keys,values),
+                    [comp](const std::ptrdiff_t, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto ptrs){
+                        K * k = std::get<0>(ptrs);
+                        for (std::ptrdiff_t i = begin + 1; i < end; ++i){
+                            const K key = k[i];
+                            std::ptrdiff_t j = i;
+                            if constexpr (has_values){
+                                V * v = std::get<1>(ptrs);
+                                const V value = v[i];
+                                for (; (j > begin) && comp(key,k[j-1]); --j){
+                                    k[j] = k[j-1];
+                                    v[j] = v[j-1];
+                                }
+                                v[j] = value;
+                            }else{
+                                for (; (j > begin) && comp(key,k[j-1]); --j){
+                                    k[j] = k[j-1];
+                                }
+                            }
+                            k[j] = key;
+                        }
+                    });
+                const std::ptrdiff_t block = par_detail::chunk_size(exec,n);
+                K * src_k = keys;
+                K * dst_k = keys_tmp;
+                V * src_v = values;
+                V * dst_v = values_tmp;
+                for (std::ptrdiff_t width = insertion_run; width < n; width *= 2){
+                    // every output block finds where its slice of the merged pair starts in both runs
+                    for_each_chunk(exec,n,block,std::make_tuple(src_k,dst_k,src_v,dst_v),
+                        [comp,width,n](const std::ptrdiff_t, const std::ptrdiff_t begin, const std::ptrdiff_t end, auto ptrs){
+                            const K * src = std::get<0>(ptrs);
+                            K * dst = std::get<1>(ptrs);
+                            std::ptrdiff_t pos = begin;
+                            while (pos < end){
+                                const std::ptrdiff_t pair_begin = (pos / (2 * width)) * (2 * width);
+                                const std::ptrdiff_t mid = (pair_begin + width < n) ? pair_begin + width:n;
+                                const std::ptrdiff_t pair_end = (pair_begin + 2 * width < n) ? pair_begin + 2 * width:n;
+                                const std::ptrdiff_t seg_end = (end < pair_end) ? end:pair_end;
+                                const K * a = src + pair_begin;
+                                const K * b = src + mid;
+                                const std::ptrdiff_t na = mid - pair_begin;
+                                const std::ptrdiff_t nb = pair_end - mid;
+                                std::ptrdiff_t i = co_rank(pos - pair_begin,a,na,b,nb,comp);
+                                std::ptrdiff_t j = pos - pair_begin - i;
+                                const std::ptrdiff_t i_end = co_rank(seg_end - pair_begin,a,na,b,nb,comp);
+                                const std::ptrdiff_t j_end = seg_end - pair_begin - i_end;
+                                for (std::ptrdiff_t w = pos; w < seg_end; ++w){
+                                    const bool take_b = (i >= i_end) || ((j < j_end) && comp(b[j],a[i]));
+                                    const std::ptrdiff_t from = take_b ? mid + j:pair_begin + i;
+                                    dst[w] = src[from];
+                                    if constexpr (has_values){
+                                        std::get<3>(ptrs)[w] = std::get<2>(ptrs)[from];
+                                    }
+                                    j += take_b;
+                                    i += !take_b;
+                                }
+                                pos = seg_end;
+                            }
+                        });
+                    std::swap(src_k,dst_k);
+                    std::swap(src_v,dst_v);
+                }
+                if (src_k != keys){
+                    copy_back(exec,n,src_k,keys);
+                    if constexpr (has_values){
+                        copy_back(exec,n,src_v,values);
+                    }
+                }
+            }
+
+            template<bool use_radix, typename Exec, typename KeyRange, typename Compare>
+            inline void sort_keys(const Exec & exec, KeyRange && key_range, Compare comp)noexcept{
+                const auto keys = par_detail::make_view(exec,key_range);
+                typedef std::remove_reference_t<decltype(*keys.data)> K;
+                const std::ptrdiff_t n = keys.size;
+                if (n <= 1){
+                    return;
+                }
+                sort_buffer<K,Exec,decltype(scratch_allocator<K>(key_range,0))> keys_tmp(n,scratch_allocator<K>(key_range,0));
+                if (!keys_tmp.data){
+                    return;
+                }
+                if constexpr (use_radix){
+                    radix_sort<false>(exec,keys.data,(char *) nullptr,keys_tmp.data,(char *) nullptr,n);
+                }else{
+                    merge_sort<false>(exec,keys.data,(char *) nullptr,keys_tmp.data,(char *) nullptr,n,comp);
+                }
+            }
+
+            template<bool use_radix, typename Exec, typename KeyRange, typename ValueRange, typename Compare>
+            inline void sort_pairs(const Exec & exec, KeyRange && key_range, ValueRange && value_range, Compare comp)noexcept{
+                const auto keys = par_detail::make_view(exec,key_range);
+                const auto values = par_detail::make_view(exec,value_range);
+                typedef std::remove_reference_t<decltype(*keys.data)> K;
+                typedef std::remove_reference_t<decltype(*values.data)> V;
+                const std::ptrdiff_t n = (keys.size < values.size) ? keys.size:values.size;
+                if (n <= 1){
+                    return;
+                }
+                sort_buffer<K,Exec,decltype(scratch_allocator<K>(key_range,0))> keys_tmp(n,scratch_allocator<K>(key_range,0));
+                sort_buffer<V,Exec,decltype(scratch_allocator<V>(value_range,0))> values_tmp(n,scratch_allocator<V>(value_range,0));
+                if (!keys_tmp.data || !values_tmp.data){
+                    return;
+                }
+                if constexpr (use_radix){
+                    radix_sort<true>(exec,keys.data,values.data,keys_tmp.data,values_tmp.data,n);
+                }else{
+                    merge_sort<true>(exec,keys.data,values.data,keys_tmp.data,values_tmp.data,n,comp);
+                }
+            }
+
+            template<typename Range>
+            using key_type_t = std::remove_cv_t<std::remove_reference_t<decltype(*par_detail::make_view(host,std::declval<Range>()).data)>>;
+        }
+
+        // ascending, radix sort for integral and floating point keys, merge sort otherwise
+        template<typename Exec, typename Range>
+        inline void sort(const Exec & exec, Range && range)noexcept{
+            typedef sort_detail::key_type_t<Range> K;
+            sort_detail::sort_keys<sort_detail::is_radix_sortable_v<K>>(exec,range,std::less<>());
+        }
+
+        // merge sort by comp
+        template<typename Exec, typename Range, typename Compare>
+        inline void sort(const Exec & exec, Range && range, Compare comp)noexcept{
+            sort_detail::sort_keys<false>(exec,range,comp);
+        }
+
+        // sorts keys ascending and applies the same permutation to values (stable)
+        template<typename Exec, typename KeyRange, typename ValueRange>
+        inline void sort_by_key(const Exec & exec, KeyRange && keys, ValueRange && values)noexcept{
+            typedef sort_detail::key_type_t<KeyRange> K;
+            sort_detail::sort_pairs<sort_detail::is_radix_sortable_v<K>>(exec,keys,values,std::less<>());
+        }
+
+        template<typename Exec, typename KeyRange, typename ValueRange, typename Compare>
+        inline void sort_by_key(const Exec & exec, KeyRange && keys, ValueRange && values, Compare comp)noexcept{
+            sort_detail::sort_pairs<false>(exec,keys,values,comp);
+        }
+    }
+}
+#endif
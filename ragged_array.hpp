@@ -16,13 +16,15 @@
 
 #include"dynarray.hpp"
 #include"dyn_extent_span.hpp"
+#include"simd_kernels.hpp"
 #include"hopeless_macros_n_meta.hpp"
 
 
 namespace hopeless{
-#ifdef HOPELESS_TARGET_OMP_DEV
+    // same OffloadPolicy as dynarray, data and indexing are only mirrored on the device for mirrored<dev_no>
     template<typename T,typename Allocator = hopeless::allocator<T>,
-                        int dev_no = HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>
+                        typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY,
+                        typename GrowthPolicy = HOPELESS_DYNARRAY_DEFAULT_GROWTH_POLICY>
     struct r2darray;
 
     template<typename InputIt>
@@ -39,17 +41,18 @@ namespace hopeless{
         return sum;
     }
 
-    template<typename T,typename Allocator,int dev_no>     
+#ifdef HOPELESS_TARGET_OMP_DEV
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>     
     auto inline operator <<(std::ostream& stream,
-        const r2darray<T,Allocator,dev_no> & r2darray) 
+        const r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy> & r2darray) 
             -> type_<std::ostream&, 
             decltype(std::cout<<std::declval<T>())>;  
 
-    template<typename T,typename Allocator,int dev_no>
-    void swap(r2darray<T,Allocator,dev_no>& r2darray1, r2darray<T,Allocator,dev_no>& r2darray2)noexcept;
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    void swap(r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray1, r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray2)noexcept;
 
-    template<typename T,typename Allocator,int dev_no>     
-    struct r2darray{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>     
+    struct r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>{
 
         static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
         static_assert(std::is_copy_constructible_v<T>, "type should be trivially copy constructible");
@@ -80,6 +83,8 @@ namespace hopeless{
         constexpr inline reference operator ()(const size_type i, const size_type j)const noexcept;
         constexpr inline reference operator ()(const size_type i, const size_type j)noexcept;
         #pragma omp end declare target
+        // row i of the device copy as a span on the host, for passing to target regions or par algorithms
+        constexpr inline dyn_extent_span<T> device_row(const size_type i)const noexcept;
 
         struct rand_access_iterator  
         {
@@ -176,6 +181,8 @@ namespace hopeless{
         r2darray( r2darray&& other, const Allocator& alloc)noexcept;
 
         r2darray( std::initializer_list<size_type> init,const Allocator& alloc = Allocator())noexcept;
+        // rows of the given sizes with the elements left uninitialised (and not mapped to the device), for output buffers
+        r2darray( std::initializer_list<size_type> init,for_overwrite_t,const Allocator& alloc = Allocator())noexcept;
         r2darray( std::initializer_list<std::initializer_list<T>> init,const Allocator& alloc = Allocator())noexcept;
 
         r2darray(const_iterator first,const_iterator last,const Allocator& alloc = Allocator())noexcept;
@@ -183,7 +190,7 @@ namespace hopeless{
         ~r2darray()noexcept;
         
         template<int dev_no2>
-        r2darray& operator =(const r2darray<T,Allocator,dev_no2> & other)noexcept;
+        r2darray& operator =(const r2darray<T,Allocator,mirrored<dev_no2>,GrowthPolicy> & other)noexcept;
 
         r2darray& operator =(const r2darray & other)noexcept;
         r2darray& operator =(r2darray && other)noexcept;
@@ -256,6 +263,9 @@ namespace hopeless{
         
         inline void map_to_omp_dev();
         inline void map_from_omp_dev();
+        // queue the element copies in batch instead, e.g. to send many arrays to the device with one wait
+        inline void map_to_omp_dev(transfer_batch<dev_no> & batch);
+        inline void map_from_omp_dev(transfer_batch<dev_no> & batch);
     private:
         // please don't use this elsewhere it is badly written
         template<typename Not_empty, typename Maybe_Empty>        
@@ -277,16 +287,16 @@ namespace hopeless{
             }
         };
     protected:
-        dynarray<T,Allocator,dev_no> data_vec_;
+        dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> data_vec_;
         dyn_extent_span<T>* indexing_vec_;
         size_type size_;
         packed_pair<size_type,allocator_type> cap_alloc_;
         dyn_extent_span<T>* dev_indexing_vec_; // the copy on the default offloading device
     };
 
-    template<typename T,typename Allocator,int dev_no>     
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>     
     auto inline operator <<(std::ostream& stream,
-        const r2darray<T,Allocator,dev_no> & r2darray) 
+        const r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy> & r2darray) 
             -> type_<std::ostream&, 
                 decltype(std::cout<<std::declval<T>())>
     {
@@ -303,33 +313,38 @@ namespace hopeless{
     }
 
 
-    template<typename T,typename Allocator,int dev_no>
-    void swap(r2darray<T,Allocator,dev_no>& r2darray1, r2darray<T,Allocator,dev_no>& r2darray2)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    void swap(r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray1, r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray2)noexcept{
         r2darray1.swap(r2darray2);
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,dev_no>::operator [](const size_type i)const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator [](const size_type i)const noexcept{
         return indexing_vec_[i];
     }
 
     #pragma omp declare target device_type(nohost)
-    template<typename T,typename Allocator,int dev_no>    
-    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,dev_no>::operator ()(const size_type i)const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator ()(const size_type i)const noexcept{
         return dev_indexing_vec_[i];
     }
-    template<typename T,typename Allocator,int dev_no>    
-    constexpr inline r2darray<T,Allocator,dev_no>::reference r2darray<T,Allocator,dev_no>::operator ()(const size_type i, const size_type j)const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator ()(const size_type i, const size_type j)const noexcept{
         return dev_indexing_vec_[i][j];
     }
-    template<typename T,typename Allocator,int dev_no>    
-    constexpr inline r2darray<T,Allocator,dev_no>::reference r2darray<T,Allocator,dev_no>::operator ()(const size_type i, const size_type j)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reference r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator ()(const size_type i, const size_type j)noexcept{
         return dev_indexing_vec_[i][j];
     }
     #pragma omp end declare target
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::device_row(const size_type i)const noexcept{
+        return dyn_extent_span<T>(data_vec_.device_data() + (indexing_vec_[i].data() - data_vec_.data()),indexing_vec_[i].size());
+    }
     
-    template<typename T,typename Allocator,int dev_no>
-    void r2darray<T,Allocator,dev_no>::swap(r2darray & rhs)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>
+    void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::swap(r2darray & rhs)noexcept{
         using std::swap;
         swap(this->data_vec_,rhs.data_vec_);
         swap(this->indexing_vec_,rhs.indexing_vec_);
@@ -338,8 +353,8 @@ namespace hopeless{
         swap(this->dev_indexing_vec_,rhs.dev_indexing_vec_);
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    constexpr r2darray<T,Allocator,dev_no>::r2darray()noexcept(noexcept(Allocator()))        
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray()noexcept(noexcept(Allocator()))        
         :data_vec_(Allocator()),
         indexing_vec_(nullptr),
         size_(0),
@@ -347,8 +362,8 @@ namespace hopeless{
         dev_indexing_vec_(nullptr)
     {}
     
-    template<typename T,typename Allocator,int dev_no>    
-    constexpr r2darray<T,Allocator,dev_no>::r2darray(const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    constexpr r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(const Allocator& alloc)noexcept
         :data_vec_(alloc),
         indexing_vec_(nullptr),
         size_(0),
@@ -356,8 +371,8 @@ namespace hopeless{
         dev_indexing_vec_(nullptr)
     {}
     
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(const r2darray& other)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(const r2darray& other)noexcept
         :data_vec_(other.data_vec_,std::allocator_traits<allocator_type>::select_on_container_copy_construction(
         other.get_allocator())),
         indexing_vec_(nullptr),
@@ -370,8 +385,8 @@ namespace hopeless{
         construct_span_indexing(other.indexing_vec_);
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(const r2darray& other, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(const r2darray& other, const Allocator& alloc)noexcept
         :data_vec_(other.data_vec_,alloc),
         indexing_vec_(other.indexing_vec_),
         size_(other.size()),
@@ -382,8 +397,8 @@ namespace hopeless{
         construct_span_indexing(other.indexing_vec_);
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(r2darray&& other)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(r2darray&& other)noexcept
         :data_vec_(),
         indexing_vec_(nullptr),
         size_(0),
@@ -394,9 +409,9 @@ namespace hopeless{
         swap(*this,std::forward<r2darray&>(other));
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(r2darray&& other,const Allocator& alloc)noexcept
-        :data_vec_(std::forward<dynarray<T,Allocator,dev_no>&&>(other.data_vec_),alloc),
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(r2darray&& other,const Allocator& alloc)noexcept
+        :data_vec_(std::forward<dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>&&>(other.data_vec_),alloc),
         indexing_vec_(other.indexing_vec_),
         size_(other.size()),
         cap_alloc_(other.size(),alloc),
@@ -406,8 +421,8 @@ namespace hopeless{
         construct_span_indexing(other.indexing_vec_);
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(std::initializer_list<size_type> init,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(std::initializer_list<size_type> init,const Allocator& alloc)noexcept
         :data_vec_(std::reduce(init.begin(),init.end(),0),alloc),
         indexing_vec_(nullptr),
         size_(init.size()),
@@ -418,8 +433,20 @@ namespace hopeless{
         construct_span_indexing(std::forward<std::initializer_list<size_type>&>(init));
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(std::initializer_list<std::initializer_list<T>> init,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(std::initializer_list<size_type> init,for_overwrite_t,const Allocator& alloc)noexcept
+        :data_vec_(std::reduce(init.begin(),init.end(),0),for_overwrite,alloc),
+        indexing_vec_(nullptr),
+        size_(init.size()),
+        cap_alloc_(init.size(),alloc),
+        dev_indexing_vec_(nullptr)
+    {
+        create_indexing_buffer();
+        construct_span_indexing(std::forward<std::initializer_list<size_type>&>(init));
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(std::initializer_list<std::initializer_list<T>> init,const Allocator& alloc)noexcept
         :data_vec_(alloc),
         indexing_vec_(nullptr),
         size_(init.size()),
@@ -436,8 +463,8 @@ namespace hopeless{
         construct_span_indexing(std::forward<std::initializer_list<std::initializer_list<T>>&>(init));
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::r2darray(const_iterator first,const_iterator last,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::r2darray(const_iterator first,const_iterator last,const Allocator& alloc)noexcept
         :data_vec_(alloc),
         indexing_vec_(nullptr),
         size_(last - first),
@@ -454,8 +481,8 @@ namespace hopeless{
         construct_span_indexing(first);
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    r2darray<T,Allocator,dev_no>::~r2darray()noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::~r2darray()noexcept
     {
         try{
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -467,9 +494,9 @@ namespace hopeless{
         omp_target_free(dev_indexing_vec_,dev_no);
     }
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<int dev_no2>   
-    r2darray<T,Allocator,dev_no>& r2darray<T,Allocator,dev_no>::operator=(const r2darray<T,Allocator,dev_no2> & other)noexcept
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator=(const r2darray<T,Allocator,mirrored<dev_no2>,GrowthPolicy> & other)noexcept
     {
         data_vec_ = other.data_vec_;
         size_ = other.size();
@@ -491,8 +518,8 @@ namespace hopeless{
         return *this;
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    r2darray<T,Allocator,dev_no>& r2darray<T,Allocator,dev_no>::operator=(const r2darray & other)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator=(const r2darray & other)noexcept
     {
         data_vec_ = other.data_vec_;
         size_ = other.size();
@@ -514,16 +541,16 @@ namespace hopeless{
         return *this;
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    r2darray<T,Allocator,dev_no>& r2darray<T,Allocator,dev_no>::operator=(r2darray && other)noexcept
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>& r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::operator=(r2darray && other)noexcept
     {
         using std::swap;
         swap(*this, std::forward<r2darray&>(other));
         return *this;
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    inline void r2darray<T,Allocator,dev_no>::create_indexing_buffer()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::create_indexing_buffer()noexcept{
         dspan_alloctor_type dspan_alloc(cap_alloc_.y());
         auto temp = std::allocator_traits<dspan_alloctor_type>::allocate(dspan_alloc,capacity());
         if (temp){
@@ -538,8 +565,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    void r2darray<T,Allocator,dev_no>::construct_span_indexing(const dyn_extent_span<T> otheridx[])noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_span_indexing(const dyn_extent_span<T> otheridx[])noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -570,8 +597,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    void r2darray<T,Allocator,dev_no>::construct_span_indexing(std::initializer_list<size_type>& init)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_span_indexing(std::initializer_list<size_type>& init)noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -610,8 +637,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    void r2darray<T,Allocator,dev_no>::construct_span_indexing(std::initializer_list<std::initializer_list<T>> & init)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_span_indexing(std::initializer_list<std::initializer_list<T>> & init)noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -650,8 +677,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    void r2darray<T,Allocator,dev_no>::construct_span_indexing(const_iterator first)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::construct_span_indexing(const_iterator first)noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -684,8 +711,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    inline void r2darray<T,Allocator,dev_no>::create_dev_indexing_buffer()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::create_dev_indexing_buffer()noexcept{
         auto temp =(dyn_extent_span<T>*)omp_target_alloc(capacity()*sizeof(dyn_extent_span<T>),dev_no);
         if (temp){
             dev_indexing_vec_ = temp;
@@ -695,8 +722,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no>    
-    void r2darray<T,Allocator,dev_no>::reset_indexing_spans()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>    
+    void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reset_indexing_spans()noexcept{
         if (((bool)(size()))){
             const difference_type offset = data_vec_.data()-indexing_vec_[0].data();  
             indexing_vec_[0].change_span_ptr(data_vec_.data());
@@ -718,84 +745,84 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::allocator_type r2darray<T,Allocator,dev_no>::get_allocator()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::allocator_type r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::get_allocator()const noexcept{
         return cap_alloc_.y();
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::size_type r2darray<T,Allocator,dev_no>::size()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size_type r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size()const noexcept{
         return size_;
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::size_type r2darray<T,Allocator,dev_no>::capacity()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::size_type r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::capacity()const noexcept{
         return cap_alloc_.x();
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::iterator r2darray<T,Allocator,dev_no>::begin()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::begin()noexcept{
         return iterator(indexing_vec_);
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_iterator r2darray<T,Allocator,dev_no>::begin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::begin()const noexcept{
         return const_iterator(indexing_vec_);
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_iterator r2darray<T,Allocator,dev_no>::cbegin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::cbegin()const noexcept{
         return const_iterator(indexing_vec_);
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::iterator r2darray<T,Allocator,dev_no>::end()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::end()noexcept{
         return iterator(indexing_vec_+size());
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_iterator r2darray<T,Allocator,dev_no>::end()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::end()const noexcept{
         return const_iterator(indexing_vec_+size());
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_iterator r2darray<T,Allocator,dev_no>::cend()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::cend()const noexcept{
         return const_iterator(indexing_vec_+size());
     }
 
 
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::reverse_iterator r2darray<T,Allocator,dev_no>::rbegin()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reverse_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rbegin()noexcept{
         return reverse_iterator(iterator(indexing_vec_));
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_reverse_iterator r2darray<T,Allocator,dev_no>::rbegin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rbegin()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_));
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_reverse_iterator r2darray<T,Allocator,dev_no>::crbegin()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::crbegin()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_));
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::reverse_iterator r2darray<T,Allocator,dev_no>::rend()noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::reverse_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rend()noexcept{
         return reverse_iterator(iterator(indexing_vec_+size()));
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_reverse_iterator r2darray<T,Allocator,dev_no>::rend()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rend()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_+size()));
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    constexpr inline r2darray<T,Allocator,dev_no>::const_reverse_iterator r2darray<T,Allocator,dev_no>::crend()const noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::crend()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_+size()));
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::resize(size_type new_size)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize(size_type new_size)noexcept{
         if (new_size > capacity()){
 
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -848,8 +875,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::resize_row(size_type row,size_type new_size,const T & fill)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize_row(size_type row,size_type new_size,const T & fill)noexcept{
         if (new_size == indexing_vec_[row].size()){
             return;
         }
@@ -867,7 +894,7 @@ namespace hopeless{
                     dev_indexing_vec_[i].change_span_ptr(dev_indexing_vec_[i].data()+new_elements_count);
                 }
             }
-            typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size()); 
+            typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size()); 
             data_vec_.insert(pos,new_elements_count,fill);           
             indexing_vec_[row].resize(new_size);
             #pragma omp parallel for
@@ -884,7 +911,7 @@ namespace hopeless{
                     dev_indexing_vec_[i].change_span_ptr(dev_indexing_vec_[i].data()-erase_elements_count);
                 }
             }
-            typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size());
+            typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size());
             data_vec_.erase(pos - erase_elements_count,pos);
             indexing_vec_[row].resize(new_size);
             #pragma omp parallel for
@@ -894,8 +921,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::resize_row(iterator row,size_type new_size,const T & fill)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::resize_row(iterator row,size_type new_size,const T & fill)noexcept{
         if (new_size == row->size()){
             return;
         } 
@@ -914,7 +941,7 @@ namespace hopeless{
                     dev_indexing_vec_[i].change_span_ptr(dev_indexing_vec_[i].data()+new_elements_count);
                 }
             }
-            typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(row->data()+row->size()); 
+            typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(row->data()+row->size()); 
             data_vec_.insert(pos,new_elements_count,fill);           
             row->resize(new_size);
 
@@ -933,7 +960,7 @@ namespace hopeless{
                     dev_indexing_vec_[i].change_span_ptr(dev_indexing_vec_[i].data()-erase_elements_count);
                 }
             }
-            typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(row->data()+row->size());
+            typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(row->data()+row->size());
             data_vec_.erase(pos - erase_elements_count,pos);
             row->resize(new_size);
             #pragma omp parallel for
@@ -943,8 +970,8 @@ namespace hopeless{
         }
     }
     
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::erase_row(size_type row)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::erase_row(size_type row)noexcept{
         #pragma omp target map(to:row) device(dev_no)
         {
             #pragma omp loop
@@ -955,7 +982,7 @@ namespace hopeless{
                 dev_indexing_vec_[i-1] = dev_indexing_vec_[i];
             }
         }
-        typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(indexing_vec_[row].data());
+        typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data());
         data_vec_.erase(pos,pos + indexing_vec_[row].size());
         #pragma omp parallel for
         for (size_type i = row+1; i < size(); ++i){
@@ -967,8 +994,8 @@ namespace hopeless{
         size_-=1;
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::erase_row(iterator row)noexcept{
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::erase_row(iterator row)noexcept{
         const difference_type row_pos = row - begin();
         #pragma omp target map(to:row_pos) device(dev_no)
         {
@@ -980,7 +1007,7 @@ namespace hopeless{
                 dev_indexing_vec_[i-1] = dev_indexing_vec_[i];
             }
         }
-        typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(row->data());
+        typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(row->data());
         data_vec_.erase(pos,pos + row->size());
         #pragma omp parallel for
         for (size_type i = row_pos+1; i < size(); ++i){
@@ -992,9 +1019,9 @@ namespace hopeless{
         size_-=1;
     }
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<typename Container>
-    inline auto r2darray<T,Allocator,dev_no>::insert_row(size_type row, const Container & container)    
+    inline auto r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert_row(size_type row, const Container & container)    
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1006,7 +1033,7 @@ namespace hopeless{
             data_vec_.grow_reserve_no_map(data_vec_.size() + new_elements_count);     // any pointer invalidation happens here
             reset_indexing_spans();
         }
-        typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(indexing_vec_[row].data());
+        typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data());
         data_vec_.insert(pos, container.begin(),container.end());
         #pragma omp target map(to:row,new_elements_count)
         {
@@ -1031,9 +1058,9 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<typename Container>
-    inline auto r2darray<T,Allocator,dev_no>::insert_row(iterator row, const Container & container)    
+    inline auto r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::insert_row(iterator row, const Container & container)    
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1046,7 +1073,7 @@ namespace hopeless{
             data_vec_.grow_reserve_no_map(data_vec_.size() + new_elements_count);     // any pointer invalidation happens here
             reset_indexing_spans();
         }
-        typename dynarray<T,Allocator,dev_no>::rand_access_iterator pos(indexing_vec_[row_pos].data());
+        typename dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row_pos].data());
         data_vec_.insert(pos, container.begin(),container.end());
         #pragma omp target map(to:row_pos,new_elements_count)
         {
@@ -1072,9 +1099,9 @@ namespace hopeless{
     }
     
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<typename Container, typename index_container>
-    inline auto r2darray<T,Allocator,dev_no>::buffered_insert(const Container & insert_elements,const  index_container & row_indices,const index_container & column_indices)     
+    inline auto r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_insert(const Container & insert_elements,const  index_container & row_indices,const index_container & column_indices)     
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1127,9 +1154,9 @@ namespace hopeless{
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(insert_data_vec_idx),new_elements_count);
     }
 
-    template<typename T,typename Allocator,int dev_no> 
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
     template<typename index_container>
-    inline auto r2darray<T,Allocator,dev_no>::buffered_erase(const index_container & row_indices,const index_container & column_indices)            
+    inline auto r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::buffered_erase(const index_container & row_indices,const index_container & column_indices)            
         -> type_<void,
             decltype(std::declval<index_container>().begin()),
             decltype(std::declval<index_container>().end()),
@@ -1170,51 +1197,44 @@ namespace hopeless{
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(erase_data_vec_idx),erase_elements_count);    
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::map_to_omp_dev(){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_to_omp_dev(){
         data_vec_.map_data_to_omp_dev();
     }
 
-    template<typename T,typename Allocator,int dev_no> 
-    inline void r2darray<T,Allocator,dev_no>::map_from_omp_dev(){
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_from_omp_dev(){
         data_vec_.map_data_from_omp_dev();
     }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_to_omp_dev(transfer_batch<dev_no> & batch){
+        data_vec_.map_data_to_omp_dev(batch);
+    }
+
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,mirrored<dev_no>,GrowthPolicy>::map_from_omp_dev(transfer_batch<dev_no> & batch){
+        data_vec_.map_data_from_omp_dev(batch);
+    }
     /*
     // I may never implement this, indexing multidimensional jagged arrays is quite inefficient
-    template<typename T,typename Allocator,int dev_no>     
+    template<typename T,typename Allocator,int dev_no,typename GrowthPolicy>     
     struct rndarray{
-        dynarray<T,Allocator,dev_no> data_vec_;
+        dynarray<T,Allocator,mirrored<dev_no>,GrowthPolicy> data_vec_;
         r2darray<dyn_extent_span<T>,Allocator,dev_no> indexing_vec_;
     };*/
-#else
-    template<typename T,typename Allocator = hopeless::allocator<T>>
-    struct r2darray;
-
-    template<typename InputIt>
-    constexpr inline auto count_elements(const InputIt first, const InputIt last)noexcept 
-        -> type_<std::ptrdiff_t,
-            decltype((*first).size()),
-            decltype(first != last)
-            >
-    {
-        std::ptrdiff_t sum = 0;
-        for (auto i = first; i != last; ++i){
-            sum += (*i).size();
-        }
-        return sum;
-    }
-
-    template<typename T,typename Allocator>     
+#endif
+    template<typename T,typename Allocator,typename GrowthPolicy>     
     auto inline operator <<(std::ostream& stream,
-        const r2darray<T,Allocator> & r2darray) 
+        const r2darray<T,Allocator,host_only,GrowthPolicy> & r2darray) 
             -> type_<std::ostream&, 
             decltype(std::cout<<std::declval<T>())>;  
 
-    template<typename T,typename Allocator>
-    void swap(r2darray<T,Allocator>& r2darray1, r2darray<T,Allocator>& r2darray2)noexcept;
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    void swap(r2darray<T,Allocator,host_only,GrowthPolicy>& r2darray1, r2darray<T,Allocator,host_only,GrowthPolicy>& r2darray2)noexcept;
 
-    template<typename T,typename Allocator>     
-    struct r2darray{
+    template<typename T,typename Allocator,typename GrowthPolicy>     
+    struct r2darray<T,Allocator,host_only,GrowthPolicy>{
         struct rand_access_iterator;
         struct const_rand_access_iterator;
         typedef T value_type;
@@ -1333,6 +1353,8 @@ namespace hopeless{
         r2darray( r2darray&& other, const Allocator& alloc)noexcept;
 
         r2darray( std::initializer_list<size_type> init,const Allocator& alloc = Allocator())noexcept;
+        // rows of the given sizes with the elements left uninitialised (and not mapped to the device), for output buffers
+        r2darray( std::initializer_list<size_type> init,for_overwrite_t,const Allocator& alloc = Allocator())noexcept;
         r2darray( std::initializer_list<std::initializer_list<T>> init,const Allocator& alloc = Allocator())noexcept;
 
         r2darray(const_iterator first,const_iterator last,const Allocator& alloc = Allocator())noexcept;
@@ -1428,15 +1450,15 @@ namespace hopeless{
             }
         };
     protected:
-        dynarray<T,Allocator> data_vec_;
+        dynarray<T,Allocator,host_only,GrowthPolicy> data_vec_;
         dyn_extent_span<T>* indexing_vec_;
         size_type size_;
         packed_pair<size_type,allocator_type> cap_alloc_;
     };
 
-    template<typename T,typename Allocator>     
+    template<typename T,typename Allocator,typename GrowthPolicy>     
     auto inline operator <<(std::ostream& stream,
-        const r2darray<T,Allocator> & r2darray) 
+        const r2darray<T,Allocator,host_only,GrowthPolicy> & r2darray) 
             -> type_<std::ostream&, 
                 decltype(std::cout<<std::declval<T>())>
     {
@@ -1453,32 +1475,32 @@ namespace hopeless{
     }
 
 
-    template<typename T,typename Allocator>
-    void swap(r2darray<T,Allocator>& r2darray1, r2darray<T,Allocator>& r2darray2)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    void swap(r2darray<T,Allocator,host_only,GrowthPolicy>& r2darray1, r2darray<T,Allocator,host_only,GrowthPolicy>& r2darray2)noexcept{
         r2darray1.swap(r2darray2);
     }
 
-    template<typename T,typename Allocator>    
-    constexpr inline dyn_extent_span<T> r2darray<T,Allocator>::operator [](const size_type i)const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,host_only,GrowthPolicy>::operator [](const size_type i)const noexcept{
         return indexing_vec_[i];
     }
 
-    template<typename T,typename Allocator>    
-    constexpr inline dyn_extent_span<T> r2darray<T,Allocator>::operator ()(const size_type i)const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    constexpr inline dyn_extent_span<T> r2darray<T,Allocator,host_only,GrowthPolicy>::operator ()(const size_type i)const noexcept{
         return indexing_vec_[i];
     }
-    template<typename T,typename Allocator>    
-    constexpr inline r2darray<T,Allocator>::reference r2darray<T,Allocator>::operator ()(const size_type i, const size_type j)const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::reference r2darray<T,Allocator,host_only,GrowthPolicy>::operator ()(const size_type i, const size_type j)const noexcept{
         return indexing_vec_[i][j];
     }
-    template<typename T,typename Allocator>    
-    constexpr inline r2darray<T,Allocator>::reference r2darray<T,Allocator>::operator ()(const size_type i, const size_type j)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::reference r2darray<T,Allocator,host_only,GrowthPolicy>::operator ()(const size_type i, const size_type j)noexcept{
         return indexing_vec_[i][j];
     }
 
     
-    template<typename T,typename Allocator>
-    void r2darray<T,Allocator>::swap(r2darray & rhs)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>
+    void r2darray<T,Allocator,host_only,GrowthPolicy>::swap(r2darray & rhs)noexcept{
         using std::swap;
         swap(this->data_vec_,rhs.data_vec_);
         swap(this->indexing_vec_,rhs.indexing_vec_);
@@ -1486,24 +1508,24 @@ namespace hopeless{
         swap(this->cap_alloc_,rhs.cap_alloc_);
     }
 
-    template<typename T,typename Allocator>    
-    constexpr r2darray<T,Allocator>::r2darray()noexcept(noexcept(Allocator()))        
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    constexpr r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray()noexcept(noexcept(Allocator()))        
         :data_vec_(Allocator()),
         indexing_vec_(nullptr),
         size_(0),
         cap_alloc_(0,Allocator())
     {}
     
-    template<typename T,typename Allocator>    
-    constexpr r2darray<T,Allocator>::r2darray(const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    constexpr r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(const Allocator& alloc)noexcept
         :data_vec_(alloc),
         indexing_vec_(nullptr),
         size_(0),
         cap_alloc_(0,alloc)
     {}
     
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(const r2darray& other)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(const r2darray& other)noexcept
         :data_vec_(other.data_vec_,std::allocator_traits<allocator_type>::select_on_container_copy_construction(
         other.get_allocator())),
         indexing_vec_(nullptr),
@@ -1515,8 +1537,8 @@ namespace hopeless{
         construct_span_indexing(other.indexing_vec_);
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(const r2darray& other, const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(const r2darray& other, const Allocator& alloc)noexcept
         :data_vec_(other.data_vec_,alloc),
         indexing_vec_(other.indexing_vec_),
         size_(other.size()),
@@ -1526,8 +1548,8 @@ namespace hopeless{
         construct_span_indexing(other.indexing_vec_);
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(r2darray&& other)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(r2darray&& other)noexcept
         :data_vec_(),
         indexing_vec_(nullptr),
         size_(0),
@@ -1537,9 +1559,9 @@ namespace hopeless{
         swap(*this,std::forward<r2darray&>(other));
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(r2darray&& other,const Allocator& alloc)noexcept
-        :data_vec_(std::forward<dynarray<T,Allocator>&&>(other.data_vec_),alloc),
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(r2darray&& other,const Allocator& alloc)noexcept
+        :data_vec_(std::forward<dynarray<T,Allocator,host_only,GrowthPolicy>&&>(other.data_vec_),alloc),
         indexing_vec_(other.indexing_vec_),
         size_(other.size()),
         cap_alloc_(other.size(),alloc)
@@ -1548,8 +1570,8 @@ namespace hopeless{
         construct_span_indexing(other.indexing_vec_);
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(std::initializer_list<size_type> init,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(std::initializer_list<size_type> init,const Allocator& alloc)noexcept
         :data_vec_(std::reduce(init.begin(),init.end(),0),alloc),
         indexing_vec_(nullptr),
         size_(init.size()),
@@ -1559,8 +1581,19 @@ namespace hopeless{
         construct_span_indexing(std::forward<std::initializer_list<size_type>&>(init));
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(std::initializer_list<std::initializer_list<T>> init,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(std::initializer_list<size_type> init,for_overwrite_t,const Allocator& alloc)noexcept
+        :data_vec_(std::reduce(init.begin(),init.end(),0),for_overwrite,alloc),
+        indexing_vec_(nullptr),
+        size_(init.size()),
+        cap_alloc_(init.size(),alloc)
+    {
+        create_indexing_buffer();
+        construct_span_indexing(std::forward<std::initializer_list<size_type>&>(init));
+    }
+
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(std::initializer_list<std::initializer_list<T>> init,const Allocator& alloc)noexcept
         :data_vec_(alloc),
         indexing_vec_(nullptr),
         size_(init.size()),
@@ -1576,8 +1609,8 @@ namespace hopeless{
         construct_span_indexing(std::forward<std::initializer_list<std::initializer_list<T>>&>(init));
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::r2darray(const_iterator first,const_iterator last,const Allocator& alloc)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::r2darray(const_iterator first,const_iterator last,const Allocator& alloc)noexcept
         :data_vec_(alloc),
         indexing_vec_(nullptr),
         size_(last - first),
@@ -1593,8 +1626,8 @@ namespace hopeless{
         construct_span_indexing(first);
     }
 
-    template<typename T,typename Allocator>    
-    r2darray<T,Allocator>::~r2darray()noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    r2darray<T,Allocator,host_only,GrowthPolicy>::~r2darray()noexcept
     {
         try{
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -1605,8 +1638,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator> 
-    r2darray<T,Allocator>& r2darray<T,Allocator>::operator=(const r2darray & other)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    r2darray<T,Allocator,host_only,GrowthPolicy>& r2darray<T,Allocator,host_only,GrowthPolicy>::operator=(const r2darray & other)noexcept
     {
         data_vec_ = other.data_vec_;
         size_ = other.size();
@@ -1627,16 +1660,16 @@ namespace hopeless{
         return *this;
     }
 
-    template<typename T,typename Allocator> 
-    r2darray<T,Allocator>& r2darray<T,Allocator>::operator=(r2darray && other)noexcept
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    r2darray<T,Allocator,host_only,GrowthPolicy>& r2darray<T,Allocator,host_only,GrowthPolicy>::operator=(r2darray && other)noexcept
     {
         using std::swap;
         swap(*this, std::forward<r2darray&>(other));
         return *this;
     }
 
-    template<typename T,typename Allocator>    
-    inline void r2darray<T,Allocator>::create_indexing_buffer()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    inline void r2darray<T,Allocator,host_only,GrowthPolicy>::create_indexing_buffer()noexcept{
         dspan_alloctor_type dspan_alloc(cap_alloc_.y());
         auto temp = std::allocator_traits<dspan_alloctor_type>::allocate(dspan_alloc,capacity());
         if (temp){
@@ -1650,8 +1683,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator>    
-    void r2darray<T,Allocator>::construct_span_indexing(const dyn_extent_span<T> otheridx[])noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    void r2darray<T,Allocator,host_only,GrowthPolicy>::construct_span_indexing(const dyn_extent_span<T> otheridx[])noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -1666,8 +1699,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator>    
-    void r2darray<T,Allocator>::construct_span_indexing(std::initializer_list<size_type>& init)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    void r2darray<T,Allocator,host_only,GrowthPolicy>::construct_span_indexing(std::initializer_list<size_type>& init)noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -1681,8 +1714,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator>    
-    void r2darray<T,Allocator>::construct_span_indexing(std::initializer_list<std::initializer_list<T>> & init)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    void r2darray<T,Allocator,host_only,GrowthPolicy>::construct_span_indexing(std::initializer_list<std::initializer_list<T>> & init)noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -1696,8 +1729,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator>    
-    void r2darray<T,Allocator>::construct_span_indexing(const_iterator first)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    void r2darray<T,Allocator,host_only,GrowthPolicy>::construct_span_indexing(const_iterator first)noexcept{
         if (size())
         {
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -1714,8 +1747,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator>    
-    void r2darray<T,Allocator>::reset_indexing_spans()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy>    
+    void r2darray<T,Allocator,host_only,GrowthPolicy>::reset_indexing_spans()noexcept{
         if (((bool)(size()))){
             const difference_type offset = data_vec_.data()-indexing_vec_[0].data();  
             indexing_vec_[0].change_span_ptr(data_vec_.data());
@@ -1727,84 +1760,84 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::allocator_type r2darray<T,Allocator>::get_allocator()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::allocator_type r2darray<T,Allocator,host_only,GrowthPolicy>::get_allocator()const noexcept{
         return cap_alloc_.y();
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::size_type r2darray<T,Allocator>::size()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::size_type r2darray<T,Allocator,host_only,GrowthPolicy>::size()const noexcept{
         return size_;
     }
 
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::size_type r2darray<T,Allocator>::capacity()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::size_type r2darray<T,Allocator,host_only,GrowthPolicy>::capacity()const noexcept{
         return cap_alloc_.x();
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::iterator r2darray<T,Allocator>::begin()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::iterator r2darray<T,Allocator,host_only,GrowthPolicy>::begin()noexcept{
         return iterator(indexing_vec_);
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_iterator r2darray<T,Allocator>::begin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::begin()const noexcept{
         return const_iterator(indexing_vec_);
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_iterator r2darray<T,Allocator>::cbegin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::cbegin()const noexcept{
         return const_iterator(indexing_vec_);
     }
 
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::iterator r2darray<T,Allocator>::end()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::iterator r2darray<T,Allocator,host_only,GrowthPolicy>::end()noexcept{
         return iterator(indexing_vec_+size());
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_iterator r2darray<T,Allocator>::end()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::end()const noexcept{
         return const_iterator(indexing_vec_+size());
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_iterator r2darray<T,Allocator>::cend()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::cend()const noexcept{
         return const_iterator(indexing_vec_+size());
     }
 
 
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::reverse_iterator r2darray<T,Allocator>::rbegin()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::reverse_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::rbegin()noexcept{
         return reverse_iterator(iterator(indexing_vec_));
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_reverse_iterator r2darray<T,Allocator>::rbegin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::rbegin()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_));
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_reverse_iterator r2darray<T,Allocator>::crbegin()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::crbegin()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_));
     }
 
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::reverse_iterator r2darray<T,Allocator>::rend()noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::reverse_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::rend()noexcept{
         return reverse_iterator(iterator(indexing_vec_+size()));
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_reverse_iterator r2darray<T,Allocator>::rend()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::rend()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_+size()));
     }
     
-    template<typename T,typename Allocator> 
-    constexpr inline r2darray<T,Allocator>::const_reverse_iterator r2darray<T,Allocator>::crend()const noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    constexpr inline r2darray<T,Allocator,host_only,GrowthPolicy>::const_reverse_iterator r2darray<T,Allocator,host_only,GrowthPolicy>::crend()const noexcept{
         return const_reverse_iterator(const_iterator(indexing_vec_+size()));
     }
 
-    template<typename T,typename Allocator> 
-    inline void r2darray<T,Allocator>::resize(size_type new_size)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,host_only,GrowthPolicy>::resize(size_type new_size)noexcept{
         if (new_size > capacity()){
 
             dspan_alloctor_type dspan_alloc(cap_alloc_.y());
@@ -1842,8 +1875,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator> 
-    inline void r2darray<T,Allocator>::resize_row(size_type row,size_type new_size,const T & fill)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,host_only,GrowthPolicy>::resize_row(size_type row,size_type new_size,const T & fill)noexcept{
         if (new_size == indexing_vec_[row].size()){
             return;
         }
@@ -1853,7 +1886,7 @@ namespace hopeless{
                 data_vec_.grow_reserve(data_vec_.size() + new_elements_count);     // any pointer invalidation happens here
                 reset_indexing_spans();
             }  
-            typename dynarray<T,Allocator>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size()); 
+            typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size()); 
             data_vec_.insert(pos,new_elements_count,fill);           
             indexing_vec_[row].resize(new_size);
             #pragma omp parallel for
@@ -1862,7 +1895,7 @@ namespace hopeless{
             }
         }else{
             const difference_type erase_elements_count = indexing_vec_[row].size() - new_size;
-            typename dynarray<T,Allocator>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size());
+            typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data()+indexing_vec_[row].size());
             data_vec_.erase(pos - erase_elements_count,pos);
             indexing_vec_[row].resize(new_size);
             #pragma omp parallel for
@@ -1872,8 +1905,8 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator> 
-    inline void r2darray<T,Allocator>::resize_row(iterator row,size_type new_size,const T & fill)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,host_only,GrowthPolicy>::resize_row(iterator row,size_type new_size,const T & fill)noexcept{
         if (new_size == row->size()){
             return;
         } 
@@ -1884,7 +1917,7 @@ namespace hopeless{
                 data_vec_.grow_reserve(data_vec_.size() + new_elements_count);     // any pointer invalidation happens here
                 reset_indexing_spans();
             }
-            typename dynarray<T,Allocator>::rand_access_iterator pos(row->data()+row->size()); 
+            typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(row->data()+row->size()); 
             data_vec_.insert(pos,new_elements_count,fill);           
             row->resize(new_size);
 
@@ -1895,7 +1928,7 @@ namespace hopeless{
         }else{
             const difference_type erase_elements_count = row->size() - new_size;
             const difference_type row_pos = row - begin();
-            typename dynarray<T,Allocator>::rand_access_iterator pos(row->data()+row->size());
+            typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(row->data()+row->size());
             data_vec_.erase(pos - erase_elements_count,pos);
             row->resize(new_size);
             #pragma omp parallel for
@@ -1905,9 +1938,9 @@ namespace hopeless{
         }
     }
     
-    template<typename T,typename Allocator> 
-    inline void r2darray<T,Allocator>::erase_row(size_type row)noexcept{
-        typename dynarray<T,Allocator>::rand_access_iterator pos(indexing_vec_[row].data());
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,host_only,GrowthPolicy>::erase_row(size_type row)noexcept{
+        typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data());
         data_vec_.erase(pos,pos + indexing_vec_[row].size());
         #pragma omp parallel for
         for (size_type i = row+1; i < size(); ++i){
@@ -1919,10 +1952,10 @@ namespace hopeless{
         size_-=1;
     }
 
-    template<typename T,typename Allocator> 
-    inline void r2darray<T,Allocator>::erase_row(iterator row)noexcept{
+    template<typename T,typename Allocator,typename GrowthPolicy> 
+    inline void r2darray<T,Allocator,host_only,GrowthPolicy>::erase_row(iterator row)noexcept{
         const difference_type row_pos = row - begin();
-        typename dynarray<T,Allocator>::rand_access_iterator pos(row->data());
+        typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(row->data());
         data_vec_.erase(pos,pos + row->size());
         #pragma omp parallel for
         for (size_type i = row_pos+1; i < size(); ++i){
@@ -1934,9 +1967,9 @@ namespace hopeless{
         size_-=1;
     }
 
-    template<typename T,typename Allocator> 
+    template<typename T,typename Allocator,typename GrowthPolicy> 
     template<typename Container>
-    inline auto r2darray<T,Allocator>::insert_row(size_type row, const Container & container)    
+    inline auto r2darray<T,Allocator,host_only,GrowthPolicy>::insert_row(size_type row, const Container & container)    
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1948,7 +1981,7 @@ namespace hopeless{
             data_vec_.grow_reserve(data_vec_.size() + new_elements_count);     // any pointer invalidation happens here
             reset_indexing_spans();
         }
-        typename dynarray<T,Allocator>::rand_access_iterator pos(indexing_vec_[row].data());
+        typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row].data());
         data_vec_.insert(pos, container.begin(),container.end());
         for (size_type i =  size() - 1; i > row; --i){
             indexing_vec_[i] = indexing_vec_[i-1];
@@ -1961,9 +1994,9 @@ namespace hopeless{
         }
     }
 
-    template<typename T,typename Allocator> 
+    template<typename T,typename Allocator,typename GrowthPolicy> 
     template<typename Container>
-    inline auto r2darray<T,Allocator>::insert_row(iterator row, const Container & container)    
+    inline auto r2darray<T,Allocator,host_only,GrowthPolicy>::insert_row(iterator row, const Container & container)    
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -1976,7 +2009,7 @@ namespace hopeless{
             data_vec_.grow_reserve(data_vec_.size() + new_elements_count);     // any pointer invalidation happens here
             reset_indexing_spans();
         }
-        typename dynarray<T,Allocator>::rand_access_iterator pos(indexing_vec_[row_pos].data());
+        typename dynarray<T,Allocator,host_only,GrowthPolicy>::rand_access_iterator pos(indexing_vec_[row_pos].data());
         data_vec_.insert(pos, container.begin(),container.end());
         for (size_type i =  size() - 1; i > row_pos; --i){
             indexing_vec_[i] = indexing_vec_[i-1];
@@ -1990,9 +2023,9 @@ namespace hopeless{
     }
     
 
-    template<typename T,typename Allocator> 
+    template<typename T,typename Allocator,typename GrowthPolicy> 
     template<typename Container, typename index_container>
-    inline auto r2darray<T,Allocator>::buffered_insert(const Container & insert_elements,const  index_container & row_indices,const index_container & column_indices)     
+    inline auto r2darray<T,Allocator,host_only,GrowthPolicy>::buffered_insert(const Container & insert_elements,const  index_container & row_indices,const index_container & column_indices)     
         -> type_<void,
             decltype(std::declval<Container>().begin()),
             decltype(std::declval<Container>().end()),
@@ -2033,9 +2066,9 @@ namespace hopeless{
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(insert_data_vec_idx),new_elements_count);
     }
 
-    template<typename T,typename Allocator> 
+    template<typename T,typename Allocator,typename GrowthPolicy> 
     template<typename index_container>
-    inline auto r2darray<T,Allocator>::buffered_erase(const index_container & row_indices,const index_container & column_indices)            
+    inline auto r2darray<T,Allocator,host_only,GrowthPolicy>::buffered_erase(const index_container & row_indices,const index_container & column_indices)            
         -> type_<void,
             decltype(std::declval<index_container>().begin()),
             decltype(std::declval<index_container>().end()),
@@ -2063,6 +2096,104 @@ namespace hopeless{
         data_vec_.buffered_erase(erase_data_vec_idx,erase_elements_count);
         std::allocator_traits<s_allocator_type>::deallocate(s_alloc,reinterpret_cast<typename s_allocator_type::pointer>(erase_data_vec_idx),erase_elements_count);    
     }
-#endif
+
+    namespace ragged_detail
+    {
+        // rows are stored back to back in the flat dynarray, so after the row sizes match the elements are one run
+        template<typename T, typename R2d>
+        inline const T * flat_begin(const R2d & arr)noexcept{
+            return (arr.size() > 0) ? (*arr.begin()).data():nullptr;
+        }
+
+        template<typename R2d>
+        inline std::ptrdiff_t flat_size(const R2d & arr)noexcept{
+            if (arr.size() <= 0){
+                return 0;
+            }
+            const auto & last = *(arr.begin() + (arr.size() - 1));
+            return (last.data() + last.size()) - (*arr.begin()).data();
+        }
+
+        template<typename T>
+        inline bool row_less(const dyn_extent_span<T> & lhs, const dyn_extent_span<T> & rhs)noexcept{
+            if constexpr (std::is_trivially_copyable_v<T>){
+                return kernels::lexicographical_compare(lhs.data(),lhs.size(),rhs.data(),rhs.size());
+            }else{
+                return std::lexicographical_compare(lhs.data(),lhs.data() + lhs.size(),rhs.data(),rhs.data() + rhs.size());
+            }
+        }
+    }
+
+    // same number of rows, then the same row sizes (the cheap check), then one compare over the flat elements
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator ==(const r2darray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const r2darray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        if (lhs.size() != rhs.size()){
+            return false;
+        }
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+        for (std::ptrdiff_t i = 0; i < lhs.size(); ++i){
+            if (l[i].size() != r[i].size()){
+                return false;
+            }
+        }
+        const std::ptrdiff_t count = ragged_detail::flat_size(lhs);
+        const T * a = ragged_detail::flat_begin<T>(lhs);
+        const T * b = ragged_detail::flat_begin<T>(rhs);
+        if constexpr (std::is_trivially_copyable_v<T>){
+            return kernels::equal(a,b,count);
+        }else{
+            return std::equal(a,a + count,b);
+        }
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator !=(const r2darray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const r2darray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return !(lhs == rhs);
+    }
+
+    // lexicographic over the rows, each row compared lexicographically
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator <(const r2darray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                           const r2darray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+        const std::ptrdiff_t rows = (lhs.size() < rhs.size()) ? lhs.size():rhs.size();
+        for (std::ptrdiff_t i = 0; i < rows; ++i){
+            if (ragged_detail::row_less(l[i],r[i])){
+                return true;
+            }
+            if (ragged_detail::row_less(r[i],l[i])){
+                return false;
+            }
+        }
+        return lhs.size() < rhs.size();
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator >(const r2darray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                           const r2darray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return rhs < lhs;
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator <=(const r2darray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const r2darray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return !(rhs < lhs);
+    }
+
+    template<typename T, typename Allocator1, typename OffloadPolicy1, typename GrowthPolicy1,
+             typename Allocator2, typename OffloadPolicy2, typename GrowthPolicy2>
+    inline bool operator >=(const r2darray<T,Allocator1,OffloadPolicy1,GrowthPolicy1> & lhs,
+                            const r2darray<T,Allocator2,OffloadPolicy2,GrowthPolicy2> & rhs)noexcept{
+        return !(lhs < rhs);
+    }
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,903 @@
+// circular buffer with a power of two capacity, push and pop at both ends are O(1) (an index mask, nothing moves)
+// so popping from the front of a stream doesn't shift the rest like dynarray::erase(begin()) does
+// the live elements are [head,head+size) modulo the capacity, any logical range is at most two contiguous runs
+// so range copies and device transfers are at most two memcpys, the device copy has the same layout as the host
+// buffer so operator () indexes it with the same head and mask
+// spsc_ring is a fixed capacity single producer single consumer queue for handing data from one thread to another
+// (e.g. a reader thread feeding the thread that drives the offload device), lock free with acquire/release indices
+// NOTE! iterators aren't meant for the device
+#pragma once
+
+#ifndef HOPELESS_RING_DYNARRAY
+#define HOPELESS_RING_DYNARRAY
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<cstring>
+#include<type_traits>
+#include<memory>
+#include<initializer_list>
+#include<utility>
+#include<iterator>
+#include<functional>
+#include<atomic>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "offload_policy.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename T, typename Allocator = hopeless::allocator<T>,
+                        typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY>
+    struct ring_dynarray
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+    public:
+        template<bool is_const> struct ring_iterator;
+
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::ptrdiff_t size_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef ring_iterator<false> iterator;
+        typedef ring_iterator<true> const_iterator;
+        typedef typename std::reverse_iterator<iterator> reverse_iterator;
+        typedef typename std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        enum : std::ptrdiff_t {min_capacity = 16};
+
+        // the container and a logical index, the wrap around is done by the indexing
+        template<bool is_const>
+        struct ring_iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::conditional_t<is_const,const T&,T&> reference;
+            typedef std::conditional_t<is_const,const T*,T*> pointer;
+            typedef std::ptrdiff_t difference_type;
+            typedef std::conditional_t<is_const,const ring_dynarray,ring_dynarray> container_type;
+        protected:
+            container_type * buf;
+            difference_type pos;
+        public:
+            constexpr ring_iterator()noexcept:buf(nullptr),pos(0){}
+            constexpr ring_iterator(container_type * container, difference_type i)noexcept:buf(container),pos(i){}
+            template<bool other_const, typename = std::enable_if_t<is_const && !other_const>>
+            constexpr ring_iterator(const ring_iterator<other_const> & it)noexcept:buf(it.container()),pos(it.index()){}
+
+            inline ring_iterator & operator ++()noexcept{++pos;return *this;}
+            inline ring_iterator  operator ++(int)noexcept{auto temp = *this; ++pos; return temp;}
+            inline ring_iterator & operator --()noexcept{--pos;return *this;}
+            inline ring_iterator  operator --(int)noexcept{auto temp = *this; --pos; return temp;}
+            inline ring_iterator & operator +=(const difference_type n)noexcept{pos+=n;return *this;}
+            inline ring_iterator & operator -=(const difference_type n)noexcept{pos-=n;return *this;}
+            inline ring_iterator  operator +(const difference_type n)const noexcept{return ring_iterator(buf,pos + n);}
+            inline ring_iterator  operator -(const difference_type n)const noexcept{return ring_iterator(buf,pos - n);}
+            inline friend ring_iterator operator +(const difference_type n, const ring_iterator it)noexcept{return ring_iterator(it.buf,it.pos + n);}
+
+            inline reference operator *()const noexcept{return (*buf)[pos];}
+            inline pointer operator ->()const noexcept{return &(*buf)[pos];}
+            inline reference operator [](const difference_type n)const noexcept{return (*buf)[pos + n];}
+
+            constexpr inline container_type * container()const noexcept{return buf;}
+            constexpr inline difference_type index()const noexcept{return pos;}
+
+            inline friend bool operator > (const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos>rhs.pos);}
+            inline friend bool operator < (const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos<rhs.pos);}
+            inline friend bool operator != (const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos!=rhs.pos);}
+            inline friend bool operator == (const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos==rhs.pos);}
+            inline friend bool operator >= (const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos>=rhs.pos);}
+            inline friend bool operator <= (const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos<=rhs.pos);}
+            inline friend difference_type operator -(const ring_iterator lhs, const ring_iterator rhs)noexcept{return (lhs.pos - rhs.pos);}
+        };
+
+        constexpr inline reference operator [](const size_type i)noexcept;
+        constexpr inline const_reference operator [](const size_type i)const noexcept;
+        // device copy, valid after map_data_to_omp_dev() and until the next change on the host
+        #pragma omp declare target
+        constexpr inline reference operator ()(const size_type i)const noexcept;
+        #pragma omp end declare target
+
+        ring_dynarray()noexcept;
+        ring_dynarray(std::initializer_list<T> init)noexcept;
+        ring_dynarray(const ring_dynarray & other)noexcept;
+        ring_dynarray(ring_dynarray && other)noexcept;
+        ~ring_dynarray()noexcept;
+
+        ring_dynarray& operator =(const ring_dynarray & other)noexcept;
+        ring_dynarray& operator =(ring_dynarray && other)noexcept;
+        void swap(ring_dynarray & rhs)noexcept;
+
+        inline reference at(size_type pos);
+        inline const_reference at(size_type pos)const;
+        constexpr inline reference front()noexcept;
+        constexpr inline const_reference front()const noexcept;
+        constexpr inline reference back()noexcept;
+        constexpr inline const_reference back()const noexcept;
+
+        inline iterator begin()noexcept;
+        inline const_iterator begin()const noexcept;
+        inline const_iterator cbegin()const noexcept;
+        inline iterator end()noexcept;
+        inline const_iterator end()const noexcept;
+        inline const_iterator cend()const noexcept;
+        inline reverse_iterator rbegin()noexcept;
+        inline const_reverse_iterator rbegin()const noexcept;
+        inline reverse_iterator rend()noexcept;
+        inline const_reverse_iterator rend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline bool full()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;    // 0 or a power of two
+        inline void reserve(size_type new_cap)noexcept;         // rounds up to a power of two
+        inline void shrink_to_fit()noexcept;                    // smallest power of two that holds size()
+        inline void clear()noexcept;
+
+        // grow (doubling) when full
+        inline void push_back(const T& value)noexcept;
+        inline void push_front(const T& value)noexcept;
+        // bounded queue use, false instead of growing when full
+        inline bool try_push_back(const T& value)noexcept;
+        inline bool try_push_front(const T& value)noexcept;
+        inline void pop_back()noexcept;
+        inline void pop_front()noexcept;
+        inline void pop_front(size_type count)noexcept;
+        inline void pop_back(size_type count)noexcept;
+
+        // append count elements from contiguous memory, grows once, at most two memcpys, src may point into this ring
+        inline void append(const T * src, size_type count)noexcept;
+        template<typename InputIt>
+        inline auto append_range(InputIt first, InputIt last)noexcept
+            -> type_<void,
+                decltype(*std::declval<InputIt>()),
+                decltype(++std::declval<InputIt&>()),
+                decltype(first != last)>;
+        // copy up to max_count elements from the front to dst (at most two memcpys) and pop them, returns the count
+        inline size_type pop_front_into(T * dst, size_type max_count)noexcept;
+        // copy the logical range [begin,end) to dst without popping
+        inline void copy_to(T * dst, size_type begin, size_type end)const noexcept;
+
+        // the live elements (or the logical range [begin,end)) as at most two omp_target_memcpys each way
+        inline void map_data_to_omp_dev()noexcept;
+        inline void map_data_to_omp_dev(const size_type begin, const size_type end)noexcept;
+        inline void map_data_from_omp_dev()noexcept;
+        inline void map_data_from_omp_dev(const size_type begin, const size_type end)noexcept;
+
+    private:
+        constexpr inline size_type physical(const size_type i)const noexcept;
+        // calls f(physical begin, count, logical offset from begin) for the one or two runs of [begin,end)
+        template<typename F>
+        inline void for_each_run(size_type begin, size_type end, F f)const noexcept;
+        inline bool realloc_buffer(size_type new_cap)noexcept;      // new_cap is a power of two >= size()
+        inline bool grow(size_type count)noexcept;                  // room for count more
+        inline void dev_buffer_resize()noexcept;
+        inline void free_dev_buffer()noexcept;
+        inline void transfer(size_type begin, size_type end, bool to_dev)noexcept;
+
+    // member variables
+        T * data_buffer_;
+        T * device_data_buffer_;
+        size_type head_;
+        size_type size_;
+        size_type capacity_;
+        size_type mask_;
+        size_type device_capacity_;
+        allocator_type alloc_;
+    };
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::size_type
+    ring_dynarray<T,Allocator,OffloadPolicy>::physical(const size_type i)const noexcept{
+        return (head_ + i) & mask_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::operator [](const size_type i)noexcept{
+        return data_buffer_[physical(i)];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::operator [](const size_type i)const noexcept{
+        return data_buffer_[physical(i)];
+    }
+
+    #pragma omp declare target
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::operator ()(const size_type i)const noexcept{
+        return device_data_buffer_[(head_ + i) & mask_];
+    }
+    #pragma omp end declare target
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>::ring_dynarray()noexcept
+        :data_buffer_(nullptr),
+        device_data_buffer_(nullptr),
+        head_(0),
+        size_(0),
+        capacity_(0),
+        mask_(0),
+        device_capacity_(0),
+        alloc_(){}
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>::ring_dynarray(std::initializer_list<T> init)noexcept
+        :ring_dynarray()
+    {
+        append(init.begin(),static_cast<size_type>(init.size()));
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>::ring_dynarray(const ring_dynarray & other)noexcept
+        :ring_dynarray()
+    {
+        *this = other;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>::ring_dynarray(ring_dynarray && other)noexcept
+        :ring_dynarray()
+    {
+        swap(other);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>::~ring_dynarray()noexcept{
+        free_dev_buffer();
+        std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>&
+    ring_dynarray<T,Allocator,OffloadPolicy>::operator =(const ring_dynarray & other)noexcept{
+        if (this == &other){
+            return *this;
+        }
+        clear();
+        if (!grow(other.size())){
+            return *this;
+        }
+        other.copy_to(data_buffer_,0,other.size());
+        size_ = other.size();
+        return *this;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    ring_dynarray<T,Allocator,OffloadPolicy>&
+    ring_dynarray<T,Allocator,OffloadPolicy>::operator =(ring_dynarray && other)noexcept{
+        if (this != &other){
+            ring_dynarray temp;
+            swap(other);
+            other.swap(temp);
+        }
+        return *this;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    void ring_dynarray<T,Allocator,OffloadPolicy>::swap(ring_dynarray & rhs)noexcept{
+        using std::swap;
+        swap(data_buffer_,rhs.data_buffer_);
+        swap(device_data_buffer_,rhs.device_data_buffer_);
+        swap(head_,rhs.head_);
+        swap(size_,rhs.size_);
+        swap(capacity_,rhs.capacity_);
+        swap(mask_,rhs.mask_);
+        swap(device_capacity_,rhs.device_capacity_);
+        swap(alloc_,rhs.alloc_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::at(size_type pos){
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error ring_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::at(size_type pos)const{
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error ring_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::front()noexcept{
+        return (*this)[0];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::front()const noexcept{
+        return (*this)[0];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::back()noexcept{
+        return (*this)[size_-1];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_reference
+    ring_dynarray<T,Allocator,OffloadPolicy>::back()const noexcept{
+        return (*this)[size_-1];
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::begin()noexcept{
+        return iterator(this,0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::begin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::cbegin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::end()noexcept{
+        return iterator(this,size_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::end()const noexcept{
+        return const_iterator(this,size_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::cend()const noexcept{
+        return const_iterator(this,size_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reverse_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::rbegin()noexcept{
+        return reverse_iterator(end());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_reverse_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::rbegin()const noexcept{
+        return const_reverse_iterator(end());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::reverse_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::rend()noexcept{
+        return reverse_iterator(begin());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::const_reverse_iterator
+    ring_dynarray<T,Allocator,OffloadPolicy>::rend()const noexcept{
+        return const_reverse_iterator(begin());
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline bool ring_dynarray<T,Allocator,OffloadPolicy>::empty()const noexcept{
+        return (size_ == 0);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline bool ring_dynarray<T,Allocator,OffloadPolicy>::full()const noexcept{
+        return (size_ == capacity_);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::size_type
+    ring_dynarray<T,Allocator,OffloadPolicy>::size()const noexcept{
+        return size_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename ring_dynarray<T,Allocator,OffloadPolicy>::size_type
+    ring_dynarray<T,Allocator,OffloadPolicy>::capacity()const noexcept{
+        return capacity_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    template<typename F>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::for_each_run(size_type begin, size_type end, F f)const noexcept{
+        const size_type count = end - begin;
+        if (count <= 0){
+            return;
+        }
+        const size_type first = physical(begin);
+        const size_type first_count = (count < capacity_ - first) ? count:capacity_ - first;
+        f(first,first_count,0);
+        if (first_count < count){
+            f(0,count - first_count,first_count);
+        }
+    }
+
+    // the live elements are unwrapped to the start of the new buffer
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline bool ring_dynarray<T,Allocator,OffloadPolicy>::realloc_buffer(size_type new_cap)noexcept{
+        T * temp = nullptr;
+        if (new_cap > 0){
+            temp = std::allocator_traits<allocator_type>::allocate(alloc_,new_cap);
+            if (!temp){
+                std::cerr<<"ERROR ring_dynarray failed to allocate memory"<<std::endl;
+                return false;
+            }
+            copy_to(temp,0,size_);
+        }
+        std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+        data_buffer_ = temp;
+        head_ = 0;
+        capacity_ = new_cap;
+        mask_ = (new_cap > 0) ? new_cap - 1:0;
+        return true;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline bool ring_dynarray<T,Allocator,OffloadPolicy>::grow(size_type count)noexcept{
+        if (capacity_ - size_ >= count){
+            return true;
+        }
+        size_type new_cap = (capacity_ > 0) ? capacity_:min_capacity;
+        while (new_cap < size_ + count){
+            new_cap *= 2;
+        }
+        return realloc_buffer(new_cap);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::reserve(size_type new_cap)noexcept{
+        if (new_cap > capacity_){
+            grow(new_cap - size_);
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::shrink_to_fit()noexcept{
+        size_type new_cap = 0;
+        if (size_ > 0){
+            new_cap = 1;
+            while (new_cap < size_){
+                new_cap *= 2;
+            }
+        }
+        if (new_cap < capacity_){
+            realloc_buffer(new_cap);
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::clear()noexcept{
+        head_ = 0;
+        size_ = 0;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::push_back(const T& value)noexcept{
+        if (size_ == capacity_){
+            const T temp(value);    // value may live in the buffer
+            if (grow(1)){
+                data_buffer_[physical(size_)] = temp;
+                ++size_;
+            }
+            return;
+        }
+        data_buffer_[physical(size_)] = value;
+        ++size_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::push_front(const T& value)noexcept{
+        if (size_ == capacity_){
+            const T temp(value);    // value may live in the buffer
+            if (grow(1)){
+                head_ = (head_ - 1) & mask_;
+                data_buffer_[head_] = temp;
+                ++size_;
+            }
+            return;
+        }
+        head_ = (head_ - 1) & mask_;
+        data_buffer_[head_] = value;
+        ++size_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline bool ring_dynarray<T,Allocator,OffloadPolicy>::try_push_back(const T& value)noexcept{
+        if (size_ == capacity_){
+            return false;
+        }
+        data_buffer_[physical(size_)] = value;
+        ++size_;
+        return true;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline bool ring_dynarray<T,Allocator,OffloadPolicy>::try_push_front(const T& value)noexcept{
+        if (size_ == capacity_){
+            return false;
+        }
+        head_ = (head_ - 1) & mask_;
+        data_buffer_[head_] = value;
+        ++size_;
+        return true;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::pop_back()noexcept{
+        --size_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::pop_front()noexcept{
+        head_ = (head_ + 1) & mask_;
+        --size_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::pop_front(size_type count)noexcept{
+        count = (count < size_) ? count:size_;
+        head_ = (head_ + count) & mask_;
+        size_ -= count;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::pop_back(size_type count)noexcept{
+        size_ -= (count < size_) ? count:size_;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::append(const T * src, size_type count)noexcept{
+        if (count <= 0){
+            return;
+        }
+        if ((capacity_ - size_ < count) && std::less_equal<const T*>()(data_buffer_,src) &&
+            std::less<const T*>()(src,data_buffer_ + capacity_)){
+            // src is in this ring and the grow would free it, the run may also stop being contiguous once unwrapped
+            T * temp = std::allocator_traits<allocator_type>::allocate(alloc_,count);
+            if (!temp){
+                std::cerr<<"ERROR ring_dynarray failed to allocate memory"<<std::endl;
+                return;
+            }
+            std::memcpy(static_cast<void*>(temp),static_cast<const void*>(src),sizeof(T)*count);
+            append(temp,count);
+            std::allocator_traits<allocator_type>::deallocate(alloc_,temp,count);
+            return;
+        }
+        if (!grow(count)){
+            return;
+        }
+        const size_type old_size = size_;
+        size_ += count;
+        T * data = data_buffer_;
+        for_each_run(old_size,size_,[data,src](size_type first, size_type n, size_type offset){
+            std::memcpy(static_cast<void*>(data + first),static_cast<const void*>(src + offset),sizeof(T)*n);
+        });
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    template<typename InputIt>
+    inline auto ring_dynarray<T,Allocator,OffloadPolicy>::append_range(InputIt first, InputIt last)noexcept
+        -> type_<void,
+            decltype(*std::declval<InputIt>()),
+            decltype(++std::declval<InputIt&>()),
+            decltype(first != last)>
+    {
+        if constexpr (std::is_pointer_v<InputIt>){
+            append(first,last - first);
+        }else{
+            if constexpr (is_random_access_iterator_v<InputIt>){
+                if (!grow(last - first)){
+                    return;
+                }
+            }
+            for (; first != last; ++first){
+                push_back(*first);
+            }
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::copy_to(T * dst, size_type begin, size_type end)const noexcept{
+        const T * data = data_buffer_;
+        for_each_run(begin,end,[data,dst](size_type first, size_type n, size_type offset){
+            std::memcpy(static_cast<void*>(dst + offset),static_cast<const void*>(data + first),sizeof(T)*n);
+        });
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline typename ring_dynarray<T,Allocator,OffloadPolicy>::size_type
+    ring_dynarray<T,Allocator,OffloadPolicy>::pop_front_into(T * dst, size_type max_count)noexcept{
+        const size_type count = (max_count < size_) ? max_count:size_;
+        copy_to(dst,0,count);
+        pop_front(count);
+        return count;
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::free_dev_buffer()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (device_data_buffer_){
+                omp_target_free(device_data_buffer_,OffloadPolicy::device);
+            }
+        }
+        device_data_buffer_ = nullptr;
+        device_capacity_ = 0;
+    }
+
+    // the device buffer has exactly the host capacity so physical indices match on both sides
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::dev_buffer_resize()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (device_capacity_ == capacity_ && device_data_buffer_){
+                return;
+            }
+            free_dev_buffer();
+            if (capacity_ == 0){
+                return;
+            }
+            T * temp = (T *) omp_target_alloc(capacity_ * sizeof(T), OffloadPolicy::device);
+            if (!temp){
+                std::cerr<<"ERROR ring_dynarray failed to allocate memory on offload device"<<std::endl;
+                return;
+            }
+            device_data_buffer_ = temp;
+            device_capacity_ = capacity_;
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::transfer(size_type begin, size_type end, bool to_dev)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (begin < 0 || end > size_ || begin >= end){
+                return;
+            }
+            if (to_dev){
+                dev_buffer_resize();
+            }
+            if (!device_data_buffer_ || device_capacity_ != capacity_){
+                return;
+            }
+            T * host = data_buffer_;
+            T * dev = device_data_buffer_;
+            for_each_run(begin,end,[host,dev,to_dev](size_type first, size_type n, size_type){
+                try{
+                    bool fail = to_dev ? omp_target_memcpy(dev,host,n * sizeof(T),first * sizeof(T),first * sizeof(T),
+                                                           OffloadPolicy::device,omp_get_initial_device())
+                                       : omp_target_memcpy(host,dev,n * sizeof(T),first * sizeof(T),first * sizeof(T),
+                                                           omp_get_initial_device(),OffloadPolicy::device);
+                    if(fail){
+                        throw std::runtime_error(to_dev ? "ERROR ring_dynarray failed to copy data to the device"
+                                                        : "ERROR ring_dynarray failed to copy data from the device");
+                    }
+                }catch(std::runtime_error& e){
+                    std::cerr<<e.what()<<std::endl;
+                }catch(...){
+                    std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+                }
+            });
+        }
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::map_data_to_omp_dev()noexcept{
+        transfer(0,size_,true);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::map_data_to_omp_dev(const size_type begin, const size_type end)noexcept{
+        transfer(begin,end,true);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::map_data_from_omp_dev()noexcept{
+        transfer(0,size_,false);
+    }
+
+    template<typename T, typename Allocator, typename OffloadPolicy>
+    inline void ring_dynarray<T,Allocator,OffloadPolicy>::map_data_from_omp_dev(const size_type begin, const size_type end)noexcept{
+        transfer(begin,end,false);
+    }
+
+    template<typename T, typename Allocator = hopeless::allocator<T>>
+    struct spsc_ring
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::ptrdiff_t size_type;
+
+        enum : std::ptrdiff_t {cache_line = 64};
+
+        // capacity is rounded up to a power of two, the queue never grows
+        explicit spsc_ring(size_type min_capacity)noexcept;
+        spsc_ring(const spsc_ring &) = delete;
+        spsc_ring& operator =(const spsc_ring &) = delete;
+        ~spsc_ring()noexcept;
+
+        // producer side
+        inline bool try_push(const T& value)noexcept;
+        inline size_type try_push(const T * src, size_type count)noexcept;     // pushes as many as fit, returns how many
+        // consumer side
+        inline bool try_pop(T& value)noexcept;
+        inline size_type try_pop(T * dst, size_type max_count)noexcept;       // pops up to max_count, returns how many
+    #ifdef HOPELESS_TARGET_OMP_DEV
+        // pops up to max_count straight into device memory (at most two omp_target_memcpys), returns how many
+        inline size_type try_pop_to_omp_dev(T * device_dst, size_type max_count, int dev_no)noexcept;
+    #endif
+
+        // exact only when called from the producer or consumer while the other side is idle
+        inline size_type size()const noexcept;
+        inline bool empty()const noexcept;
+        constexpr inline size_type capacity()const noexcept;
+
+    private:
+        template<typename F>
+        inline size_type pop_runs(size_type max_count, F copy)noexcept;
+
+    // member variables
+        T * data_buffer_;
+        size_type capacity_;
+        size_type mask_;
+        allocator_type alloc_;
+        // head is written by the consumer, tail by the producer, each keeps a stale copy of the other index
+        // so it only touches the other side's cache line when the queue looks full or empty
+        alignas(cache_line) std::atomic<size_type> head_;
+        size_type cached_tail_;
+        alignas(cache_line) std::atomic<size_type> tail_;
+        size_type cached_head_;
+    };
+
+    template<typename T, typename Allocator>
+    spsc_ring<T,Allocator>::spsc_ring(size_type min_capacity)noexcept
+        :data_buffer_(nullptr),
+        capacity_(1),
+        mask_(0),
+        alloc_(),
+        head_(0),
+        cached_tail_(0),
+        tail_(0),
+        cached_head_(0)
+    {
+        while (capacity_ < min_capacity){
+            capacity_ *= 2;
+        }
+        mask_ = capacity_ - 1;
+        data_buffer_ = std::allocator_traits<allocator_type>::allocate(alloc_,capacity_);
+        if (!data_buffer_){
+            std::cerr<<"ERROR spsc_ring failed to allocate memory"<<std::endl;
+            capacity_ = 0;
+            mask_ = 0;
+        }
+    }
+
+    template<typename T, typename Allocator>
+    spsc_ring<T,Allocator>::~spsc_ring()noexcept{
+        std::allocator_traits<allocator_type>::deallocate(alloc_,data_buffer_,capacity_);
+    }
+
+    template<typename T, typename Allocator>
+    inline bool spsc_ring<T,Allocator>::try_push(const T& value)noexcept{
+        return (try_push(&value,1) == 1);
+    }
+
+    template<typename T, typename Allocator>
+    inline typename spsc_ring<T,Allocator>::size_type
+    spsc_ring<T,Allocator>::try_push(const T * src, size_type count)noexcept{
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (capacity_ - (tail - cached_head_) < count){
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        const size_type free_slots = capacity_ - (tail - cached_head_);
+        count = (count < free_slots) ? count:free_slots;
+        if (count <= 0){
+            return 0;
+        }
+        const size_type first = tail & mask_;
+        const size_type first_count = (count < capacity_ - first) ? count:capacity_ - first;
+        std::memcpy(static_cast<void*>(data_buffer_ + first),static_cast<const void*>(src),sizeof(T)*first_count);
+        std::memcpy(static_cast<void*>(data_buffer_),static_cast<const void*>(src + first_count),sizeof(T)*(count - first_count));
+        tail_.store(tail + count,std::memory_order_release);
+        return count;
+    }
+
+    template<typename T, typename Allocator>
+    template<typename F>
+    inline typename spsc_ring<T,Allocator>::size_type
+    spsc_ring<T,Allocator>::pop_runs(size_type max_count, F copy)noexcept{
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head < max_count){
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        const size_type available = cached_tail_ - head;
+        const size_type count = (max_count < available) ? max_count:available;
+        if (count <= 0){
+            return 0;
+        }
+        const size_type first = head & mask_;
+        const size_type first_count = (count < capacity_ - first) ? count:capacity_ - first;
+        copy(first,first_count,0);
+        if (first_count < count){
+            copy(0,count - first_count,first_count);
+        }
+        head_.store(head + count,std::memory_order_release);
+        return count;
+    }
+
+    template<typename T, typename Allocator>
+    inline bool spsc_ring<T,Allocator>::try_pop(T& value)noexcept{
+        return (try_pop(&value,1) == 1);
+    }
+
+    template<typename T, typename Allocator>
+    inline typename spsc_ring<T,Allocator>::size_type
+    spsc_ring<T,Allocator>::try_pop(T * dst, size_type max_count)noexcept{
+        const T * data = data_buffer_;
+        return pop_runs(max_count,[data,dst](size_type first, size_type n, size_type offset){
+            std::memcpy(static_cast<void*>(dst + offset),static_cast<const void*>(data + first),sizeof(T)*n);
+        });
+    }
+
+#ifdef HOPELESS_TARGET_OMP_DEV
+    template<typename T, typename Allocator>
+    inline typename spsc_ring<T,Allocator>::size_type
+    spsc_ring<T,Allocator>::try_pop_to_omp_dev(T * device_dst, size_type max_count, int dev_no)noexcept{
+        T * data = data_buffer_;
+        return pop_runs(max_count,[data,device_dst,dev_no](size_type first, size_type n, size_type offset){
+            try{
+                bool fail = omp_target_memcpy(device_dst,data,n * sizeof(T),offset * sizeof(T),first * sizeof(T),
+                                              dev_no,omp_get_initial_device());
+                if(fail){
+                    throw std::runtime_error("ERROR spsc_ring failed to copy data to the device");
+                }
+            }catch(std::runtime_error& e){
+                std::cerr<<e.what()<<std::endl;
+            }catch(...){
+                std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+            }
+        });
+    }
+#endif
+
+    template<typename T, typename Allocator>
+    inline typename spsc_ring<T,Allocator>::size_type
+    spsc_ring<T,Allocator>::size()const noexcept{
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    template<typename T, typename Allocator>
+    inline bool spsc_ring<T,Allocator>::empty()const noexcept{
+        return (size() == 0);
+    }
+
+    template<typename T, typename Allocator>
+    constexpr inline typename spsc_ring<T,Allocator>::size_type
+    spsc_ring<T,Allocator>::capacity()const noexcept{
+        return capacity_;
+    }
+}
+#endif
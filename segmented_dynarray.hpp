@@ -0,0 +1,748 @@
+// resizable array made of fixed size chunks of 2^chunk_shift elements found through a small directory of chunk pointers
+// growing only allocates a new chunk, elements are never copied so their addresses stay valid until they are erased
+// element i is chunk i >> chunk_shift at offset i & (chunk_size-1), on the host through [] and on the device through ()
+// with a mirrored OffloadPolicy every chunk has its own device buffer and a dirty flag, map_data_to_omp_dev() only copies
+// the chunks that changed since they were last transferred, writing through the non const accessors marks a chunk dirty
+// NOTE! iterators aren't meant for the device, the container has to be (implicitly) mapped for () to work in a target region
+#pragma once
+
+#ifndef HOPELESS_SEGMENTED_DYNARRAY
+#define HOPELESS_SEGMENTED_DYNARRAY
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<cstring>
+#include<type_traits>
+#include<memory>
+#include<utility>
+#include<iterator>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "offload_policy.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename T, int chunk_shift = 12, typename Allocator = hopeless::allocator<T>,
+                        typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY>
+    struct segmented_dynarray
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+        static_assert((chunk_shift >= 0) && (chunk_shift < 31), "chunk_shift out of range");
+    public:
+        template<bool is_const> struct seg_iterator;
+
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::ptrdiff_t size_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef seg_iterator<false> iterator;
+        typedef seg_iterator<true> const_iterator;
+        typedef typename std::reverse_iterator<iterator> reverse_iterator;
+        typedef typename std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<T*> p_allocator_type;
+        typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<unsigned char> c_allocator_type;
+
+        // enumerators rather than static members so the type stays mappable
+        enum : std::ptrdiff_t {chunk_size = std::ptrdiff_t(1) << chunk_shift, chunk_mask = chunk_size - 1};
+
+        // the container and an index, chunk boundaries are handled by the indexing
+        template<bool is_const>
+        struct seg_iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::conditional_t<is_const,const T&,T&> reference;
+            typedef std::conditional_t<is_const,const T*,T*> pointer;
+            typedef std::ptrdiff_t difference_type;
+            typedef std::conditional_t<is_const,const segmented_dynarray,segmented_dynarray> container_type;
+        protected:
+            container_type * arr;
+            difference_type pos;
+        public:
+            constexpr seg_iterator()noexcept:arr(nullptr),pos(0){}
+            constexpr seg_iterator(container_type * container, difference_type i)noexcept:arr(container),pos(i){}
+            template<bool other_const, typename = std::enable_if_t<is_const && !other_const>>
+            constexpr seg_iterator(const seg_iterator<other_const> & it)noexcept:arr(it.container()),pos(it.index()){}
+
+            inline seg_iterator & operator ++()noexcept{++pos;return *this;}
+            inline seg_iterator  operator ++(int)noexcept{auto temp = *this; ++pos; return temp;}
+            inline seg_iterator & operator --()noexcept{--pos;return *this;}
+            inline seg_iterator  operator --(int)noexcept{auto temp = *this; --pos; return temp;}
+            inline seg_iterator & operator +=(const difference_type n)noexcept{pos+=n;return *this;}
+            inline seg_iterator & operator -=(const difference_type n)noexcept{pos-=n;return *this;}
+            inline seg_iterator  operator +(const difference_type n)const noexcept{return seg_iterator(arr,pos + n);}
+            inline seg_iterator  operator -(const difference_type n)const noexcept{return seg_iterator(arr,pos - n);}
+            inline friend seg_iterator operator +(const difference_type n, const seg_iterator it)noexcept{return seg_iterator(it.arr,it.pos + n);}
+
+            inline reference operator *()const noexcept{return (*arr)[pos];}
+            inline pointer operator ->()const noexcept{return &(*arr)[pos];}
+            inline reference operator [](const difference_type n)const noexcept{return (*arr)[pos + n];}
+
+            constexpr inline container_type * container()const noexcept{return arr;}
+            constexpr inline difference_type index()const noexcept{return pos;}
+
+            inline friend bool operator > (const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos>rhs.pos);}
+            inline friend bool operator < (const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos<rhs.pos);}
+            inline friend bool operator != (const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos!=rhs.pos);}
+            inline friend bool operator == (const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos==rhs.pos);}
+            inline friend bool operator >= (const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos>=rhs.pos);}
+            inline friend bool operator <= (const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos<=rhs.pos);}
+            inline friend difference_type operator -(const seg_iterator lhs, const seg_iterator rhs)noexcept{return (lhs.pos - rhs.pos);}
+        };
+
+        // the non const accessors mark the chunk they touch as dirty
+        inline reference operator [](const size_type i)noexcept;
+        constexpr inline const_reference operator [](const size_type i)const noexcept;
+        #pragma omp declare target
+        constexpr inline reference operator ()(const size_type i)const noexcept;
+        #pragma omp end declare target
+
+        segmented_dynarray()noexcept;
+        explicit segmented_dynarray(size_type count)noexcept;
+        segmented_dynarray(size_type count, const T& value)noexcept;
+        segmented_dynarray(const segmented_dynarray & other)noexcept;
+        segmented_dynarray(segmented_dynarray && other)noexcept;
+        ~segmented_dynarray()noexcept;
+
+        segmented_dynarray& operator =(const segmented_dynarray & other)noexcept;
+        segmented_dynarray& operator =(segmented_dynarray && other)noexcept;
+        void swap(segmented_dynarray & rhs)noexcept;
+
+        inline reference at(size_type pos);
+        inline const_reference at(size_type pos)const;
+        inline reference front()noexcept;
+        constexpr inline const_reference front()const noexcept;
+        inline reference back()noexcept;
+        constexpr inline const_reference back()const noexcept;
+
+        inline iterator begin()noexcept;
+        inline const_iterator begin()const noexcept;
+        inline const_iterator cbegin()const noexcept;
+        inline iterator end()noexcept;
+        inline const_iterator end()const noexcept;
+        inline const_iterator cend()const noexcept;
+        inline reverse_iterator rbegin()noexcept;
+        inline const_reverse_iterator rbegin()const noexcept;
+        inline reverse_iterator rend()noexcept;
+        inline const_reverse_iterator rend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;
+        constexpr inline size_type num_chunks()const noexcept;
+        constexpr inline T* chunk(size_type c)noexcept;        // host buffer of chunk c, chunk_size elements long
+        constexpr inline const T* chunk(size_type c)const noexcept;
+
+        inline void reserve(size_type new_cap)noexcept;    // allocates chunks, nothing already stored moves
+        inline void shrink_to_fit()noexcept;               // frees the chunks past the last element
+        inline void clear()noexcept;                       // keeps the chunks
+
+        inline void push_back(const T& value)noexcept;
+        template<typename... Args>
+        inline reference emplace_back(Args && ...args)noexcept;
+        inline void pop_back()noexcept;
+        inline void resize(size_type new_size)noexcept;
+        inline void resize(size_type new_size, const T& value)noexcept;
+
+        // dirty tracking, only meaningful with a mirrored OffloadPolicy
+        inline void mark_dirty(const size_type begin, const size_type end)noexcept;
+        inline void mark_all_dirty()noexcept;
+        constexpr inline bool is_dirty(const size_type c)const noexcept;
+
+        // copy the dirty chunks to the device (allocating device chunks as needed), host_only does nothing
+        inline void map_data_to_omp_dev()noexcept;
+        // copy every chunk from the device, they are clean afterwards
+        inline void map_data_from_omp_dev()noexcept;
+        // force a copy of the chunks holding [begin,end)
+        inline void map_data_to_omp_dev(const size_type begin, const size_type end)noexcept;
+        inline void map_data_from_omp_dev(const size_type begin, const size_type end)noexcept;
+
+    private:
+        inline bool grow_directory(size_type min_chunks)noexcept;
+        inline bool add_chunks(size_type new_num_chunks)noexcept;
+        inline void free_chunks(size_type new_num_chunks)noexcept;
+        inline void destroy_dealloc()noexcept;
+        inline void map_chunk_to_omp_dev(size_type c)noexcept;
+        inline void map_chunk_from_omp_dev(size_type c)noexcept;
+        inline void update_dev_directory()noexcept;
+        static inline void dev_memcpy(void * dst, const void * src, size_type bytes, int dst_dev, int src_dev)noexcept;
+
+    // member variables
+        T ** chunks_;               // host chunk buffers
+        T ** dev_chunks_;           // device chunk buffers, the host's copy of the device directory
+        T ** dev_directory_;        // device chunk pointers on the device so () is a load and an index
+        unsigned char * dirty_;     // chunk changed on the host since it was last copied to the device
+        size_type num_chunks_;
+        size_type directory_cap_;
+        size_type dev_directory_cap_;
+        size_type size_;
+        bool dev_directory_stale_;
+        allocator_type alloc_;
+    };
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::operator [](const size_type i)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            dirty_[i >> chunk_shift] = 1;
+        }
+        return chunks_[i >> chunk_shift][i & chunk_mask];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::operator [](const size_type i)const noexcept{
+        return chunks_[i >> chunk_shift][i & chunk_mask];
+    }
+
+    #pragma omp declare target
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::operator ()(const size_type i)const noexcept{
+        return dev_directory_[i >> chunk_shift][i & chunk_mask];
+    }
+    #pragma omp end declare target
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::segmented_dynarray()noexcept
+        :chunks_(nullptr),
+        dev_chunks_(nullptr),
+        dev_directory_(nullptr),
+        dirty_(nullptr),
+        num_chunks_(0),
+        directory_cap_(0),
+        dev_directory_cap_(0),
+        size_(0),
+        dev_directory_stale_(false),
+        alloc_(){}
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::segmented_dynarray(size_type count)noexcept
+        :segmented_dynarray()
+    {
+        resize(count);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::segmented_dynarray(size_type count, const T& value)noexcept
+        :segmented_dynarray()
+    {
+        resize(count,value);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::segmented_dynarray(const segmented_dynarray & other)noexcept
+        :segmented_dynarray()
+    {
+        *this = other;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::segmented_dynarray(segmented_dynarray && other)noexcept
+        :segmented_dynarray()
+    {
+        swap(other);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::~segmented_dynarray()noexcept{
+        destroy_dealloc();
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>&
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::operator =(const segmented_dynarray & other)noexcept{
+        if (this == &other){
+            return *this;
+        }
+        const size_type needed = (other.size_ + chunk_mask) >> chunk_shift;
+        if (!add_chunks(needed)){
+            return *this;
+        }
+        for (size_type c = 0; c < needed; ++c){
+            const size_type count = ((c + 1) * chunk_size > other.size_) ? other.size_ - c * chunk_size:chunk_size;
+            std::memcpy(static_cast<void*>(chunks_[c]),static_cast<const void*>(other.chunks_[c]),sizeof(T)*count);
+        }
+        size_ = other.size_;
+        mark_all_dirty();
+        return *this;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>&
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::operator =(segmented_dynarray && other)noexcept{
+        if (this != &other){
+            destroy_dealloc();
+            swap(other);
+        }
+        return *this;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::swap(segmented_dynarray & rhs)noexcept{
+        using std::swap;
+        swap(chunks_,rhs.chunks_);
+        swap(dev_chunks_,rhs.dev_chunks_);
+        swap(dev_directory_,rhs.dev_directory_);
+        swap(dirty_,rhs.dirty_);
+        swap(num_chunks_,rhs.num_chunks_);
+        swap(directory_cap_,rhs.directory_cap_);
+        swap(dev_directory_cap_,rhs.dev_directory_cap_);
+        swap(size_,rhs.size_);
+        swap(dev_directory_stale_,rhs.dev_directory_stale_);
+        swap(alloc_,rhs.alloc_);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::at(size_type pos){
+        if ((pos>=size_) || (pos<0)){
+            std::cerr<<"Error segmented_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::at(size_type pos)const{
+        if ((pos>=size_) || (pos<0)){
+            std::cerr<<"Error segmented_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::front()noexcept{
+        return (*this)[0];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::front()const noexcept{
+        return (*this)[0];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::back()noexcept{
+        return (*this)[size_-1];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::back()const noexcept{
+        return (*this)[size_-1];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::begin()noexcept{
+        return iterator(this,0);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::begin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::cbegin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::end()noexcept{
+        return iterator(this,size_);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::end()const noexcept{
+        return const_iterator(this,size_);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::cend()const noexcept{
+        return const_iterator(this,size_);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reverse_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::rbegin()noexcept{
+        return reverse_iterator(end());
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_reverse_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::rbegin()const noexcept{
+        return const_reverse_iterator(end());
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reverse_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::rend()noexcept{
+        return reverse_iterator(begin());
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::const_reverse_iterator
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::rend()const noexcept{
+        return const_reverse_iterator(begin());
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline bool segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::empty()const noexcept{
+        return (size_ == 0);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::size_type
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::size()const noexcept{
+        return size_;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::size_type
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::capacity()const noexcept{
+        return num_chunks_ * chunk_size;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::size_type
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::num_chunks()const noexcept{
+        return num_chunks_;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline T* segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::chunk(size_type c)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            dirty_[c] = 1;
+        }
+        return chunks_[c];
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline const T* segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::chunk(size_type c)const noexcept{
+        return chunks_[c];
+    }
+
+    // the directory doubles, only chunk pointers are copied
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline bool segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::grow_directory(size_type min_chunks)noexcept{
+        if (min_chunks <= directory_cap_){
+            return true;
+        }
+        size_type new_cap = (directory_cap_ < 8) ? 8:directory_cap_ * 2;
+        new_cap = (new_cap < min_chunks) ? min_chunks:new_cap;
+        p_allocator_type p_alloc(alloc_);
+        c_allocator_type c_alloc(alloc_);
+        T ** new_chunks = std::allocator_traits<p_allocator_type>::allocate(p_alloc,new_cap);
+        T ** new_dev_chunks = std::allocator_traits<p_allocator_type>::allocate(p_alloc,new_cap);
+        unsigned char * new_dirty = std::allocator_traits<c_allocator_type>::allocate(c_alloc,new_cap);
+        if (!new_chunks || !new_dev_chunks || !new_dirty){
+            std::cerr<<"ERROR segmented_dynarray failed to allocate memory for the chunk directory"<<std::endl;
+            std::allocator_traits<p_allocator_type>::deallocate(p_alloc,new_chunks,new_cap);
+            std::allocator_traits<p_allocator_type>::deallocate(p_alloc,new_dev_chunks,new_cap);
+            std::allocator_traits<c_allocator_type>::deallocate(c_alloc,new_dirty,new_cap);
+            return false;
+        }
+        for (size_type c = 0; c < new_cap; ++c){
+            new_chunks[c] = (c < num_chunks_) ? chunks_[c]:nullptr;
+            new_dev_chunks[c] = (c < num_chunks_) ? dev_chunks_[c]:nullptr;
+            new_dirty[c] = (c < num_chunks_) ? dirty_[c]:0;
+        }
+        std::allocator_traits<p_allocator_type>::deallocate(p_alloc,chunks_,directory_cap_);
+        std::allocator_traits<p_allocator_type>::deallocate(p_alloc,dev_chunks_,directory_cap_);
+        std::allocator_traits<c_allocator_type>::deallocate(c_alloc,dirty_,directory_cap_);
+        chunks_ = new_chunks;
+        dev_chunks_ = new_dev_chunks;
+        dirty_ = new_dirty;
+        directory_cap_ = new_cap;
+        return true;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline bool segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::add_chunks(size_type new_num_chunks)noexcept{
+        if (new_num_chunks <= num_chunks_){
+            return true;
+        }
+        if (!grow_directory(new_num_chunks)){
+            return false;
+        }
+        for (size_type c = num_chunks_; c < new_num_chunks; ++c){
+            T * temp = std::allocator_traits<allocator_type>::allocate(alloc_,chunk_size);
+            if (!temp){
+                std::cerr<<"ERROR segmented_dynarray failed to allocate memory for a chunk"<<std::endl;
+                return false;
+            }
+            chunks_[c] = temp;
+            dev_chunks_[c] = nullptr;
+            dirty_[c] = 1;
+            ++num_chunks_;
+        }
+        return true;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::free_chunks(size_type new_num_chunks)noexcept{
+        for (size_type c = new_num_chunks; c < num_chunks_; ++c){
+            std::allocator_traits<allocator_type>::deallocate(alloc_,chunks_[c],chunk_size);
+            chunks_[c] = nullptr;
+            if constexpr (OffloadPolicy::offload){
+                if (dev_chunks_[c]){
+                    omp_target_free(dev_chunks_[c],OffloadPolicy::device);
+                    dev_chunks_[c] = nullptr;
+                    dev_directory_stale_ = true;
+                }
+            }
+        }
+        num_chunks_ = (new_num_chunks < num_chunks_) ? new_num_chunks:num_chunks_;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::destroy_dealloc()noexcept{
+        free_chunks(0);
+        if constexpr (OffloadPolicy::offload){
+            if (dev_directory_){
+                omp_target_free(dev_directory_,OffloadPolicy::device);
+            }
+        }
+        p_allocator_type p_alloc(alloc_);
+        c_allocator_type c_alloc(alloc_);
+        std::allocator_traits<p_allocator_type>::deallocate(p_alloc,chunks_,directory_cap_);
+        std::allocator_traits<p_allocator_type>::deallocate(p_alloc,dev_chunks_,directory_cap_);
+        std::allocator_traits<c_allocator_type>::deallocate(c_alloc,dirty_,directory_cap_);
+        chunks_ = nullptr;
+        dev_chunks_ = nullptr;
+        dev_directory_ = nullptr;
+        dirty_ = nullptr;
+        directory_cap_ = 0;
+        dev_directory_cap_ = 0;
+        size_ = 0;
+        dev_directory_stale_ = false;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reserve(size_type new_cap)noexcept{
+        add_chunks((new_cap + chunk_mask) >> chunk_shift);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::shrink_to_fit()noexcept{
+        free_chunks((size_ + chunk_mask) >> chunk_shift);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::clear()noexcept{
+        size_ = 0;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::push_back(const T& value)noexcept{
+        emplace_back(value);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    template<typename... Args>
+    inline typename segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::reference
+    segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::emplace_back(Args && ...args)noexcept{
+        if (size_ == capacity()){
+            // build the element first, args may refer to an element and the directory can move
+            T temp(std::forward<Args>(args)...);
+            if (!add_chunks(num_chunks_ + 1)){
+                return back();
+            }
+            ::new(static_cast<void*>(&chunks_[size_ >> chunk_shift][size_ & chunk_mask])) T(temp);
+        }else{
+            ::new(static_cast<void*>(&chunks_[size_ >> chunk_shift][size_ & chunk_mask])) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        return back();
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::pop_back()noexcept{
+        --size_;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::resize(size_type new_size)noexcept{
+        resize(new_size,T());
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::resize(size_type new_size, const T& value)noexcept{
+        if (new_size <= size_){
+            size_ = (new_size < 0) ? 0:new_size;
+            return;
+        }
+        const T temp(value);
+        if (!add_chunks((new_size + chunk_mask) >> chunk_shift)){
+            return;
+        }
+        // fill a chunk at a time so the inner loop is a plain contiguous loop
+        for (size_type c = size_ >> chunk_shift; c <= ((new_size - 1) >> chunk_shift); ++c){
+            T * buf = chunks_[c];
+            const size_type first = (c == (size_ >> chunk_shift)) ? (size_ & chunk_mask):0;
+            const size_type last = (c == ((new_size - 1) >> chunk_shift)) ? ((new_size - 1) & chunk_mask) + 1:chunk_size;
+            #pragma omp simd
+            for (size_type i = first; i < last; ++i){
+                buf[i] = temp;
+            }
+            if constexpr (OffloadPolicy::offload){
+                dirty_[c] = 1;
+            }
+        }
+        size_ = new_size;
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::mark_dirty(const size_type begin, const size_type end)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (end <= begin){
+                return;
+            }
+            for (size_type c = begin >> chunk_shift; c <= ((end - 1) >> chunk_shift); ++c){
+                dirty_[c] = 1;
+            }
+        }
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::mark_all_dirty()noexcept{
+        mark_dirty(0,size_);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    constexpr inline bool segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::is_dirty(const size_type c)const noexcept{
+        return (dirty_[c] != 0);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::dev_memcpy(void * dst, const void * src, size_type bytes, int dst_dev, int src_dev)noexcept{
+        try{
+            bool fail = omp_target_memcpy(dst,src,bytes,0,0,dst_dev,src_dev);
+            if(fail){
+                throw std::runtime_error("ERROR segmented_dynarray failed to copy data between host and device memory");
+            }
+        }catch(std::runtime_error& e){
+            std::cerr<<e.what()<<std::endl;
+        }catch(...){
+            std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+        }
+    }
+
+    // the device directory only changes when chunks are added or freed, it's copied over whole as it's small
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::update_dev_directory()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (!dev_directory_stale_ || (directory_cap_ == 0)){
+                return;
+            }
+            if (dev_directory_cap_ < directory_cap_){
+                T ** temp = (T **) omp_target_alloc(directory_cap_ * sizeof(T*), OffloadPolicy::device);
+                if (!temp){
+                    std::cerr<<"ERROR segmented_dynarray failed to allocate memory on offload device"<<std::endl;
+                    return;
+                }
+                if (dev_directory_){
+                    omp_target_free(dev_directory_,OffloadPolicy::device);
+                }
+                dev_directory_ = temp;
+                dev_directory_cap_ = directory_cap_;
+            }
+            dev_memcpy(dev_directory_,dev_chunks_,directory_cap_ * sizeof(T*),OffloadPolicy::device,omp_get_initial_device());
+            dev_directory_stale_ = false;
+        }
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::map_chunk_to_omp_dev(size_type c)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (!dev_chunks_[c]){
+                dev_chunks_[c] = (T *) omp_target_alloc(chunk_size * sizeof(T), OffloadPolicy::device);
+                if (!dev_chunks_[c]){
+                    std::cerr<<"ERROR segmented_dynarray failed to allocate memory on offload device"<<std::endl;
+                    return;
+                }
+                dev_directory_stale_ = true;
+            }
+            const size_type count = ((c + 1) * chunk_size > size_) ? size_ - c * chunk_size:chunk_size;
+            if (count > 0){
+                dev_memcpy(dev_chunks_[c],chunks_[c],count * sizeof(T),OffloadPolicy::device,omp_get_initial_device());
+            }
+            dirty_[c] = 0;
+        }
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::map_chunk_from_omp_dev(size_type c)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (!dev_chunks_[c]){
+                return;
+            }
+            const size_type count = ((c + 1) * chunk_size > size_) ? size_ - c * chunk_size:chunk_size;
+            if (count > 0){
+                dev_memcpy(chunks_[c],dev_chunks_[c],count * sizeof(T),omp_get_initial_device(),OffloadPolicy::device);
+            }
+            dirty_[c] = 0;
+        }
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            const size_type used_chunks = (size_ + chunk_mask) >> chunk_shift;
+            for (size_type c = 0; c < used_chunks; ++c){
+                if (dirty_[c] || !dev_chunks_[c]){
+                    map_chunk_to_omp_dev(c);
+                }
+            }
+            update_dev_directory();
+        }
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::map_data_from_omp_dev()noexcept{
+        map_data_from_omp_dev(0,size_);
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::map_data_to_omp_dev(const size_type begin, const size_type end)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (end <= begin){
+                return;
+            }
+            for (size_type c = begin >> chunk_shift; c <= ((end - 1) >> chunk_shift); ++c){
+                map_chunk_to_omp_dev(c);
+            }
+            update_dev_directory();
+        }
+    }
+
+    template<typename T, int chunk_shift, typename Allocator, typename OffloadPolicy>
+    inline void segmented_dynarray<T,chunk_shift,Allocator,OffloadPolicy>::map_data_from_omp_dev(const size_type begin, const size_type end)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (end <= begin){
+                return;
+            }
+            for (size_type c = begin >> chunk_shift; c <= ((end - 1) >> chunk_shift); ++c){
+                map_chunk_from_omp_dev(c);
+            }
+        }
+    }
+}
+#endif
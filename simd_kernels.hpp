@@ -0,0 +1,157 @@
+// small host side kernels over raw element runs (fill, copy, equal, mismatch, lexicographical_compare, find, sum, min, max)
+// written as plain omp simd loops so they vectorise on any compiler (that loop is also the scalar fallback), and with
+// HOPELESS_SIMD_CLONES each one is compiled for avx512f, avx2 and the baseline and picked at load time for the cpu
+// they are single threaded, the callers (bulk_construct, par, the comparison operators) split big runs over threads
+// the early exit searches look at a block of elements at a time so the inner loop stays branch free
+// NOTE! sum() and the float min()/max() are reassociated, a float sum can differ from a left to right one in the last bits
+#pragma once
+
+#ifndef HOPELESS_SIMD_KERNELS
+#define HOPELESS_SIMD_KERNELS
+
+#include<cstddef>
+#include<cstring>
+#include<type_traits>
+
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    namespace kernels
+    {
+        enum : std::ptrdiff_t {search_block = 64};
+
+        // dst[0,count) = value
+        template<typename T>
+        HOPELESS_SIMD_CLONES
+        inline void fill(T * dst, const std::ptrdiff_t count, const T value)noexcept{
+            static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+            if constexpr (sizeof(T) == 1){
+                if (count > 0){
+                    // T can be a one byte struct, take its byte instead of converting it
+                    unsigned char byte;
+                    std::memcpy(&byte,&value,1);
+                    std::memset(dst,byte,count);
+                }
+            }else{
+                #pragma omp simd
+                for (std::ptrdiff_t i = 0; i < count; ++i){
+                    dst[i] = value;
+                }
+            }
+        }
+
+        // non overlapping, the libc memcpy already dispatches on the cpu
+        template<typename T>
+        inline void copy(T * dst, const T * src, const std::ptrdiff_t count)noexcept{
+            static_assert(std::is_trivially_copyable_v<T>, "type should be trivially copyable");
+            if (count > 0){
+                std::memcpy(dst,src,count * sizeof(T));
+            }
+        }
+
+        // first i with !(a[i] == b[i]), count if there is none
+        template<typename T>
+        HOPELESS_SIMD_CLONES
+        inline std::ptrdiff_t mismatch(const T * a, const T * b, const std::ptrdiff_t count)noexcept{
+            std::ptrdiff_t i = 0;
+            for (; i + search_block <= count; i += search_block){
+                int differ = 0;
+                #pragma omp simd reduction(|:differ)
+                for (std::ptrdiff_t j = i; j < i + search_block; ++j){
+                    differ |= static_cast<int>(!(a[j] == b[j]));
+                }
+                if (differ){
+                    break;
+                }
+            }
+            for (; i < count; ++i){
+                if (!(a[i] == b[i])){
+                    return i;
+                }
+            }
+            return count;
+        }
+
+        // types where equal values have equal bytes (no padding, no float -0.0/nan) are compared with memcmp
+        template<typename T>
+        inline bool equal(const T * a, const T * b, const std::ptrdiff_t count)noexcept{
+            if constexpr (std::has_unique_object_representations_v<T>){
+                return (count <= 0) || (std::memcmp(a,b,count * sizeof(T)) == 0);
+            }else{
+                return mismatch(a,b,count) == count;
+            }
+        }
+
+        // like std::lexicographical_compare with operator <
+        template<typename T>
+        inline bool lexicographical_compare(const T * a, const std::ptrdiff_t count_a, const T * b, const std::ptrdiff_t count_b)noexcept{
+            const std::ptrdiff_t count = (count_a < count_b) ? count_a:count_b;
+            if constexpr (std::is_same_v<std::remove_cv_t<T>,unsigned char> || std::is_same_v<std::remove_cv_t<T>,std::byte>){
+                const int order = (count > 0) ? std::memcmp(a,b,count):0;
+                return (order != 0) ? (order < 0):(count_a < count_b);
+            }else{
+                const std::ptrdiff_t i = mismatch(a,b,count);
+                return (i < count) ? (a[i] < b[i]):(count_a < count_b);
+            }
+        }
+
+        // first i with a[i] == value, count if there is none
+        template<typename T>
+        HOPELESS_SIMD_CLONES
+        inline std::ptrdiff_t find(const T * a, const std::ptrdiff_t count, const T value)noexcept{
+            std::ptrdiff_t i = 0;
+            for (; i + search_block <= count; i += search_block){
+                int found = 0;
+                #pragma omp simd reduction(|:found)
+                for (std::ptrdiff_t j = i; j < i + search_block; ++j){
+                    found |= static_cast<int>(a[j] == value);
+                }
+                if (found){
+                    break;
+                }
+            }
+            for (; i < count; ++i){
+                if (a[i] == value){
+                    return i;
+                }
+            }
+            return count;
+        }
+
+        // sum, min and max are for arithmetic types
+        template<typename T>
+        HOPELESS_SIMD_CLONES
+        inline T sum(const T * a, const std::ptrdiff_t count, T init = T())noexcept{
+            #pragma omp simd reduction(+:init)
+            for (std::ptrdiff_t i = 0; i < count; ++i){
+                init += a[i];
+            }
+            return init;
+        }
+
+        // count has to be at least 1, with a nan in a the result depends on where it is
+        template<typename T>
+        HOPELESS_SIMD_CLONES
+        inline T min(const T * a, const std::ptrdiff_t count)noexcept{
+            T m = a[0];
+            #pragma omp simd reduction(min:m)
+            for (std::ptrdiff_t i = 1; i < count; ++i){
+                m = (a[i] < m) ? a[i]:m;
+            }
+            return m;
+        }
+
+        template<typename T>
+        HOPELESS_SIMD_CLONES
+        inline T max(const T * a, const std::ptrdiff_t count)noexcept{
+            T m = a[0];
+            #pragma omp simd reduction(max:m)
+            for (std::ptrdiff_t i = 1; i < count; ++i){
+                m = (m < a[i]) ? a[i]:m;
+            }
+            return m;
+        }
+    }
+}
+#endif
@@ -0,0 +1,652 @@
+// dynarray with room for N elements inside the object, short arrays never allocate (on the host or the device)
+// and past N the elements move to a dynarray once and stay there until shrink_to_fit()
+// while the elements are inline they travel with the object, so a small_dynarray mapped (or implicitly mapped) into
+// a target region can be read there through operator () whether it spilled or not
+// NOTE! iterators are plain pointers and get invalidated when the array spills
+#pragma once
+
+#ifndef HOPELESS_SMALL_DYNARRAY
+#define HOPELESS_SMALL_DYNARRAY
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<type_traits>
+#include<memory>
+#include<new>
+#include<initializer_list>
+#include<utility>
+#include<iterator>
+
+#include "allocator.hpp"
+#include "dynarray.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename T, std::ptrdiff_t N, typename Allocator = hopeless::allocator<T>,
+                        typename OffloadPolicy = HOPELESS_DEFAULT_OFFLOAD_POLICY,
+                        typename GrowthPolicy = HOPELESS_DYNARRAY_DEFAULT_GROWTH_POLICY>
+    struct small_dynarray
+    {
+        static_assert(N > 0, "small_dynarray needs room for at least one inline element");
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::ptrdiff_t size_type;
+        typedef value_type& reference;
+        typedef const value_type& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef typename std::reverse_iterator<iterator> reverse_iterator;
+        typedef typename std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef dynarray<T,Allocator,OffloadPolicy,GrowthPolicy> heap_type;
+
+        enum : std::ptrdiff_t {inline_capacity = N};     // not a static member so the type stays mappable
+
+        constexpr inline reference operator [](const size_type i)noexcept;
+        constexpr inline const_reference operator [](const size_type i)const noexcept;
+        // device side access, the inline elements if it hasn't spilled else the dynarray's device buffer
+        #pragma omp declare target
+        constexpr inline reference operator ()(const size_type i)noexcept;
+        constexpr inline const_reference operator ()(const size_type i)const noexcept;
+        #pragma omp end declare target
+
+        small_dynarray()noexcept;
+        explicit small_dynarray(size_type count)noexcept;
+        small_dynarray(size_type count, const T& value)noexcept;
+        small_dynarray(std::initializer_list<T> init)noexcept;
+        small_dynarray(const small_dynarray & other)noexcept;
+        small_dynarray(small_dynarray && other)noexcept;
+        ~small_dynarray()noexcept;
+
+        small_dynarray& operator =(const small_dynarray & other)noexcept;
+        small_dynarray& operator =(small_dynarray && other)noexcept;
+
+        constexpr inline reference at(size_type pos);
+        constexpr inline const_reference at(size_type pos)const;
+        constexpr inline reference front()noexcept;
+        constexpr inline const_reference front()const noexcept;
+        constexpr inline reference back()noexcept;
+        constexpr inline const_reference back()const noexcept;
+        constexpr inline T* data()noexcept;
+        constexpr inline const T* data()const noexcept;
+
+        constexpr inline iterator begin()noexcept;
+        constexpr inline const_iterator begin()const noexcept;
+        constexpr inline const_iterator cbegin()const noexcept;
+        constexpr inline iterator end()noexcept;
+        constexpr inline const_iterator end()const noexcept;
+        constexpr inline const_iterator cend()const noexcept;
+        constexpr inline reverse_iterator rbegin()noexcept;
+        constexpr inline const_reverse_iterator rbegin()const noexcept;
+        constexpr inline reverse_iterator rend()noexcept;
+        constexpr inline const_reverse_iterator rend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;
+        constexpr inline bool is_inline()const noexcept;   // false once the elements live in the dynarray
+
+        inline void reserve(size_type new_cap)noexcept;    // spills if new_cap > N
+        inline void spill()noexcept;                       // move the elements to the dynarray now, e.g. before heavy device use
+        inline void shrink_to_fit()noexcept;               // moves the elements back inline if they fit
+        inline void clear()noexcept;
+
+        inline iterator insert(const_iterator pos, const T& value)noexcept;
+        inline iterator insert(const_iterator pos, T&& value)noexcept;
+        template<typename... Args>
+        inline iterator emplace(const_iterator pos, Args&&... args)noexcept;
+        inline iterator erase(const_iterator pos)noexcept;
+        inline iterator erase(const_iterator first, const_iterator last)noexcept;
+
+        inline void push_back(const T& value)noexcept;
+        inline void push_back(T&& value)noexcept;
+        template<typename... Args>
+        inline reference emplace_back(Args && ...args)noexcept;
+        inline void pop_back()noexcept;
+
+        inline void resize(size_type new_size)noexcept;
+        inline void resize(size_type new_size, const T& value)noexcept;
+
+        // both do nothing while the elements are inline as they are copied along with the object
+        inline void map_data_to_omp_dev()noexcept;
+        inline void map_data_from_omp_dev()noexcept;
+
+        constexpr inline const heap_type & heap()const noexcept;
+
+    private:
+        constexpr inline T* inline_data()noexcept;
+        constexpr inline const T* inline_data()const noexcept;
+        inline void spill(size_type new_cap)noexcept;
+        inline void destroy_inline(size_type begin)noexcept;   // destroys [begin,size_) and sets size_ = begin
+        template<typename... Args>
+        inline void resize_inline(size_type new_size, Args && ...args)noexcept;
+
+    // member variables
+        alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+        size_type size_;        // number of inline elements, 0 once spilled
+        bool spilled_;
+        heap_type heap_;
+    };
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline T* small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::inline_data()noexcept{
+        return std::launder(reinterpret_cast<T*>(inline_buffer_));
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline const T* small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::inline_data()const noexcept{
+        return std::launder(reinterpret_cast<const T*>(inline_buffer_));
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::operator [](const size_type i)noexcept{
+        return data()[i];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::operator [](const size_type i)const noexcept{
+        return data()[i];
+    }
+
+    #pragma omp declare target
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::operator ()(const size_type i)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (spilled_){
+                return heap_(i);
+            }
+        }
+        return data()[i];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::operator ()(const size_type i)const noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (spilled_){
+                return heap_(i);
+            }
+        }
+        return data()[i];
+    }
+    #pragma omp end declare target
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::small_dynarray()noexcept
+        :size_(0),
+        spilled_(false),
+        heap_(){}
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::small_dynarray(size_type count)noexcept
+        :small_dynarray()
+    {
+        resize(count);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::small_dynarray(size_type count, const T& value)noexcept
+        :small_dynarray()
+    {
+        resize(count,value);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::small_dynarray(std::initializer_list<T> init)noexcept
+        :small_dynarray()
+    {
+        reserve(static_cast<size_type>(init.size()));
+        for (const T & value : init){
+            push_back(value);
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::small_dynarray(const small_dynarray & other)noexcept
+        :small_dynarray()
+    {
+        if (other.spilled_){
+            heap_ = other.heap_;
+            spilled_ = true;
+        }else{
+            for (size_type i = 0; i < other.size_; ++i){
+                ::new(static_cast<void*>(inline_data() + i)) T(other.inline_data()[i]);
+                ++size_;
+            }
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::small_dynarray(small_dynarray && other)noexcept
+        :small_dynarray()
+    {
+        *this = std::move(other);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::~small_dynarray()noexcept{
+        destroy_inline(0);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>&
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::operator =(const small_dynarray & other)noexcept{
+        if (this == &other){
+            return *this;
+        }
+        clear();
+        if (other.spilled_ || spilled_){
+            spill(other.size());
+            heap_ = other.heap_;
+            if (!other.spilled_){
+                heap_.append_range(other.inline_data(),other.inline_data() + other.size_);
+            }
+        }else{
+            for (size_type i = 0; i < other.size_; ++i){
+                ::new(static_cast<void*>(inline_data() + i)) T(other.inline_data()[i]);
+                ++size_;
+            }
+        }
+        return *this;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>&
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::operator =(small_dynarray && other)noexcept{
+        if (this == &other){
+            return *this;
+        }
+        destroy_inline(0);
+        if (other.spilled_){
+            heap_ = std::move(other.heap_);
+            spilled_ = true;
+            heap_type empty;
+            other.heap_ = std::move(empty);
+            other.spilled_ = false;
+        }else{
+            if (spilled_){
+                heap_.clear();
+                heap_.append_range(std::make_move_iterator(other.inline_data()),std::make_move_iterator(other.inline_data() + other.size_));
+            }else{
+                for (size_type i = 0; i < other.size_; ++i){
+                    ::new(static_cast<void*>(inline_data() + i)) T(std::move(other.inline_data()[i]));
+                    ++size_;
+                }
+            }
+            other.destroy_inline(0);
+        }
+        return *this;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::at(size_type pos){
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error small_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return data()[pos];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::at(size_type pos)const{
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error small_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return data()[pos];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::front()noexcept{
+        return data()[0];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::front()const noexcept{
+        return data()[0];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::back()noexcept{
+        return data()[size()-1];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::back()const noexcept{
+        return data()[size()-1];
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline T* small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::data()noexcept{
+        return spilled_ ? heap_.data():inline_data();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline const T* small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::data()const noexcept{
+        return spilled_ ? heap_.data():inline_data();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::begin()noexcept{
+        return data();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::begin()const noexcept{
+        return data();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::cbegin()const noexcept{
+        return data();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::end()noexcept{
+        return data() + size();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::end()const noexcept{
+        return data() + size();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::cend()const noexcept{
+        return data() + size();
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reverse_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::rbegin()noexcept{
+        return reverse_iterator(end());
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reverse_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::rbegin()const noexcept{
+        return const_reverse_iterator(end());
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reverse_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::rend()noexcept{
+        return reverse_iterator(begin());
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::const_reverse_iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::rend()const noexcept{
+        return const_reverse_iterator(begin());
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline bool small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::empty()const noexcept{
+        return (size() == 0);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::size()const noexcept{
+        return spilled_ ? heap_.size():size_;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::size_type
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::capacity()const noexcept{
+        return spilled_ ? heap_.capacity():N;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline bool small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::is_inline()const noexcept{
+        return !spilled_;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    constexpr inline const typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::heap_type &
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::heap()const noexcept{
+        return heap_;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::destroy_inline(size_type begin)noexcept{
+        if constexpr (!std::is_trivially_destructible_v<T>){
+            for (size_type i = begin; i < size_; ++i){
+                std::destroy_at(inline_data() + i);
+            }
+        }
+        size_ = begin;
+    }
+
+    // move the inline elements into the dynarray with room for at least new_cap, a no op once spilled
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::spill(size_type new_cap)noexcept{
+        if (spilled_){
+            heap_.reserve(new_cap);
+            return;
+        }
+        heap_.reserve(GrowthPolicy::next_capacity(N,(new_cap > size_) ? new_cap:size_,sizeof(T)));
+        if constexpr (std::is_trivially_copyable_v<T>){
+            // plain pointers take append_range's memcpy path, move iterators would go through an omp parallel loop
+            heap_.append_range(inline_data(),inline_data() + size_);
+        }else{
+            heap_.append_range(std::make_move_iterator(inline_data()),std::make_move_iterator(inline_data() + size_));
+        }
+        destroy_inline(0);
+        spilled_ = true;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::spill()noexcept{
+        spill(size());
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reserve(size_type new_cap)noexcept{
+        if (new_cap > capacity()){
+            spill(new_cap);
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::shrink_to_fit()noexcept{
+        if (!spilled_){
+            return;
+        }
+        if (heap_.size() > N){
+            heap_.shrink_to_fit();
+            return;
+        }
+        const size_type count = heap_.size();
+        for (size_type i = 0; i < count; ++i){
+            ::new(static_cast<void*>(inline_data() + i)) T(std::move(heap_[i]));
+        }
+        size_ = count;
+        spilled_ = false;
+        heap_type empty;
+        heap_ = std::move(empty);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::clear()noexcept{
+        if (spilled_){
+            heap_.clear();
+        }else{
+            destroy_inline(0);
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::insert(const_iterator pos, const T& value)noexcept{
+        return emplace(pos,value);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::insert(const_iterator pos, T&& value)noexcept{
+        return emplace(pos,std::move(value));
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    template<typename... Args>
+    inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::emplace(const_iterator pos, Args&&... args)noexcept{
+        const size_type index = pos - cbegin();
+        if (!spilled_ && (size_ == N)){
+            spill(N + 1);
+        }
+        if (spilled_){
+            return heap_.emplace(heap_.cbegin() + index,std::forward<Args>(args)...).ptr();
+        }
+        T * buf = inline_data();
+        if (index == size_){
+            ::new(static_cast<void*>(buf + size_)) T(std::forward<Args>(args)...);
+        }else{
+            // build the element first in case args refer to something in the array
+            T temp(std::forward<Args>(args)...);
+            ::new(static_cast<void*>(buf + size_)) T(std::move(buf[size_-1]));
+            std::move_backward(buf + index,buf + size_ - 1,buf + size_);
+            buf[index] = std::move(temp);
+        }
+        ++size_;
+        return buf + index;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::erase(const_iterator pos)noexcept{
+        return erase(pos,pos + 1);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::iterator
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::erase(const_iterator first, const_iterator last)noexcept{
+        const size_type begin = first - cbegin();
+        const size_type end = last - cbegin();
+        if (spilled_){
+            return heap_.erase(heap_.cbegin() + begin,heap_.cbegin() + end).ptr();
+        }
+        if (end <= begin){
+            return inline_data() + begin;
+        }
+        T * buf = inline_data();
+        std::move(buf + end,buf + size_,buf + begin);
+        destroy_inline(size_ - (end - begin));
+        return buf + begin;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::push_back(const T& value)noexcept{
+        emplace_back(value);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::push_back(T&& value)noexcept{
+        emplace_back(std::move(value));
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    template<typename... Args>
+    inline typename small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::reference
+    small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::emplace_back(Args && ...args)noexcept{
+        if (!spilled_ && (size_ < N)){
+            ::new(static_cast<void*>(inline_data() + size_)) T(std::forward<Args>(args)...);
+            ++size_;
+            return inline_data()[size_-1];
+        }
+        if (!spilled_){
+            // the new element may be a copy of an inline one so build it before the elements move
+            T temp(std::forward<Args>(args)...);
+            spill(N + 1);
+            return heap_.emplace_back(std::move(temp));
+        }
+        return heap_.emplace_back(std::forward<Args>(args)...);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::pop_back()noexcept{
+        if (spilled_){
+            heap_.pop_back();
+        }else{
+            destroy_inline(size_ - 1);
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    template<typename... Args>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::resize_inline(size_type new_size, Args && ...args)noexcept{
+        if (new_size <= size_){
+            destroy_inline(new_size);
+            return;
+        }
+        for (size_type i = size_; i < new_size; ++i){
+            ::new(static_cast<void*>(inline_data() + i)) T(args...);
+        }
+        size_ = new_size;
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::resize(size_type new_size)noexcept{
+        if (!spilled_ && (new_size <= N)){
+            resize_inline(new_size);
+            return;
+        }
+        spill(new_size);
+        heap_.resize(new_size);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::resize(size_type new_size, const T& value)noexcept{
+        if (!spilled_ && (new_size <= N)){
+            resize_inline(new_size,value);
+            return;
+        }
+        if (!spilled_){
+            T temp(value);
+            spill(new_size);
+            heap_.resize(new_size,temp);
+            return;
+        }
+        heap_.resize(new_size,value);
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (spilled_){
+                heap_.map_data_to_omp_dev();
+            }
+        }
+    }
+
+    template<typename T, std::ptrdiff_t N, typename Allocator, typename OffloadPolicy, typename GrowthPolicy>
+    inline void small_dynarray<T,N,Allocator,OffloadPolicy,GrowthPolicy>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            if (spilled_){
+                heap_.map_data_from_omp_dev();
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,745 @@
+// structure of arrays container, one dynarray per field that all share the same size
+// kernels that only touch some of the fields only load (and only transfer to the device) those columns
+// rows are accessed through proxy references (a std::tuple of references to the fields) and zipped iterators
+// for device access take the column, e.g. auto & x = soa.column<0>(); and index it with x(i) in the target region
+// NOTE! like dynarray the iterators aren't meant for the device
+#pragma once
+
+#ifndef HOPELESS_SOA_DYNARRAY
+#define HOPELESS_SOA_DYNARRAY
+
+#include<iostream>
+#include<stdexcept>
+#include<cstddef>
+#include<type_traits>
+#include<memory>
+#include<tuple>
+#include<utility>
+#include<iterator>
+#include<algorithm>
+
+#include "allocator.hpp"
+#include "transfer_batch.hpp"
+#include "dynarray.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+    template<typename OffloadPolicy, typename... Fields>
+    struct basic_soa_dynarray
+    {
+        static_assert(sizeof...(Fields) > 0, "soa_dynarray needs at least one field");
+    public:
+        template<bool is_const> struct zip_iterator;
+
+        typedef std::tuple<Fields...> value_type;
+        typedef std::tuple<Fields&...> reference;
+        typedef std::tuple<const Fields&...> const_reference;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::ptrdiff_t size_type;
+        typedef zip_iterator<false> iterator;
+        typedef zip_iterator<true> const_iterator;
+        typedef typename std::reverse_iterator<iterator> reverse_iterator;
+        typedef typename std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        template<std::size_t I>
+        using field_type = std::tuple_element_t<I,value_type>;
+        template<std::size_t I>
+        using column_type = dynarray<field_type<I>,hopeless::allocator<field_type<I>>,OffloadPolicy>;
+        typedef std::tuple<dynarray<Fields,hopeless::allocator<Fields>,OffloadPolicy>...> columns_type;
+
+        static constexpr std::size_t num_fields = sizeof...(Fields);
+
+        // the iterator is the container and a row index, dereferencing builds the proxy reference for that row
+        template<bool is_const>
+        struct zip_iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef typename basic_soa_dynarray::value_type value_type;
+            typedef std::conditional_t<is_const,typename basic_soa_dynarray::const_reference,typename basic_soa_dynarray::reference> reference;
+            typedef std::ptrdiff_t difference_type;
+            typedef void pointer;
+            typedef std::conditional_t<is_const,const basic_soa_dynarray,basic_soa_dynarray> container_type;
+        protected:
+            container_type * soa;
+            difference_type row;
+        public:
+            constexpr zip_iterator()noexcept:soa(nullptr),row(0){}
+            constexpr zip_iterator(container_type * container, difference_type i)noexcept:soa(container),row(i){}
+            template<bool other_const, typename = std::enable_if_t<is_const && !other_const>>
+            constexpr zip_iterator(const zip_iterator<other_const> & it)noexcept:soa(it.container()),row(it.index()){}
+
+            inline zip_iterator & operator ++()noexcept{++row;return *this;}
+            inline zip_iterator  operator ++(int)noexcept{auto temp = *this; ++row; return temp;}
+            inline zip_iterator & operator --()noexcept{--row;return *this;}
+            inline zip_iterator  operator --(int)noexcept{auto temp = *this; --row; return temp;}
+            inline zip_iterator & operator +=(const difference_type n)noexcept{row+=n;return *this;}
+            inline zip_iterator & operator -=(const difference_type n)noexcept{row-=n;return *this;}
+            inline zip_iterator  operator +(const difference_type n)const noexcept{return zip_iterator(soa,row + n);}
+            inline zip_iterator  operator -(const difference_type n)const noexcept{return zip_iterator(soa,row - n);}
+            inline friend zip_iterator operator +(const difference_type n, const zip_iterator it)noexcept{return zip_iterator(it.soa,it.row + n);}
+
+            inline reference operator *()const noexcept{return (*soa)[row];}
+            inline reference operator [](const difference_type n)const noexcept{return (*soa)[row + n];}
+
+            constexpr inline container_type * container()const noexcept{return soa;}
+            constexpr inline difference_type index()const noexcept{return row;}
+
+            inline friend bool operator > (const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row>rhs.row);}
+            inline friend bool operator < (const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row<rhs.row);}
+            inline friend bool operator != (const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row!=rhs.row);}
+            inline friend bool operator == (const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row==rhs.row);}
+            inline friend bool operator >= (const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row>=rhs.row);}
+            inline friend bool operator <= (const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row<=rhs.row);}
+            inline friend difference_type operator -(const zip_iterator lhs, const zip_iterator rhs)noexcept{return (lhs.row - rhs.row);}
+        };
+
+        basic_soa_dynarray()noexcept;
+        explicit basic_soa_dynarray(size_type count)noexcept;
+        basic_soa_dynarray(size_type count, const Fields&... values)noexcept;
+
+        inline reference operator [](const size_type i)noexcept;
+        inline const_reference operator [](const size_type i)const noexcept;
+        inline reference at(size_type pos);
+        inline const_reference at(size_type pos)const;
+        inline reference front()noexcept;
+        inline const_reference front()const noexcept;
+        inline reference back()noexcept;
+        inline const_reference back()const noexcept;
+
+        // a single field of row i and the whole column holding field I
+        template<std::size_t I>
+        inline field_type<I> & field(const size_type i)noexcept;
+        template<std::size_t I>
+        inline const field_type<I> & field(const size_type i)const noexcept;
+        template<std::size_t I>
+        constexpr inline column_type<I> & column()noexcept;
+        template<std::size_t I>
+        constexpr inline const column_type<I> & column()const noexcept;
+        template<std::size_t I>
+        constexpr inline field_type<I> * data()noexcept;
+        template<std::size_t I>
+        constexpr inline const field_type<I> * data()const noexcept;
+
+        inline iterator begin()noexcept;
+        inline const_iterator begin()const noexcept;
+        inline const_iterator cbegin()const noexcept;
+        inline iterator end()noexcept;
+        inline const_iterator end()const noexcept;
+        inline const_iterator cend()const noexcept;
+        inline reverse_iterator rbegin()noexcept;
+        inline const_reverse_iterator rbegin()const noexcept;
+        inline reverse_iterator rend()noexcept;
+        inline const_reverse_iterator rend()const noexcept;
+
+        constexpr inline bool empty()const noexcept;
+        constexpr inline size_type size()const noexcept;
+        constexpr inline size_type capacity()const noexcept;    // smallest capacity over the columns
+
+        // everything that changes the size is applied to every column so they never disagree
+        inline void reserve(size_type new_cap)noexcept;
+        inline void shrink_to_fit()noexcept;
+        inline void clear()noexcept;
+        inline void resize(size_type new_size)noexcept;
+        inline void resize(size_type new_size, const Fields&... values)noexcept;
+
+        inline void push_back(const Fields&... values)noexcept;
+        inline void push_back(const value_type & values)noexcept;
+        inline void pop_back()noexcept;
+        inline iterator insert(const_iterator pos, const Fields&... values)noexcept;
+        inline iterator erase(const_iterator pos)noexcept;
+        inline iterator erase(const_iterator first, const_iterator last)noexcept;
+
+        // same index convention as dynarray::buffered_insert, row k of insert_rows goes where insert(begin()+insert_indices[k],...)
+        // called for k = 0,1,... in turn would put it, every column is shifted once with a backward merge
+        // and afterwards the indices hold where each row ended up, nothing changes if an index is out of bounds
+        template<typename index_container>
+        inline auto buffered_insert(const basic_soa_dynarray & insert_rows, index_container & insert_indices)noexcept
+            -> type_<void,
+                decltype(std::declval<index_container>().begin()),
+                decltype(std::declval<index_container>().end()),
+                decltype(std::declval<index_container>().size()),
+                decltype(static_cast<int>(*(std::declval<index_container>().begin())))>;
+        template<typename indices>
+        inline auto buffered_insert(const basic_soa_dynarray & insert_rows, indices insert_indices[], size_type count)noexcept
+            -> type_<void,
+                decltype(static_cast<int>(std::declval<indices>()))>;
+
+        // same index convention as dynarray::buffered_erase, the rows erase(begin()+erase_indices[k]) called for k = 0,1,...
+        // in turn would erase, every column is compacted once, nothing changes if an index is out of bounds
+        template<typename index_container>
+        inline auto buffered_erase(const index_container & erase_indices)noexcept
+            -> type_<void,
+                decltype(std::declval<index_container>().begin()),
+                decltype(std::declval<index_container>().end()),
+                decltype(std::declval<index_container>().size()),
+                decltype(static_cast<int>(*(std::declval<index_container>().begin())))>;
+        template<typename indices>
+        inline auto buffered_erase(const indices erase_indices[], size_type count)noexcept
+            -> type_<void,
+                decltype(static_cast<int>(std::declval<indices>()))>;
+
+        // per field device transfers, only columns a kernel needs have to be moved, do nothing for host_only
+        template<std::size_t I>
+        inline void map_field_to_omp_dev()noexcept;
+        template<std::size_t I>
+        inline void map_field_from_omp_dev()noexcept;
+        template<std::size_t I>
+        inline void map_field_to_omp_dev(const size_type begin, const size_type end)noexcept;
+        template<std::size_t I>
+        inline void map_field_from_omp_dev(const size_type begin, const size_type end)noexcept;
+    #ifdef HOPELESS_TARGET_OMP_DEV
+        template<std::size_t I, int dev_no>
+        inline void map_field_to_omp_dev(transfer_batch<dev_no> & batch)noexcept;
+        template<std::size_t I, int dev_no>
+        inline void map_field_from_omp_dev(transfer_batch<dev_no> & batch)noexcept;
+    #endif
+        inline void map_data_to_omp_dev()noexcept;      // every column
+        inline void map_data_from_omp_dev()noexcept;
+
+    private:
+        template<typename Function>
+        inline void for_each_column(Function && f)noexcept;
+        inline bool buffered_insert_impl(const basic_soa_dynarray & insert_rows, size_type * positions, size_type * scratch, size_type count)noexcept;
+        inline void buffered_erase_impl(size_type * erase_rows, size_type count)noexcept;
+
+    // member variables
+        columns_type columns_;
+    };
+
+    template<typename... Fields>
+    using soa_dynarray = basic_soa_dynarray<HOPELESS_DEFAULT_OFFLOAD_POLICY,Fields...>;
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<typename Function>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::for_each_column(Function && f)noexcept{
+        std::apply([&f](auto & ...column){(f(column), ...);},columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    basic_soa_dynarray<OffloadPolicy,Fields...>::basic_soa_dynarray()noexcept
+        :columns_(){}
+
+    template<typename OffloadPolicy, typename... Fields>
+    basic_soa_dynarray<OffloadPolicy,Fields...>::basic_soa_dynarray(size_type count)noexcept
+        :columns_(dynarray<Fields,hopeless::allocator<Fields>,OffloadPolicy>(count)...){}
+
+    template<typename OffloadPolicy, typename... Fields>
+    basic_soa_dynarray<OffloadPolicy,Fields...>::basic_soa_dynarray(size_type count, const Fields&... values)noexcept
+        :columns_(dynarray<Fields,hopeless::allocator<Fields>,OffloadPolicy>(count,values)...){}
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::operator [](const size_type i)noexcept{
+        return std::apply([i](auto & ...column){return reference(column[i]...);},columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::operator [](const size_type i)const noexcept{
+        return std::apply([i](const auto & ...column){return const_reference(column.data()[i]...);},columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::at(size_type pos){
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error soa_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::at(size_type pos)const{
+        if ((pos>=size()) || (pos<0)){
+            std::cerr<<"Error soa_dynarray indexing with at() out of bounds"<<std::endl;
+            throw std::out_of_range("Bad pos passed to at()");
+        }
+        return (*this)[pos];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::front()noexcept{
+        return (*this)[0];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::front()const noexcept{
+        return (*this)[0];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::back()noexcept{
+        return (*this)[size()-1];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_reference
+    basic_soa_dynarray<OffloadPolicy,Fields...>::back()const noexcept{
+        return (*this)[size()-1];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::template field_type<I> &
+    basic_soa_dynarray<OffloadPolicy,Fields...>::field(const size_type i)noexcept{
+        return std::get<I>(columns_)[i];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    inline const typename basic_soa_dynarray<OffloadPolicy,Fields...>::template field_type<I> &
+    basic_soa_dynarray<OffloadPolicy,Fields...>::field(const size_type i)const noexcept{
+        return std::get<I>(columns_).data()[i];
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    constexpr inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::template column_type<I> &
+    basic_soa_dynarray<OffloadPolicy,Fields...>::column()noexcept{
+        return std::get<I>(columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    constexpr inline const typename basic_soa_dynarray<OffloadPolicy,Fields...>::template column_type<I> &
+    basic_soa_dynarray<OffloadPolicy,Fields...>::column()const noexcept{
+        return std::get<I>(columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    constexpr inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::template field_type<I> *
+    basic_soa_dynarray<OffloadPolicy,Fields...>::data()noexcept{
+        return std::get<I>(columns_).data();
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    constexpr inline const typename basic_soa_dynarray<OffloadPolicy,Fields...>::template field_type<I> *
+    basic_soa_dynarray<OffloadPolicy,Fields...>::data()const noexcept{
+        return std::get<I>(columns_).data();
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::begin()noexcept{
+        return iterator(this,0);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::begin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::cbegin()const noexcept{
+        return const_iterator(this,0);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::end()noexcept{
+        return iterator(this,size());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::end()const noexcept{
+        return const_iterator(this,size());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::cend()const noexcept{
+        return const_iterator(this,size());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::reverse_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::rbegin()noexcept{
+        return reverse_iterator(end());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_reverse_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::rbegin()const noexcept{
+        return const_reverse_iterator(end());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::reverse_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::rend()noexcept{
+        return reverse_iterator(begin());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::const_reverse_iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::rend()const noexcept{
+        return const_reverse_iterator(begin());
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    constexpr inline bool basic_soa_dynarray<OffloadPolicy,Fields...>::empty()const noexcept{
+        return (size() == 0);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    constexpr inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::size_type
+    basic_soa_dynarray<OffloadPolicy,Fields...>::size()const noexcept{
+        return std::get<0>(columns_).size();
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    constexpr inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::size_type
+    basic_soa_dynarray<OffloadPolicy,Fields...>::capacity()const noexcept{
+        return std::apply([](const auto & ...column){return std::min({column.capacity()...});},columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::reserve(size_type new_cap)noexcept{
+        for_each_column([new_cap](auto & column){column.reserve(new_cap);});
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::shrink_to_fit()noexcept{
+        for_each_column([](auto & column){column.shrink_to_fit();});
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::clear()noexcept{
+        for_each_column([](auto & column){column.clear();});
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::resize(size_type new_size)noexcept{
+        for_each_column([new_size](auto & column){column.resize(new_size);});
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::resize(size_type new_size, const Fields&... values)noexcept{
+        std::apply([&](auto & ...column){(column.resize(new_size,values), ...);},columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::push_back(const Fields&... values)noexcept{
+        std::apply([&](auto & ...column){(column.push_back(values), ...);},columns_);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::push_back(const value_type & values)noexcept{
+        std::apply([this](const Fields&... row){push_back(row...);},values);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::pop_back()noexcept{
+        for_each_column([](auto & column){column.pop_back();});
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::insert(const_iterator pos, const Fields&... values)noexcept{
+        const size_type row = pos.index();
+        std::apply([&](auto & ...column){(column.insert(column.cbegin() + row,values), ...);},columns_);
+        return iterator(this,row);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::erase(const_iterator pos)noexcept{
+        return erase(pos,pos + 1);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline typename basic_soa_dynarray<OffloadPolicy,Fields...>::iterator
+    basic_soa_dynarray<OffloadPolicy,Fields...>::erase(const_iterator first, const_iterator last)noexcept{
+        const size_type begin = first.index();
+        const size_type end = last.index();
+        for_each_column([begin,end](auto & column){column.erase(column.cbegin() + begin,column.cbegin() + end);});
+        return iterator(this,begin);
+    }
+
+    // positions[k] is the index row k of insert_rows is inserted at when the rows go in one after the other, scratch holds 2*count,
+    // afterwards positions[k] holds where it ended up, false (and nothing changed) if an index is out of bounds
+    template<typename OffloadPolicy, typename... Fields>
+    inline bool basic_soa_dynarray<OffloadPolicy,Fields...>::buffered_insert_impl(const basic_soa_dynarray & insert_rows,
+        size_type * positions, size_type * scratch, size_type count)noexcept{
+        const size_type old_size = size();
+        const size_type new_size = old_size + count;
+        for (size_type k = 0; k < count; ++k){
+            if ((positions[k] < 0) || (positions[k] > old_size + k)){
+                std::cerr<<"Error soa_dynarray buffered_insert index "<<positions[k]<<" out of bounds for insert "<<k
+                         <<" of "<<count<<" into size "<<old_size<<", nothing was inserted"<<std::endl;
+                return false;
+            }
+        }
+        // the final positions, a later insert at or before an earlier one pushes it back by one (as in dynarray)
+        for (size_type k = 1; k < count; ++k){
+            for (size_type j = 0; j < k; ++j){
+                positions[j] += static_cast<size_type>(positions[j] >= positions[k]);
+            }
+        }
+        size_type * order = scratch;
+        size_type * old_positions = scratch + count;
+        for (size_type k = 0; k < count; ++k){
+            order[k] = k;
+        }
+        std::sort(order,order + count,[positions](const size_type a, const size_type b){return positions[a] < positions[b];});
+        // the k-th inserted row in final order has k new rows in front of it, what's left is its place in the old array
+        for (size_type k = 0; k < count; ++k){
+            old_positions[k] = positions[order[k]] - k;
+        }
+        std::apply([&](auto & ...column){
+            std::apply([&](const auto & ...rows){
+                // walk from the back so every element is moved once, the gap in front of it already holds what it replaced
+                auto merge = [&](auto & col, const auto & new_rows){
+                    col.resize(new_size);
+                    auto * buf = col.data();
+                    size_type src = old_size - 1;
+                    size_type dst = new_size - 1;
+                    for (size_type k = count - 1; k >= 0; --k){
+                        while (src >= old_positions[k]){
+                            buf[dst--] = std::move(buf[src--]);
+                        }
+                        buf[dst--] = new_rows.data()[order[k]];
+                    }
+                };
+                (merge(column,rows), ...);
+            },insert_rows.columns_);
+        },columns_);
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+        return true;
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<typename index_container>
+    inline auto basic_soa_dynarray<OffloadPolicy,Fields...>::buffered_insert(const basic_soa_dynarray & insert_rows, index_container & insert_indices)noexcept
+        -> type_<void,
+            decltype(std::declval<index_container>().begin()),
+            decltype(std::declval<index_container>().end()),
+            decltype(std::declval<index_container>().size()),
+            decltype(static_cast<int>(*(std::declval<index_container>().begin())))>
+    {
+        size_type count = std::distance(insert_indices.begin(),insert_indices.end());
+        count = (count <= insert_rows.size()) ? count:insert_rows.size();
+        if (count <= 0){
+            return;
+        }
+        typedef hopeless::allocator<size_type> s_allocator_type;
+        s_allocator_type s_alloc;
+        size_type * scratch = std::allocator_traits<s_allocator_type>::allocate(s_alloc,3*count);
+        if (!scratch){
+            std::cerr<<"ERROR soa_dynarray failed to allocate memory for buffered_insert"<<std::endl;
+            return;
+        }
+        size_type * positions = scratch + 2*count;
+        auto it = insert_indices.begin();
+        for (size_type k = 0; k < count; ++k, ++it){
+            positions[k] = static_cast<size_type>(*it);
+        }
+        if (buffered_insert_impl(insert_rows,positions,scratch,count)){
+            it = insert_indices.begin();
+            for (size_type k = 0; k < count; ++k, ++it){
+                *it = positions[k];
+            }
+        }
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,scratch,3*count);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<typename indices>
+    inline auto basic_soa_dynarray<OffloadPolicy,Fields...>::buffered_insert(const basic_soa_dynarray & insert_rows, indices insert_indices[], size_type count)noexcept
+        -> type_<void,
+            decltype(static_cast<int>(std::declval<indices>()))>
+    {
+        count = (count <= insert_rows.size()) ? count:insert_rows.size();
+        if (count <= 0){
+            return;
+        }
+        typedef hopeless::allocator<size_type> s_allocator_type;
+        s_allocator_type s_alloc;
+        size_type * scratch = std::allocator_traits<s_allocator_type>::allocate(s_alloc,3*count);
+        if (!scratch){
+            std::cerr<<"ERROR soa_dynarray failed to allocate memory for buffered_insert"<<std::endl;
+            return;
+        }
+        size_type * positions = scratch + 2*count;
+        for (size_type k = 0; k < count; ++k){
+            positions[k] = static_cast<size_type>(insert_indices[k]);
+        }
+        if (buffered_insert_impl(insert_rows,positions,scratch,count)){
+            for (size_type k = 0; k < count; ++k){
+                insert_indices[k] = static_cast<indices>(positions[k]);
+            }
+        }
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,scratch,3*count);
+    }
+
+    // erase_rows[k] is the index of the k-th erase when the rows go one after the other, they are turned into sorted rows
+    // of the array before the erase and every column is compacted in one forward pass, nothing changes if one is out of bounds
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::buffered_erase_impl(size_type * erase_rows, size_type count)noexcept{
+        const size_type old_size = size();
+        const size_type new_size = old_size - count;
+        for (size_type k = 0; k < count; ++k){
+            if ((erase_rows[k] < 0) || (erase_rows[k] >= old_size - k)){
+                std::cerr<<"Error soa_dynarray buffered_erase index "<<erase_rows[k]<<" out of bounds for erase "<<k
+                         <<" of "<<count<<" from size "<<old_size<<", nothing was erased"<<std::endl;
+                return;
+            }
+        }
+        // erase_rows[0,k) holds the rows already erased sorted, each one at or before the next index pushes it back by one
+        for (size_type k = 0; k < count; ++k){
+            size_type row = erase_rows[k];
+            size_type j = 0;
+            while ((j < k) && (erase_rows[j] <= row)){
+                ++row;
+                ++j;
+            }
+            for (size_type m = k; m > j; --m){
+                erase_rows[m] = erase_rows[m-1];
+            }
+            erase_rows[j] = row;
+        }
+        for_each_column([&](auto & column){
+            auto * buf = column.data();
+            size_type dst = erase_rows[0];
+            for (size_type k = 0; k < count; ++k){
+                const size_type next = (k + 1 < count) ? erase_rows[k+1]:old_size;
+                for (size_type src = erase_rows[k] + 1; src < next; ++src){
+                    buf[dst++] = std::move(buf[src]);
+                }
+            }
+            column.resize(new_size);
+        });
+    #ifdef HOPELESS_DYNARRAY_MAP_TO_DEV_POST_CHANGE
+        map_data_to_omp_dev();
+    #endif
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<typename index_container>
+    inline auto basic_soa_dynarray<OffloadPolicy,Fields...>::buffered_erase(const index_container & erase_indices)noexcept
+        -> type_<void,
+            decltype(std::declval<index_container>().begin()),
+            decltype(std::declval<index_container>().end()),
+            decltype(std::declval<index_container>().size()),
+            decltype(static_cast<int>(*(std::declval<index_container>().begin())))>
+    {
+        const size_type count = std::distance(erase_indices.begin(),erase_indices.end());
+        if (count == 0){
+            return;
+        }
+        typedef hopeless::allocator<size_type> s_allocator_type;
+        s_allocator_type s_alloc;
+        size_type * erase_rows = std::allocator_traits<s_allocator_type>::allocate(s_alloc,count);
+        if (!erase_rows){
+            std::cerr<<"ERROR soa_dynarray failed to allocate memory for buffered_erase"<<std::endl;
+            return;
+        }
+        size_type k = 0;
+        for (const auto & index : erase_indices){
+            erase_rows[k++] = static_cast<size_type>(index);
+        }
+        buffered_erase_impl(erase_rows,count);
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,erase_rows,count);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<typename indices>
+    inline auto basic_soa_dynarray<OffloadPolicy,Fields...>::buffered_erase(const indices erase_indices[], size_type count)noexcept
+        -> type_<void,
+            decltype(static_cast<int>(std::declval<indices>()))>
+    {
+        if (count <= 0){
+            return;
+        }
+        typedef hopeless::allocator<size_type> s_allocator_type;
+        s_allocator_type s_alloc;
+        size_type * erase_rows = std::allocator_traits<s_allocator_type>::allocate(s_alloc,count);
+        if (!erase_rows){
+            std::cerr<<"ERROR soa_dynarray failed to allocate memory for buffered_erase"<<std::endl;
+            return;
+        }
+        for (size_type k = 0; k < count; ++k){
+            erase_rows[k] = static_cast<size_type>(erase_indices[k]);
+        }
+        buffered_erase_impl(erase_rows,count);
+        std::allocator_traits<s_allocator_type>::deallocate(s_alloc,erase_rows,count);
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_field_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            std::get<I>(columns_).map_data_to_omp_dev();
+        }
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_field_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            std::get<I>(columns_).map_data_from_omp_dev();
+        }
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_field_to_omp_dev(const size_type begin, const size_type end)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            std::get<I>(columns_).map_data_to_omp_dev(begin,end);
+        }
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_field_from_omp_dev(const size_type begin, const size_type end)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            std::get<I>(columns_).map_data_from_omp_dev(begin,end);
+        }
+    }
+
+#ifdef HOPELESS_TARGET_OMP_DEV
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I, int dev_no>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_field_to_omp_dev(transfer_batch<dev_no> & batch)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            std::get<I>(columns_).map_data_to_omp_dev(batch);
+        }
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    template<std::size_t I, int dev_no>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_field_from_omp_dev(transfer_batch<dev_no> & batch)noexcept{
+        if constexpr (OffloadPolicy::offload){
+            std::get<I>(columns_).map_data_from_omp_dev(batch);
+        }
+    }
+#endif
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_data_to_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            for_each_column([](auto & column){column.map_data_to_omp_dev();});
+        }
+    }
+
+    template<typename OffloadPolicy, typename... Fields>
+    inline void basic_soa_dynarray<OffloadPolicy,Fields...>::map_data_from_omp_dev()noexcept{
+        if constexpr (OffloadPolicy::offload){
+            for_each_column([](auto & column){column.map_data_from_omp_dev();});
+        }
+    }
+}
+#endif
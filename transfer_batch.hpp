@@ -0,0 +1,266 @@
+// collects host<->device copies for many dynarrays/r2darrays and issues them together
+// adjacent or overlapping ranges of the same buffer are merged so each one is one omp_target_memcpy
+// all the copies are issued asynchronously and there is a single wait at the end of submit()
+// copies that touch the same bytes of a buffer in opposite directions keep the order they were added in,
+// they go in separate rounds with a wait between them (one round unless a batch mixes them)
+#pragma once
+
+#ifndef HOPELESS_TRANSFER_BATCH
+#define HOPELESS_TRANSFER_BATCH
+
+#include<iostream>
+#include<cstddef>
+#include<memory>
+#include<algorithm>
+#include<stdexcept>
+#include<omp.h>
+
+#include "allocator.hpp"
+#include "hopeless_macros_n_meta.hpp"
+
+namespace hopeless
+{
+#ifdef HOPELESS_TARGET_OMP_DEV
+    enum class transfer_direction : int {to_dev = 0, from_dev = 1};
+
+    template<int dev_no = HOPELESS_DEFAULT_OMP_OFFLOAD_DEV>
+    struct transfer_batch
+    {
+    public:
+        typedef std::ptrdiff_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        // one copy between a host buffer and its device mirror, offsets are the same on both sides
+        struct transfer_request{
+            char * host_ptr;
+            char * dev_ptr;
+            size_type offset_bytes;
+            size_type num_bytes;
+            transfer_direction direction;
+            size_type order;        // position in the order add() was called
+            size_type round;        // copies of a round run concurrently, rounds run one after another
+        };
+        typedef hopeless::allocator<transfer_request> allocator_type;
+
+        transfer_batch()noexcept;
+        explicit transfer_batch(size_type expected_requests)noexcept;
+        transfer_batch(const transfer_batch & other) = delete;
+        transfer_batch& operator =(const transfer_batch & other) = delete;
+        ~transfer_batch()noexcept;
+
+        // queue a copy of num_bytes starting offset_bytes into both buffers, nothing is copied until submit()
+        inline void add(void * host_ptr, void * dev_ptr, const size_type num_bytes,
+            const size_type offset_bytes, const transfer_direction direction)noexcept;
+
+        // merge adjacent ranges, issue every copy asynchronously and wait once for all of them (once per round)
+        inline void submit()noexcept;
+        inline void clear()noexcept;
+
+        constexpr inline size_type size()const noexcept;
+        constexpr inline bool empty()const noexcept;
+
+    private:
+        inline void grow(size_type new_cap)noexcept;
+        inline void assign_rounds()noexcept;
+        inline void coalesce()noexcept;
+        static inline void issue(const transfer_request & request)noexcept;
+        inline void issue_round(const size_type begin, const size_type end)noexcept;
+
+        transfer_request * requests_;
+        size_type size_;
+        size_type capacity_;
+    };
+
+    template<int dev_no>
+    transfer_batch<dev_no>::transfer_batch()noexcept
+        :requests_(nullptr),
+        size_(0),
+        capacity_(0){}
+
+    template<int dev_no>
+    transfer_batch<dev_no>::transfer_batch(size_type expected_requests)noexcept
+        :requests_(nullptr),
+        size_(0),
+        capacity_(0)
+    {
+        grow(expected_requests);
+    }
+
+    template<int dev_no>
+    transfer_batch<dev_no>::~transfer_batch()noexcept{
+        allocator_type alloc;
+        std::allocator_traits<allocator_type>::deallocate(alloc,requests_,capacity_);
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::grow(size_type new_cap)noexcept{
+        if (new_cap <= capacity_){
+            return;
+        }
+        allocator_type alloc;
+        transfer_request * temp = std::allocator_traits<allocator_type>::allocate(alloc,new_cap);
+        if (temp){
+            for (size_type i = 0; i < size_; ++i){
+                temp[i] = requests_[i];
+            }
+            std::allocator_traits<allocator_type>::deallocate(alloc,requests_,capacity_);
+            requests_ = temp;
+            capacity_ = new_cap;
+        }else{
+            std::cerr<<"ERROR transfer_batch failed to allocate memory"<<std::endl;
+        }
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::add(void * host_ptr, void * dev_ptr, const size_type num_bytes,
+        const size_type offset_bytes, const transfer_direction direction)noexcept{
+        if (num_bytes <= 0){
+            return;
+        }
+        if (size_ == capacity_){
+            grow((capacity_ < 16) ? 16:capacity_*2);
+            if (size_ == capacity_){
+                return;
+            }
+        }
+        requests_[size_] = transfer_request{static_cast<char*>(host_ptr),static_cast<char*>(dev_ptr),
+                                            offset_bytes,num_bytes,direction,size_,0};
+        ++size_;
+    }
+
+    // a copy goes one round after every earlier copy of the other direction that overlaps it on the same buffer,
+    // e.g. a from_dev then a to_dev of the same range, everything else stays in round 0
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::assign_rounds()noexcept{
+        std::sort(requests_,requests_+size_,[](const transfer_request & a, const transfer_request & b){
+            if (a.host_ptr != b.host_ptr){return std::less<char*>()(a.host_ptr,b.host_ptr);}
+            return a.order < b.order;
+        });
+        size_type group = 0;
+        for (size_type i = 0; i < size_; ++i){
+            transfer_request & cur = requests_[i];
+            if (cur.host_ptr != requests_[group].host_ptr){
+                group = i;
+            }
+            cur.round = 0;
+            for (size_type j = group; j < i; ++j){
+                const transfer_request & prev = requests_[j];
+                const bool overlap = (prev.offset_bytes < cur.offset_bytes + cur.num_bytes) &&
+                                     (cur.offset_bytes < prev.offset_bytes + prev.num_bytes);
+                if (overlap && (prev.direction != cur.direction) && (prev.round >= cur.round)){
+                    cur.round = prev.round + 1;
+                }
+            }
+        }
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::coalesce()noexcept{
+        if (size_ < 2){
+            return;
+        }
+        assign_rounds();
+        // group by round, direction and buffer pair then by offset so mergeable ranges end up next to each other
+        std::sort(requests_,requests_+size_,[](const transfer_request & a, const transfer_request & b){
+            if (a.round != b.round){return a.round < b.round;}
+            if (a.direction != b.direction){return a.direction < b.direction;}
+            if (a.host_ptr != b.host_ptr){return std::less<char*>()(a.host_ptr,b.host_ptr);}
+            if (a.dev_ptr != b.dev_ptr){return std::less<char*>()(a.dev_ptr,b.dev_ptr);}
+            return a.offset_bytes < b.offset_bytes;
+        });
+        size_type last = 0;
+        for (size_type i = 1; i < size_; ++i){
+            transfer_request & prev = requests_[last];
+            const transfer_request & cur = requests_[i];
+            const size_type prev_end = prev.offset_bytes + prev.num_bytes;
+            const bool same_buffer = (prev.round == cur.round) && (prev.direction == cur.direction) &&
+                (prev.host_ptr == cur.host_ptr) && (prev.dev_ptr == cur.dev_ptr);
+            if (same_buffer && (cur.offset_bytes <= prev_end)){
+                const size_type cur_end = cur.offset_bytes + cur.num_bytes;
+                prev.num_bytes = ((cur_end > prev_end) ? cur_end:prev_end) - prev.offset_bytes;
+            }else{
+                ++last;
+                requests_[last] = cur;
+            }
+        }
+        size_ = last + 1;
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::issue(const transfer_request & request)noexcept{
+        const bool to_dev = (request.direction == transfer_direction::to_dev);
+        char * dst = to_dev ? request.dev_ptr:request.host_ptr;
+        char * src = to_dev ? request.host_ptr:request.dev_ptr;
+        const int dst_dev = to_dev ? dev_no:omp_get_initial_device();
+        const int src_dev = to_dev ? omp_get_initial_device():dev_no;
+        try{
+        #ifdef HOPELESS_OMP_TARGET_MEMCPY_ASYNC
+            bool fail = omp_target_memcpy_async(dst,src,request.num_bytes,request.offset_bytes,request.offset_bytes,
+                                                dst_dev,src_dev,0,nullptr);
+        #else
+            bool fail = omp_target_memcpy(dst,src,request.num_bytes,request.offset_bytes,request.offset_bytes,
+                                          dst_dev,src_dev);
+        #endif
+            if(fail){
+                throw std::runtime_error("ERROR transfer_batch failed to copy data between host and device memory");
+            }
+        }catch(std::runtime_error& e){
+           std::cerr<<e.what()<<std::endl;
+        }catch(...){
+            std::cerr<<"Unexpected error, possible memory corruption?"<<std::endl;
+        }
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::issue_round(const size_type begin, const size_type end)noexcept{
+    #ifdef HOPELESS_OMP_TARGET_MEMCPY_ASYNC
+        for (size_type i = begin; i < end; ++i){
+            issue(requests_[i]);
+        }
+        #pragma omp taskwait
+    #else
+        // every copy is its own task so the runtime can have them in flight at the same time,
+        // the barrier at the end of the parallel region is the only wait
+        const transfer_request * requests = requests_;
+        #pragma omp parallel if(end - begin > 1)
+        #pragma omp single nowait
+        for (size_type i = begin; i < end; ++i){
+            #pragma omp task firstprivate(i)
+            issue(requests[i]);
+        }
+    #endif
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::submit()noexcept{
+        coalesce();
+        // coalesce() leaves the requests sorted by round
+        size_type begin = 0;
+        while (begin < size_){
+            size_type end = begin + 1;
+            while ((end < size_) && (requests_[end].round == requests_[begin].round)){
+                ++end;
+            }
+            issue_round(begin,end);
+            begin = end;
+        }
+        size_ = 0;
+    }
+
+    template<int dev_no>
+    inline void transfer_batch<dev_no>::clear()noexcept{
+        size_ = 0;
+    }
+
+    template<int dev_no>
+    constexpr inline typename transfer_batch<dev_no>::size_type transfer_batch<dev_no>::size()const noexcept{
+        return size_;
+    }
+
+    template<int dev_no>
+    constexpr inline bool transfer_batch<dev_no>::empty()const noexcept{
+        return (size_ == 0);
+    }
+#endif
+}
+#endif